@@ -0,0 +1,408 @@
+#include "Checkpoint.h"
+#include "Log.h"
+#include <cstdio>
+#include <cstring>
+#include <csignal>
+#include <atomic>
+#include <sstream>
+#include <filesystem>
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+static const char MAGIC[8] = { 'J', 'S', 'S', 'P', 'C', 'K', 'P', 'T' };
+static const int WERSJA = 1;
+
+// FNV-1a
+static uint64_t fnv1a(const char* dane, std::size_t n, uint64_t h = 0xCBF29CE484222325ULL)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        h ^= static_cast<unsigned char>(dane[i]);
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+uint64_t sumaKontrolnaInstancji(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn)
+{
+    BuforZapisu b;
+    b.piszInt(liczbaJobow);
+    b.piszInt(liczbaMaszyn);
+    for (int i = 0; i < (int)operacje.size(); ++i)
+    {
+        b.piszInt(operacje[i].job_id);
+        b.piszInt(operacje[i].operation_id);
+        b.piszInt(operacje[i].machine_id);
+        b.piszInt(operacje[i].processing_time);
+    }
+    return fnv1a(b.getDane().data(), b.getDane().size());
+}
+
+// ===== BuforZapisu =====
+
+void BuforZapisu::piszU64(uint64_t v)
+{
+    for (int i = 0; i < 8; ++i)
+        dane.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+void BuforZapisu::piszInt(int64_t v)
+{
+    piszU64(static_cast<uint64_t>(v));
+}
+
+void BuforZapisu::piszDouble(double v)
+{
+    uint64_t bity;
+    std::memcpy(&bity, &v, sizeof(bity));
+    piszU64(bity);
+}
+
+void BuforZapisu::piszTekst(const std::string& s)
+{
+    piszU64(s.size());
+    dane.insert(dane.end(), s.begin(), s.end());
+}
+
+void BuforZapisu::piszWektor(const std::vector<int>& v)
+{
+    piszU64(v.size());
+    for (int x : v)
+    {
+        uint32_t u = static_cast<uint32_t>(x);
+        for (int i = 0; i < 4; ++i)
+            dane.push_back(static_cast<char>((u >> (8 * i)) & 0xFF));
+    }
+}
+
+void BuforZapisu::piszWektor(const std::vector<double>& v)
+{
+    piszU64(v.size());
+    for (double x : v)
+        piszDouble(x);
+}
+
+void BuforZapisu::piszGenerator(const std::mt19937& gen)
+{
+    std::ostringstream ss;
+    ss << gen;
+    piszTekst(ss.str());
+}
+
+void BuforZapisu::piszNaglowek(const char* rodzaj, uint64_t sumaInstancji, TrybDekodera tryb, Kodowanie kodowanie)
+{
+    dane.insert(dane.end(), MAGIC, MAGIC + 8);
+    piszInt(WERSJA);
+    piszTekst(rodzaj);
+    piszU64(sumaInstancji);
+    piszInt(static_cast<int>(tryb));
+    piszInt(static_cast<int>(kodowanie));
+}
+
+void BuforZapisu::zakoncz()
+{
+    piszU64(fnv1a(dane.data(), dane.size()));
+}
+
+// ===== BuforOdczytu =====
+
+BuforOdczytu::BuforOdczytu(const std::vector<char>& dane)
+    : dane(dane), pozycja(0), koniec(0), blad(false)
+{
+    if (dane.size() < 8)
+    {
+        blad = true;
+        return;
+    }
+    koniec = dane.size() - 8;
+}
+
+bool BuforOdczytu::dostepne(std::size_t ile)
+{
+    if (blad || koniec - pozycja < ile)
+    {
+        blad = true;
+        return false;
+    }
+    return true;
+}
+
+uint64_t BuforOdczytu::czytajU64()
+{
+    if (!dostepne(8))
+        return 0;
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i)
+        v |= uint64_t(static_cast<unsigned char>(dane[pozycja + i])) << (8 * i);
+    pozycja += 8;
+    return v;
+}
+
+int64_t BuforOdczytu::czytajInt()
+{
+    return static_cast<int64_t>(czytajU64());
+}
+
+double BuforOdczytu::czytajDouble()
+{
+    uint64_t bity = czytajU64();
+    double v;
+    std::memcpy(&v, &bity, sizeof(v));
+    return v;
+}
+
+std::string BuforOdczytu::czytajTekst()
+{
+    uint64_t n = czytajU64();
+    if (!dostepne(n))
+        return std::string();
+    std::string s(dane.begin() + pozycja, dane.begin() + pozycja + n);
+    pozycja += n;
+    return s;
+}
+
+void BuforOdczytu::czytajWektor(std::vector<int>& v)
+{
+    uint64_t n = czytajU64();
+    v.clear();
+    if (n > (koniec - pozycja) / 4 || !dostepne(4 * n))
+    {
+        blad = true;
+        return;
+    }
+    v.resize(n);
+    for (uint64_t k = 0; k < n; ++k)
+    {
+        uint32_t u = 0;
+        for (int i = 0; i < 4; ++i)
+            u |= uint32_t(static_cast<unsigned char>(dane[pozycja + i])) << (8 * i);
+        v[k] = static_cast<int>(u);
+        pozycja += 4;
+    }
+}
+
+void BuforOdczytu::czytajWektor(std::vector<double>& v)
+{
+    uint64_t n = czytajU64();
+    v.clear();
+    if (n > (koniec - pozycja) / 8)
+    {
+        blad = true;
+        return;
+    }
+    v.resize(n);
+    for (uint64_t k = 0; k < n; ++k)
+        v[k] = czytajDouble();
+}
+
+void BuforOdczytu::czytajGenerator(std::mt19937& gen)
+{
+    std::istringstream ss(czytajTekst());
+    if (blad || !(ss >> gen))
+        blad = true;
+}
+
+bool BuforOdczytu::czytajNaglowek(const char* rodzaj, uint64_t sumaInstancji, TrybDekodera tryb, Kodowanie kodowanie)
+{
+    uint64_t zapisanaSuma = 0;
+    for (int i = 0; !blad && i < 8; ++i)
+        zapisanaSuma |= uint64_t(static_cast<unsigned char>(dane[koniec + i])) << (8 * i);
+
+    if (blad || fnv1a(dane.data(), koniec) != zapisanaSuma)
+    {
+        LOG_OSTRZEZENIE(Checkpoint, "Checkpoint uszkodzony (zla suma kontrolna)");
+        blad = true;
+        return false;
+    }
+    if (!dostepne(8) || std::memcmp(dane.data(), MAGIC, 8) != 0)
+    {
+        LOG_OSTRZEZENIE(Checkpoint, "To nie jest plik checkpointu");
+        blad = true;
+        return false;
+    }
+    pozycja = 8;
+
+    if (czytajInt() != WERSJA)
+    {
+        LOG_OSTRZEZENIE(Checkpoint, "Nieobslugiwana wersja checkpointu");
+        blad = true;
+        return false;
+    }
+    if (czytajTekst() != rodzaj)
+    {
+        LOG_OSTRZEZENIE(Checkpoint, "Checkpoint pochodzi z innego solvera (oczekiwano " << rodzaj << ")");
+        blad = true;
+        return false;
+    }
+    if (czytajU64() != sumaInstancji)
+    {
+        LOG_OSTRZEZENIE(Checkpoint, "Checkpoint pochodzi z innej instancji");
+        blad = true;
+        return false;
+    }
+    if (czytajInt() != static_cast<int>(tryb) || czytajInt() != static_cast<int>(kodowanie))
+    {
+        LOG_OSTRZEZENIE(Checkpoint, "Checkpoint ma inny tryb dekodera albo kodowanie");
+        blad = true;
+        return false;
+    }
+    return ok();
+}
+
+// ===== Pliki =====
+
+bool zapiszPlikAtomowo(const std::string& sciezka, const std::vector<char>& dane)
+{
+    std::string tymczasowy = sciezka + ".tmp";
+    std::FILE* f = std::fopen(tymczasowy.c_str(), "wb");
+    if (f == nullptr)
+    {
+        LOG_BLAD(Checkpoint, "Nie mozna otworzyc pliku do zapisu: " << tymczasowy);
+        return false;
+    }
+
+    bool ok = std::fwrite(dane.data(), 1, dane.size(), f) == dane.size() && std::fflush(f) == 0;
+#if defined(__unix__) || defined(__APPLE__)
+    // Bez fsync rename mógłby trafić na dysk przed danymi
+    ok = ok && fsync(fileno(f)) == 0;
+#endif
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok)
+    {
+        LOG_BLAD(Checkpoint, "Blad zapisu checkpointu: " << tymczasowy);
+        std::remove(tymczasowy.c_str());
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tymczasowy, sciezka, ec); // zastępuje istniejący plik także na Windows
+    if (ec)
+    {
+        LOG_BLAD(Checkpoint, "Nie mozna podmienic checkpointu " << sciezka << ": " << ec.message());
+        return false;
+    }
+    return true;
+}
+
+bool wczytajPlikBinarny(const std::string& sciezka, std::vector<char>& dane)
+{
+    std::FILE* f = std::fopen(sciezka.c_str(), "rb");
+    if (f == nullptr)
+        return false;
+
+    dane.clear();
+    char blok[1 << 16];
+    std::size_t n;
+    while ((n = std::fread(blok, 1, sizeof(blok), f)) > 0)
+        dane.insert(dane.end(), blok, blok + n);
+
+    bool ok = !std::ferror(f);
+    std::fclose(f);
+    return ok;
+}
+
+// ===== CheckpointWriter =====
+
+CheckpointWriter::CheckpointWriter(const std::string& sciezka)
+    : sciezka(sciezka), saOczekujace(false), koniec(false), usunPlik(false), watek(&CheckpointWriter::petla, this)
+{}
+
+CheckpointWriter::~CheckpointWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        koniec = true;
+    }
+    warunek.notify_one();
+    watek.join();
+
+    if (usunPlik)
+        std::remove(sciezka.c_str());
+}
+
+void CheckpointWriter::zlec(std::vector<char>& dane)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        oczekujace.swap(dane);
+        saOczekujace = true;
+    }
+    warunek.notify_one();
+}
+
+void CheckpointWriter::porzuc()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    oczekujace.clear();
+    saOczekujace = false;
+    usunPlik = true;
+}
+
+void CheckpointWriter::petla()
+{
+    std::vector<char> doZapisu;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        warunek.wait(lock, [this] { return saOczekujace || koniec; });
+        if (!saOczekujace)
+            return; // koniec i nic do zapisania
+
+        doZapisu.swap(oczekujace);
+        saOczekujace = false;
+
+        lock.unlock();
+        zapiszPlikAtomowo(sciezka, doZapisu);
+        lock.lock();
+    }
+}
+
+// ===== Sygnały =====
+
+// Atomowe bez blokad – bezpieczne w obsłudze sygnału i przy zleceniu z innego wątku
+static std::atomic<int> zadanieCheckpointu(0);
+static std::atomic<int> zadanieZatrzymania(0);
+
+extern "C" void obsluzSygnal(int sygnal)
+{
+#ifdef SIGUSR1
+    if (sygnal == SIGUSR1)
+    {
+        zadanieCheckpointu = 1;
+        return;
+    }
+#endif
+    zadanieCheckpointu = 1;
+    zadanieZatrzymania = 1;
+    std::signal(sygnal, SIG_DFL); // kolejny sygnał kończy program od razu
+}
+
+void zainstalujObslugeSygnalow()
+{
+    std::signal(SIGINT, obsluzSygnal);
+    std::signal(SIGTERM, obsluzSygnal);
+#ifdef SIGUSR1
+    std::signal(SIGUSR1, obsluzSygnal);
+#endif
+}
+
+bool czyZadanoCheckpointu()
+{
+    return zadanieCheckpointu != 0;
+}
+
+bool czyZadanoZatrzymania()
+{
+    return zadanieZatrzymania != 0;
+}
+
+void potwierdzCheckpoint()
+{
+    zadanieCheckpointu = 0;
+}
+
+void zadajZatrzymania(bool zatrzymaj)
+{
+    zadanieZatrzymania = zatrzymaj ? 1 : 0;
+}
@@ -0,0 +1,109 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "OperationSchedule.h"
+#include "ScheduleDecoder.h"
+#include <vector>
+#include <string>
+#include <random>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Checkpointy długich przebiegów.
+// Plik: "JSSPCKPT", wersja, rodzaj solvera, suma kontrolna instancji, tryb dekodera, kodowanie,
+// stan solvera (liczby little-endian, generator jako tekst z operator<<) i na końcu
+// suma kontrolna całości – uszkodzony albo obcięty plik jest odrzucany.
+
+// Suma kontrolna instancji (wymiary + operacje) – checkpoint pasuje tylko do tej samej instancji
+uint64_t sumaKontrolnaInstancji(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn);
+
+class BuforZapisu
+{
+public:
+    void piszInt(int64_t v);
+    void piszU64(uint64_t v);
+    void piszDouble(double v);
+    void piszTekst(const std::string& s);
+    void piszWektor(const std::vector<int>& v);
+    void piszWektor(const std::vector<double>& v);
+    void piszGenerator(const std::mt19937& gen);
+
+    // Nagłówek z metadanymi i (na końcu) suma kontrolna zawartości
+    void piszNaglowek(const char* rodzaj, uint64_t sumaInstancji, TrybDekodera tryb, Kodowanie kodowanie);
+    void zakoncz();
+
+    std::vector<char>& getDane() { return dane; }
+
+private:
+    std::vector<char> dane;
+};
+
+class BuforOdczytu
+{
+public:
+    explicit BuforOdczytu(const std::vector<char>& dane);
+
+    int64_t czytajInt();
+    uint64_t czytajU64();
+    double czytajDouble();
+    std::string czytajTekst();
+    void czytajWektor(std::vector<int>& v);
+    void czytajWektor(std::vector<double>& v);
+    void czytajGenerator(std::mt19937& gen);
+
+    // Sprawdza sumę kontrolną pliku i zgodność nagłówka z bieżącym solverem i instancją
+    bool czytajNaglowek(const char* rodzaj, uint64_t sumaInstancji, TrybDekodera tryb, Kodowanie kodowanie);
+
+    bool ok() const { return !blad; }
+
+private:
+    bool dostepne(std::size_t ile);
+
+    const std::vector<char>& dane;
+    std::size_t pozycja;
+    std::size_t koniec; // bez końcowej sumy kontrolnej
+    bool blad;
+};
+
+// Zapis przez plik tymczasowy i rename – przerwany zapis nie niszczy poprzedniego checkpointu
+bool zapiszPlikAtomowo(const std::string& sciezka, const std::vector<char>& dane);
+bool wczytajPlikBinarny(const std::string& sciezka, std::vector<char>& dane);
+
+// Zapisuje checkpointy w osobnym wątku, żeby wątek przeszukiwania nie czekał na dysk.
+// Gdy zapis nie nadąża, starszy oczekujący stan jest zastępowany nowszym.
+class CheckpointWriter
+{
+public:
+    explicit CheckpointWriter(const std::string& sciezka);
+    ~CheckpointWriter(); // zapisuje oczekujący stan i kończy wątek
+
+    void zlec(std::vector<char>& dane); // przejmuje zawartość wektora
+    // Przebieg zakończony normalnie: oczekujący stan jest odrzucany, a plik usuwany po ostatnim zapisie,
+    // żeby kolejne uruchomienie nie wznowiło gotowego wyniku
+    void porzuc();
+
+private:
+    void petla();
+
+    std::string sciezka;
+    std::mutex mutex;
+    std::condition_variable warunek;
+    std::vector<char> oczekujace;
+    bool saOczekujace;
+    bool koniec;
+    bool usunPlik;
+    std::thread watek;
+};
+
+// SIGINT/SIGTERM: checkpoint i zatrzymanie solvera; SIGUSR1 (POSIX): sam checkpoint.
+// Drugi SIGINT/SIGTERM kończy program od razu.
+void zainstalujObslugeSygnalow();
+bool czyZadanoCheckpointu();
+bool czyZadanoZatrzymania();
+void potwierdzCheckpoint();
+// Zatrzymanie zlecone z programu (np. anulowanie w SolverServer); false kasuje żądanie przed kolejnym przebiegiem
+void zadajZatrzymania(bool zatrzymaj);
+
+#endif
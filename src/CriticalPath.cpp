@@ -0,0 +1,168 @@
+#include "CriticalPath.h"
+#include <algorithm>
+
+SciezkaKrytyczna::SciezkaKrytyczna(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn, Kodowanie kodowanie)
+    : operacje(operacje), kodowanie(kodowanie)
+{
+    const int N = operacje.size();
+    indeks.assign(liczbaJobow, std::vector<int>());
+    for (int i = 0; i < N; ++i)
+    {
+        const OperationSchedule& op = operacje[i];
+        if (op.operation_id >= (int)indeks[op.job_id].size())
+            indeks[op.job_id].resize(op.operation_id + 1, -1);
+        indeks[op.job_id][op.operation_id] = i;
+    }
+    poprzednikJoba.assign(N, -1);
+    nastepnikJoba.assign(N, -1);
+    for (int i = 0; i < N; ++i)
+        if (operacje[i].operation_id > 0)
+        {
+            poprzednikJoba[i] = indeks[operacje[i].job_id][operacje[i].operation_id - 1];
+            nastepnikJoba[poprzednikJoba[i]] = i;
+        }
+
+    kolejnosc.resize(N);
+    pozycja.resize(N);
+    wystapienia.resize(liczbaJobow);
+    start.resize(N);
+    koniec.resize(N);
+    poprzednikMaszyny.resize(N);
+    nastepnikMaszyny.resize(N);
+    maszynaOstatnia.resize(liczbaMaszyn);
+    ranga.resize(N);
+    stopien.resize(N);
+}
+
+void SciezkaKrytyczna::wczytaj(const std::vector<OperationSchedule>& harmonogram)
+{
+    const int N = operacje.size();
+    for (int k = 0; k < N; ++k)
+    {
+        const OperationSchedule& op = harmonogram[k];
+        int i = indeks[op.job_id][op.operation_id];
+        kolejnosc[k] = i;
+        start[i] = op.start_time;
+        koniec[i] = op.end_time;
+    }
+    // Przy wstawianiu w luki kolejność planowania nie jest kolejnością na maszynie
+    std::stable_sort(kolejnosc.begin(), kolejnosc.end(), [&](int a, int b) { return start[a] < start[b]; });
+
+    std::fill(maszynaOstatnia.begin(), maszynaOstatnia.end(), -1);
+    for (int k = 0; k < N; ++k)
+    {
+        int i = kolejnosc[k];
+        int m = operacje[i].machine_id;
+        ranga[i] = k;
+        poprzednikMaszyny[i] = maszynaOstatnia[m];
+        nastepnikMaszyny[i] = -1;
+        if (maszynaOstatnia[m] >= 0)
+            nastepnikMaszyny[maszynaOstatnia[m]] = i;
+        maszynaOstatnia[m] = i;
+    }
+
+    sciezka.clear();
+    ruchy.clear();
+    bloki.clear();
+    operacjeBlokow.clear();
+    int x = -1;
+    for (int i = 0; i < N; ++i)
+        if (x < 0 || koniec[i] > koniec[x])
+            x = i;
+
+    // Wstecz od ostatniej operacji; przy remisie maszyna ma pierwszeństwo, bo daje ruchy.
+    // Bloki powstają od końca, więc na koniec każdy jest odwracany do kolejności na maszynie.
+    int poczatekBloku = 0;
+    while (x >= 0)
+    {
+        sciezka.push_back(x);
+        int pm = poprzednikMaszyny[x];
+        int pj = poprzednikJoba[x];
+        bool krawedzMaszyny = pm >= 0 && koniec[pm] == start[x];
+        bool wBloku = krawedzMaszyny && operacje[pm].job_id != operacje[x].job_id;
+        if (wBloku)
+        {
+            ruchy.push_back(std::make_pair(pm, x));
+            if ((int)operacjeBlokow.size() == poczatekBloku)
+                operacjeBlokow.push_back(x);
+            operacjeBlokow.push_back(pm);
+        }
+        else if ((int)operacjeBlokow.size() > poczatekBloku)
+        {
+            std::reverse(operacjeBlokow.begin() + poczatekBloku, operacjeBlokow.end());
+            bloki.push_back(std::make_pair(poczatekBloku, (int)operacjeBlokow.size()));
+            poczatekBloku = operacjeBlokow.size();
+        }
+
+        if (krawedzMaszyny)
+            x = pm;
+        else if (pj >= 0 && koniec[pj] == start[x])
+            x = pj;
+        else
+            x = -1;
+    }
+    std::reverse(sciezka.begin(), sciezka.end());
+}
+
+void SciezkaKrytyczna::pozycjeGenow(const std::vector<int>& genotyp)
+{
+    if (kodowanie == Kodowanie::Priorytety)
+    {
+        for (int i = 0; i < (int)operacje.size(); ++i)
+            pozycja[i] = i; // gen operacji i to genotyp[i]
+        return;
+    }
+    std::fill(wystapienia.begin(), wystapienia.end(), 0);
+    for (int ii = 0; ii < (int)genotyp.size(); ++ii)
+    {
+        int j = genotyp[ii];
+        pozycja[indeks[j][wystapienia[j]++]] = ii;
+    }
+}
+
+bool SciezkaKrytyczna::kolejnoscPoZmianie(int blok, const std::vector<int>& nowyBlok, std::vector<int>& wynik)
+{
+    const int N = operacje.size();
+    const int* stary = operacjeBlokow.data() + bloki[blok].first;
+    const int rozmiar = bloki[blok].second - bloki[blok].first;
+    const int przed = poprzednikMaszyny[stary[0]];
+    const int po = nastepnikMaszyny[stary[rozmiar - 1]];
+
+    // Krawędzie maszyny bloku przepięte na czas sortowania, potem przywracane
+    auto przepnij = [&](const int* b) {
+        for (int k = 0; k < rozmiar; ++k)
+        {
+            poprzednikMaszyny[b[k]] = (k > 0) ? b[k - 1] : przed;
+            nastepnikMaszyny[b[k]] = (k < rozmiar - 1) ? b[k + 1] : po;
+        }
+        if (przed >= 0)
+            nastepnikMaszyny[przed] = b[0];
+        if (po >= 0)
+            poprzednikMaszyny[po] = b[rozmiar - 1];
+    };
+    przepnij(nowyBlok.data());
+
+    // Kahn w kolejności startów starego harmonogramu: operacja gotowa przy przejściu jest dopisywana,
+    // a zwolniona dopiero po minięciu jej miejsca – od razu (stos), więc całość jest liniowa
+    for (int i = 0; i < N; ++i)
+        stopien[i] = (poprzednikJoba[i] >= 0) + (poprzednikMaszyny[i] >= 0);
+    wynik.clear();
+    for (int k = 0; k < N; ++k)
+    {
+        if (stopien[kolejnosc[k]] != 0)
+            continue;
+        stos.push_back(kolejnosc[k]);
+        while (!stos.empty())
+        {
+            int i = stos.back();
+            stos.pop_back();
+            wynik.push_back(i);
+            for (int s : { nastepnikJoba[i], nastepnikMaszyny[i] })
+                if (s >= 0 && --stopien[s] == 0 && ranga[s] < k)
+                    stos.push_back(s);
+        }
+    }
+
+    przepnij(stary);
+    return (int)wynik.size() == N;
+}
@@ -0,0 +1,56 @@
+#ifndef CRITICAL_PATH_H
+#define CRITICAL_PATH_H
+
+#include "OperationSchedule.h"
+#include "Encoding.h"
+#include <vector>
+#include <utility>
+
+// Ścieżka krytyczna i bloki krytyczne zdekodowanego harmonogramu oraz pozycje genów operacji –
+// wspólne dla LocalSearch, sąsiedztwa krytycznego SA i wykresów Gantta. Obiekt to bufory robocze
+// jednego wątku.
+class SciezkaKrytyczna
+{
+public:
+    SciezkaKrytyczna(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn, Kodowanie kodowanie);
+
+    // Wyznacza ścieżkę z harmonogramu zwróconego przez dekoder (O(N log N))
+    void wczytaj(const std::vector<OperationSchedule>& harmonogram);
+    // Pozycje genów operacji (dla kodowania z powtórzeniami: k-te wystąpienie joba)
+    void pozycjeGenow(const std::vector<int>& genotyp);
+
+    // Operacje ścieżki krytycznej od pierwszej do ostatniej. Ścieżka idzie wstecz od operacji
+    // kończącej makespan przez poprzednika na maszynie albo w jobie, który kończy się dokładnie
+    // w chwili startu; brak takiego poprzednika (np. przestój przy przeplanowaniu) ją kończy.
+    const std::vector<int>& getSciezka() const { return sciezka; }
+    // Pary (u, v) sąsiednie na maszynie i na ścieżce krytycznej, od końca ścieżki
+    const std::vector<std::pair<int, int>>& getRuchy() const { return ruchy; }
+    // Bloki krytyczne (co najmniej 2 operacje) jako zakresy [od, do) w getOperacjeBlokow(),
+    // operacje bloku w kolejności na maszynie
+    const std::vector<std::pair<int, int>>& getBloki() const { return bloki; }
+    const std::vector<int>& getOperacjeBlokow() const { return operacjeBlokow; }
+    int getPozycja(int operacja) const { return pozycja[operacja]; }
+
+    // Kolejność topologiczna operacji po ustawieniu operacji bloku `blok` na maszynie w kolejności
+    // `nowyBlok`; reszta kolejności możliwie jak w harmonogramie. false = nowa kolejność tworzy cykl.
+    bool kolejnoscPoZmianie(int blok, const std::vector<int>& nowyBlok, std::vector<int>& wynik);
+
+private:
+    const std::vector<OperationSchedule>& operacje;
+    Kodowanie kodowanie;
+
+    std::vector<int> poprzednikJoba;          // operacja -> poprzednia operacja joba albo -1
+    std::vector<int> nastepnikJoba;           // operacja -> następna operacja joba albo -1
+    std::vector<std::vector<int>> indeks;     // [job][operacja] -> indeks operacji
+
+    // Bufory robocze
+    std::vector<int> kolejnosc, pozycja, wystapienia;
+    std::vector<int> start, koniec, poprzednikMaszyny, nastepnikMaszyny, maszynaOstatnia;
+    std::vector<int> ranga, stopien, stos;    // kolejnoscPoZmianie: ranga = miejsce w kolejnosc
+    std::vector<int> sciezka;
+    std::vector<std::pair<int, int>> ruchy;
+    std::vector<std::pair<int, int>> bloki;
+    std::vector<int> operacjeBlokow;
+};
+
+#endif
@@ -0,0 +1,212 @@
+#include "DispatchingRules.h"
+#include "SolutionArchive.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+const char* nazwaReguly(RegulaPriorytetowa regula)
+{
+    switch (regula)
+    {
+    case RegulaPriorytetowa::SPT: return "SPT";
+    case RegulaPriorytetowa::LPT: return "LPT";
+    case RegulaPriorytetowa::MWKR: return "MWKR";
+    case RegulaPriorytetowa::MOPNR: return "MOPNR";
+    case RegulaPriorytetowa::FIFO: return "FIFO";
+    case RegulaPriorytetowa::Losowa: return "Losowa";
+    }
+    return "?";
+}
+
+static const RegulaPriorytetowa regulyDeterministyczne[] = {
+    RegulaPriorytetowa::SPT, RegulaPriorytetowa::LPT, RegulaPriorytetowa::MWKR,
+    RegulaPriorytetowa::MOPNR, RegulaPriorytetowa::FIFO
+};
+
+DispatchingRules::DispatchingRules(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn)
+    : operacje(operacje), liczbaJobow(liczbaJobow), liczbaMaszyn(liczbaMaszyn)
+{
+    const int N = operacje.size();
+    std::vector<std::vector<int>> operacjeJoba(liczbaJobow);
+    for (int i = 0; i < N; ++i)
+        operacjeJoba[operacje[i].job_id].push_back(i);
+
+    poczatekJoba.assign(liczbaJobow + 1, 0);
+    for (int j = 0; j < liczbaJobow; ++j)
+    {
+        std::vector<int>& ops = operacjeJoba[j];
+        std::sort(ops.begin(), ops.end(), [&](int a, int b) { return operacje[a].operation_id < operacje[b].operation_id; });
+        poczatekJoba[j + 1] = poczatekJoba[j] + (int)ops.size();
+
+        int praca = 0;
+        for (int i : ops)
+            praca += operacje[i].processing_time;
+        for (int k = 0; k < (int)ops.size(); ++k)
+        {
+            const OperationSchedule& op = operacje[ops[k]];
+            indeksOperacji.push_back(ops[k]);
+            czas.push_back(op.processing_time);
+            maszyna.push_back(op.machine_id);
+            pozostalaPraca.push_back(praca);
+            pozostaleOperacje.push_back((int)ops.size() - k);
+            praca -= op.processing_time;
+        }
+    }
+
+    nastepna.resize(liczbaJobow);
+    gotowyJob.resize(liczbaJobow);
+    wolnaMaszyna.resize(liczbaMaszyn);
+    konflikt.reserve(liczbaJobow);
+}
+
+int DispatchingRules::zbuduj(RegulaPriorytetowa regula, std::vector<int>& kolejnosc, std::mt19937* gen, double losowosc)
+{
+    return buduj(regula, kolejnosc, gen, losowosc, 0.0);
+}
+
+int DispatchingRules::zbudujGRASP(RegulaPriorytetowa regula, double alfa, std::mt19937& gen, std::vector<int>& kolejnosc)
+{
+    return buduj(regula, kolejnosc, &gen, 0.0, alfa);
+}
+
+// Większa ocena = większy priorytet
+long long DispatchingRules::ocena(RegulaPriorytetowa regula, int job) const
+{
+    int k = nastepna[job];
+    switch (regula)
+    {
+    case RegulaPriorytetowa::SPT: return -czas[k];
+    case RegulaPriorytetowa::LPT: return czas[k];
+    case RegulaPriorytetowa::MWKR: return pozostalaPraca[k];
+    case RegulaPriorytetowa::MOPNR: return pozostaleOperacje[k];
+    case RegulaPriorytetowa::FIFO: return -gotowyJob[job];
+    case RegulaPriorytetowa::Losowa: break;
+    }
+    return 0;
+}
+
+int DispatchingRules::buduj(RegulaPriorytetowa regula, std::vector<int>& kolejnosc, std::mt19937* gen, double losowosc, double alfa)
+{
+    const int N = operacje.size();
+    for (int j = 0; j < liczbaJobow; ++j)
+    {
+        nastepna[j] = poczatekJoba[j];
+        gotowyJob[j] = 0;
+    }
+    std::fill(wolnaMaszyna.begin(), wolnaMaszyna.end(), 0);
+    kolejnosc.clear();
+    kolejnosc.reserve(N);
+
+    std::uniform_real_distribution<double> los(0.0, 1.0);
+    int makespan = 0;
+    for (int krok = 0; krok < N; ++krok)
+    {
+        // Operacja kończąca się najwcześniej wyznacza maszynę i horyzont konfliktu
+        int najwczesniejszyKoniec = std::numeric_limits<int>::max();
+        int m = -1;
+        int jobKonca = -1;
+        for (int j = 0; j < liczbaJobow; ++j)
+        {
+            int k = nastepna[j];
+            if (k == poczatekJoba[j + 1])
+                continue;
+            int koniec = std::max(gotowyJob[j], wolnaMaszyna[maszyna[k]]) + czas[k];
+            if (koniec < najwczesniejszyKoniec)
+            {
+                najwczesniejszyKoniec = koniec;
+                m = maszyna[k];
+                jobKonca = j;
+            }
+        }
+
+        // Konflikt: operacje na tej maszynie, które mogą zacząć się przed tym końcem
+        konflikt.clear();
+        for (int j = 0; j < liczbaJobow; ++j)
+        {
+            int k = nastepna[j];
+            if (k != poczatekJoba[j + 1] && maszyna[k] == m && std::max(gotowyJob[j], wolnaMaszyna[m]) < najwczesniejszyKoniec)
+                konflikt.push_back(j);
+        }
+        if (konflikt.empty())
+            konflikt.push_back(jobKonca); // operacje zerowej długości
+
+        int wybrany = konflikt[0];
+        bool losowo = (regula == RegulaPriorytetowa::Losowa) || (gen != nullptr && losowosc > 0.0 && los(*gen) < losowosc);
+        if (losowo && gen != nullptr)
+        {
+            std::uniform_int_distribution<> dist(0, (int)konflikt.size() - 1);
+            wybrany = konflikt[dist(*gen)];
+        }
+        else if (alfa > 0.0 && gen != nullptr && konflikt.size() > 1)
+        {
+            long long najwieksza = std::numeric_limits<long long>::min();
+            long long najmniejsza = std::numeric_limits<long long>::max();
+            for (int j : konflikt)
+            {
+                najwieksza = std::max(najwieksza, ocena(regula, j));
+                najmniejsza = std::min(najmniejsza, ocena(regula, j));
+            }
+            double prog = najwieksza - alfa * (double)(najwieksza - najmniejsza);
+            kandydaci.clear();
+            for (int j : konflikt)
+                if (ocena(regula, j) >= prog)
+                    kandydaci.push_back(j);
+            std::uniform_int_distribution<> dist(0, (int)kandydaci.size() - 1);
+            wybrany = kandydaci[dist(*gen)];
+        }
+        else
+        {
+            // Remis – mniejszy numer joba
+            long long najlepszaOcena = std::numeric_limits<long long>::min();
+            for (int j : konflikt)
+            {
+                long long o = ocena(regula, j);
+                if (o > najlepszaOcena)
+                {
+                    najlepszaOcena = o;
+                    wybrany = j;
+                }
+            }
+        }
+
+        int k = nastepna[wybrany]++;
+        int koniec = std::max(gotowyJob[wybrany], wolnaMaszyna[m]) + czas[k];
+        gotowyJob[wybrany] = koniec;
+        wolnaMaszyna[m] = koniec;
+        makespan = std::max(makespan, koniec);
+        kolejnosc.push_back(indeksOperacji[k]);
+    }
+    return makespan;
+}
+
+void DispatchingRules::generuj(int ile, Kodowanie kodowanie, std::mt19937& gen, std::vector<std::vector<int>>& genotypy,
+                               std::vector<int>& makespany, double losowosc)
+{
+    const int liczbaDeterministycznych = sizeof(regulyDeterministyczne) / sizeof(regulyDeterministyczne[0]);
+    genotypy.resize(ile);
+    makespany.resize(ile);
+    for (int n = 0; n < ile; ++n)
+    {
+        int makespan;
+        if (n < liczbaDeterministycznych)
+        {
+            makespan = zbuduj(regulyDeterministyczne[n], kolejnoscRobocza);
+        }
+        else
+        {
+            int r = (n - liczbaDeterministycznych) % (liczbaDeterministycznych + 1);
+            RegulaPriorytetowa regula = (r < liczbaDeterministycznych) ? regulyDeterministyczne[r] : RegulaPriorytetowa::Losowa;
+            makespan = zbuduj(regula, kolejnoscRobocza, &gen, losowosc);
+        }
+        genotypy[n] = genotypZKolejnosci(operacje, kolejnoscRobocza, kodowanie);
+        makespany[n] = makespan;
+    }
+}
+
+void DispatchingRules::wypiszRaport()
+{
+    std::cout << "[Reguly]";
+    for (RegulaPriorytetowa regula : regulyDeterministyczne)
+        std::cout << " " << nazwaReguly(regula) << ": " << zbuduj(regula, kolejnoscRobocza);
+    std::cout << "\n";
+}
@@ -0,0 +1,73 @@
+#ifndef DISPATCHING_RULES_H
+#define DISPATCHING_RULES_H
+
+#include "OperationSchedule.h"
+#include "Encoding.h"
+#include <vector>
+#include <random>
+
+// Reguła wyboru operacji spośród konfliktujących na maszynie
+enum class RegulaPriorytetowa
+{
+    SPT,    // najkrótsza operacja
+    LPT,    // najdłuższa operacja
+    MWKR,   // najwięcej pozostałej pracy joba
+    MOPNR,  // najwięcej pozostałych operacji joba
+    FIFO,   // job najdłużej czekający (najwcześniej gotowy)
+    Losowa  // losowa operacja z konfliktu (losowy harmonogram aktywny)
+};
+
+const char* nazwaReguly(RegulaPriorytetowa regula);
+
+// Rozwiązania z reguł priorytetowych budowane algorytmem Gifflera–Thompsona (harmonogramy aktywne).
+// Tabele pracy i operacji pozostałych w jobie liczone są raz na instancję, a stan budowy trzymany
+// w płaskich tablicach po jobach, więc jedno rozwiązanie kosztuje O(N * liczbaJobow) bez alokacji.
+// Kolejność wyboru operacji zdekodowana półaktywnie daje dokładnie zbudowany harmonogram.
+class DispatchingRules
+{
+public:
+    DispatchingRules(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn);
+
+    // Kolejność operacji (indeksy instancji) z reguły; `losowosc` = szansa wyboru losowej operacji
+    // z konfliktu zamiast wskazanej przez regułę (wymaga gen). Zwraca makespan.
+    int zbuduj(RegulaPriorytetowa regula, std::vector<int>& kolejnosc, std::mt19937* gen = nullptr, double losowosc = 0.0);
+
+    // Konstrukcja GRASP: z konfliktu losowana jest operacja z listy kandydatów (RCL), czyli tych,
+    // których ocena reguły jest nie gorsza niż max - alfa * (max - min). alfa = 0 to czysta reguła,
+    // alfa = 1 to losowy harmonogram aktywny. Zwraca makespan.
+    int zbudujGRASP(RegulaPriorytetowa regula, double alfa, std::mt19937& gen, std::vector<int>& kolejnosc);
+
+    // `ile` genotypów w danym kodowaniu: najpierw po jednym czystym z każdej reguły deterministycznej,
+    // potem wszystkie reguły na zmianę z zaburzeniem `losowosc`. Makespany (półaktywne) trafiają do `makespany`.
+    void generuj(int ile, Kodowanie kodowanie, std::mt19937& gen, std::vector<std::vector<int>>& genotypy,
+                 std::vector<int>& makespany, double losowosc = 0.2);
+
+    // Makespan każdej reguły deterministycznej na std::cout
+    void wypiszRaport();
+
+private:
+    int buduj(RegulaPriorytetowa regula, std::vector<int>& kolejnosc, std::mt19937* gen, double losowosc, double alfa);
+    long long ocena(RegulaPriorytetowa regula, int job) const;
+
+    const std::vector<OperationSchedule>& operacje;
+    int liczbaJobow;
+    int liczbaMaszyn;
+
+    // Operacje jobów w kolejności technologicznej, płasko: job j zajmuje [poczatekJoba[j], poczatekJoba[j + 1])
+    std::vector<int> poczatekJoba;
+    std::vector<int> indeksOperacji;
+    std::vector<int> czas;
+    std::vector<int> maszyna;
+    std::vector<int> pozostalaPraca;     // czas tej i dalszych operacji joba
+    std::vector<int> pozostaleOperacje;  // liczba tej i dalszych operacji joba
+
+    // Stan budowy
+    std::vector<int> nastepna;     // pozycja bieżącej operacji joba w tablicach płaskich (koniec = job skończony)
+    std::vector<int> gotowyJob;
+    std::vector<int> wolnaMaszyna;
+    std::vector<int> konflikt;
+    std::vector<int> kandydaci;
+    std::vector<int> kolejnoscRobocza;
+};
+
+#endif
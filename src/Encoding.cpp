@@ -0,0 +1,60 @@
+#include "Encoding.h"
+
+std::vector<int> genotypBazowy(const std::vector<OperationSchedule>& operacje, Kodowanie kodowanie)
+{
+    std::vector<int> genotyp(operacje.size());
+    for (int i = 0; i < (int)operacje.size(); ++i)
+    {
+        genotyp[i] = (kodowanie == Kodowanie::PowtorzeniaJobow) ? operacje[i].job_id : i;
+    }
+    return genotyp;
+}
+
+// Wypełnia potomka: geny z "zachowaj" zostają z dawcy segmentu, reszta po kolei z wypełniacza
+static void jox(const std::vector<int>& dawca,
+                const std::vector<int>& wypelniacz,
+                const std::vector<char>& zachowaj,
+                std::vector<int>& potomek)
+{
+    int n = dawca.size();
+    potomek.assign(n, -1);
+
+    for (int i = 0; i < n; ++i)
+    {
+        if (zachowaj[dawca[i]]) potomek[i] = dawca[i];
+    }
+
+    int k = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        if (potomek[i] != -1) continue;
+        while (zachowaj[wypelniacz[k]]) ++k;
+        potomek[i] = wypelniacz[k++];
+    }
+}
+
+void krzyzowanieJOX(const std::vector<int>& rodzic1,
+                    const std::vector<int>& rodzic2,
+                    std::vector<int>& potomek1,
+                    std::vector<int>& potomek2,
+                    int liczbaJobow,
+                    std::mt19937& gen)
+{
+    std::bernoulli_distribution rzut(0.5);
+    std::vector<char> zachowaj(liczbaJobow);
+    for (int j = 0; j < liczbaJobow; ++j)
+    {
+        zachowaj[j] = rzut(gen);
+    }
+
+    jox(rodzic1, rodzic2, zachowaj, potomek1);
+    jox(rodzic2, rodzic1, zachowaj, potomek2);
+}
+
+int odlegloscHamminga(const std::vector<int>& a, const std::vector<int>& b)
+{
+    int d = 0;
+    for (size_t i = 0; i < a.size(); ++i)
+        d += a[i] != b[i];
+    return d;
+}
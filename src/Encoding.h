@@ -0,0 +1,32 @@
+#ifndef ENCODING_H
+#define ENCODING_H
+
+#include "OperationSchedule.h"
+#include <vector>
+#include <random>
+
+// Sposób zapisu genotypu
+enum class Kodowanie
+{
+    Priorytety,       // genotyp[i] = priorytet operacji i (permutacja 0..N-1)
+    PowtorzeniaJobow  // genotyp to ciąg numerów jobów, job j występuje tyle razy, ile ma operacji;
+                      // k-te wystąpienie j oznacza k-tą operację joba j, więc każdy ciąg jest poprawny
+};
+
+// Genotyp "identycznościowy" dla danego kodowania – do przetasowania przez solver
+std::vector<int> genotypBazowy(const std::vector<OperationSchedule>& operacje, Kodowanie kodowanie);
+
+// Krzyżowanie JOX dla kodowania z powtórzeniami: losowy podzbiór jobów zostaje na
+// pozycjach pierwszego rodzica, pozostałe pozycje wypełnia drugi rodzic w swojej kolejności.
+// Liczba wystąpień każdego joba się nie zmienia, więc potomkowie zawsze są poprawni.
+void krzyzowanieJOX(const std::vector<int>& rodzic1,
+                    const std::vector<int>& rodzic2,
+                    std::vector<int>& potomek1,
+                    std::vector<int>& potomek2,
+                    int liczbaJobow,
+                    std::mt19937& gen);
+
+// Liczba pozycji, na których genotypy się różnią (np. wybór ofiary podobnej do potomka)
+int odlegloscHamminga(const std::vector<int>& a, const std::vector<int>& b);
+
+#endif
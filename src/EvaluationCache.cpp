@@ -0,0 +1,72 @@
+#include "EvaluationCache.h"
+#include <iostream>
+
+EvaluationCache::EvaluationCache(int rozmiarLog2, bool kluczSekwencji)
+    : slowa(std::size_t(2) << rozmiarLog2),
+      maska((uint64_t(1) << rozmiarLog2) - 1),
+      kluczSekwencji(kluczSekwencji),
+      trafieniaGenotypu(0),
+      trafieniaSekwencji(0),
+      chybienia(0)
+{
+    for (std::size_t i = 0; i < slowa.size(); ++i)
+        slowa[i].store(0, std::memory_order_relaxed);
+}
+
+bool EvaluationCache::szukaj(uint64_t klucz, uint64_t& dane)
+{
+    std::size_t w = 2 * (klucz & maska);
+    uint64_t kluczXorDane = slowa[w].load(std::memory_order_relaxed);
+    uint64_t d = slowa[w + 1].load(std::memory_order_relaxed);
+
+    // dane == 0 to pusty wpis (makespan nigdy nie jest zerowy)
+    if (d == 0 || (kluczXorDane ^ d) != klucz)
+        return false;
+
+    dane = d;
+    return true;
+}
+
+void EvaluationCache::zapisz(uint64_t klucz, uint64_t dane)
+{
+    std::size_t w = 2 * (klucz & maska);
+    slowa[w].store(klucz ^ dane, std::memory_order_relaxed);
+    slowa[w + 1].store(dane, std::memory_order_relaxed);
+}
+
+uint64_t EvaluationCache::zobrist(uint32_t a, uint32_t b)
+{
+    // splitmix64
+    uint64_t z = ((uint64_t(a) << 32) | b) + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t EvaluationCache::hashGenotypu(const std::vector<int>& genotyp)
+{
+    uint64_t h = 0;
+    for (int i = 0; i < (int)genotyp.size(); ++i)
+        h ^= zobrist(i, genotyp[i]);
+    return h;
+}
+
+uint64_t EvaluationCache::hashPoZamianie(uint64_t hash, int i, int j, int genI, int genJ)
+{
+    return hash ^ zobrist(i, genI) ^ zobrist(j, genJ) ^ zobrist(i, genJ) ^ zobrist(j, genI);
+}
+
+double EvaluationCache::getWspolczynnikTrafien() const
+{
+    uint64_t trafienia = getTrafieniaGenotypu() + getTrafieniaSekwencji();
+    uint64_t wszystkie = trafienia + getChybienia();
+    return wszystkie == 0 ? 0.0 : static_cast<double>(trafienia) / wszystkie;
+}
+
+void EvaluationCache::wypiszStatystyki(const char* nazwa) const
+{
+    std::cout << "[" << nazwa << "] Cache: trafienia genotyp/sekwencje = "
+              << getTrafieniaGenotypu() << "/" << getTrafieniaSekwencji()
+              << ", chybienia = " << getChybienia()
+              << ", hit rate = " << getWspolczynnikTrafien() * 100.0 << "%\n";
+}
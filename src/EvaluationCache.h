@@ -0,0 +1,58 @@
+#ifndef EVALUATION_CACHE_H
+#define EVALUATION_CACHE_H
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+// Pamięć podręczna ocen o stałym rozmiarze, bez blokad.
+// Wpis to dwa słowa: (klucz ^ dane) i dane – odczyt sprawdza, czy klucz się zgadza,
+// więc rozerwany zapis z innego wątku daje najwyżej chybienie, nigdy zły wynik.
+// Dane = makespan (młodsze 32 bity) + podpis harmonogramu (starsze 32 bity).
+//
+// Klucze to hashe Zobrista liczone w locie (splitmix64 z pary liczb) zamiast tablicy
+// losowych liczb, więc działają też dla instancji z Known-Optima (200k operacji).
+//
+// Klucz sekwencji maszyn wymaga dodatkowego przejścia po operacjach, które kosztuje mniej
+// więcej połowę liczenia czasów w dekoderze półaktywnym – opłaca się przy dużej liczbie
+// powrotów do tych samych harmonogramów, dlatego jest opcjonalny.
+class EvaluationCache
+{
+public:
+    explicit EvaluationCache(int rozmiarLog2 = 16, bool kluczSekwencji = false);
+
+    bool czyKluczSekwencji() const { return kluczSekwencji; }
+
+    bool szukaj(uint64_t klucz, uint64_t& dane);
+    void zapisz(uint64_t klucz, uint64_t dane);
+
+    // Składnik hasha Zobrista dla pary (a, b), np. (pozycja, gen) albo (operacja, pozycja na maszynie)
+    static uint64_t zobrist(uint32_t a, uint32_t b);
+
+    // Hash genotypu: XOR zobrist(i, genotyp[i]); po zamianie genów i, j aktualizowany w O(1)
+    static uint64_t hashGenotypu(const std::vector<int>& genotyp);
+    static uint64_t hashPoZamianie(uint64_t hash, int i, int j, int genI, int genJ);
+
+    // Liczniki (relaxed – służą tylko do raportowania)
+    void policzTrafienieGenotypu() { trafieniaGenotypu.fetch_add(1, std::memory_order_relaxed); }
+    void policzTrafienieSekwencji() { trafieniaSekwencji.fetch_add(1, std::memory_order_relaxed); }
+    void policzChybienie() { chybienia.fetch_add(1, std::memory_order_relaxed); }
+
+    uint64_t getTrafieniaGenotypu() const { return trafieniaGenotypu.load(std::memory_order_relaxed); }
+    uint64_t getTrafieniaSekwencji() const { return trafieniaSekwencji.load(std::memory_order_relaxed); }
+    uint64_t getChybienia() const { return chybienia.load(std::memory_order_relaxed); }
+    double getWspolczynnikTrafien() const;
+
+    void wypiszStatystyki(const char* nazwa) const;
+
+private:
+    std::vector<std::atomic<uint64_t>> slowa; // 2 słowa na wpis
+    uint64_t maska;
+    bool kluczSekwencji;
+
+    std::atomic<uint64_t> trafieniaGenotypu;
+    std::atomic<uint64_t> trafieniaSekwencji;
+    std::atomic<uint64_t> chybienia;
+};
+
+#endif
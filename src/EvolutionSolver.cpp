@@ -1,4 +1,11 @@
 #include "EvolutionSolver.h"
+#include "Checkpoint.h"
+#include "Metrics.h"
+#include "Log.h"
+#include "SolverEvents.h"
+#include "PopulationTrace.h"
+#include "DispatchingRules.h"
+#include "IndexedHeap.h"
 #include <random>
 #include <algorithm>
 #include <limits>
@@ -6,6 +13,9 @@
 #include <numeric>
 #include <fstream>
 #include <utility>
+#include <unordered_set>
+#include <unordered_map>
+#include <memory>
 
 EvolutionSolver::EvolutionSolver(int populacja, int pokolenia, double prawdopodobMutacji, double prawdopodobKrzyzowania, int tourSize)
     : rozmiarPopulacji(populacja),
@@ -15,129 +25,307 @@ EvolutionSolver::EvolutionSolver(int populacja, int pokolenia, double prawdopodo
       tourSize(tourSize),
       najlepszyMakespan(std::numeric_limits<int>::max()),
       liczbaJobow(0),
-      liczbaMaszyn(0) {}
+      liczbaMaszyn(0),
+      trybDekodera(TrybDekodera::Polaktywny),
+      kodowanie(Kodowanie::Priorytety),
+      cel(0),
+      cache(nullptr),
+      odrzucajDuplikaty(false),
+      czescZRegul(0.0),
+      stanUstalony(false),
+      potomkowNaKrok(2),
+      zastepowanie(Zastepowanie::Najgorszy),
+      gen(std::random_device{}()),
+      coIleCheckpoint(0),
+      plikSladu("ewolucyjny.trc"),
+      coIleSlad(1),
+      najlepszychSlad(0) {}
 
 void EvolutionSolver::solve(const std::vector<OperationSchedule>& operacje, int lj, int lm) {
-     std::mt19937 gen(std::random_device{}());
-    std::ofstream plik("ewolucyjny.csv");
-plik << "Pokolenie;Populacja;Fitness;Priorytety\n";
     liczbaJobow = lj;
     liczbaMaszyn = lm;
-    int liczbaOperacji = operacje.size();
-
-    // === Inicjalizacja populacji ===
-    populacja.clear();
-    for (int i = 0; i < rozmiarPopulacji; ++i) {
-        Individual individual = stworzLosowyOsobnik(liczbaOperacji);
-        individual.fitness = ocenOsobnik(individual, operacje);
-        populacja.push_back(individual);
+    ScheduleDecoder dekoder(operacje, liczbaJobow, liczbaMaszyn, trybDekodera, kodowanie);
+    dekoder.ustawCache(cache);
+    dekoder.ustawLiczeniePodpisu(odrzucajDuplikaty);
+    std::vector<int> bazowy = genotypBazowy(operacje, kodowanie);
+
+    int epoka = 0;
+    uint64_t sumaInstancji = sumaKontrolnaInstancji(operacje, liczbaJobow, liczbaMaszyn);
+    bool wznowiono = !plikWznowienia.empty() && wczytajCheckpoint(sumaInstancji, epoka);
+
+    // Po wznowieniu dopisujemy kolejne pokolenia do istniejącego śladu
+    std::unique_ptr<PopulationTrace> slad;
+    if (!plikSladu.empty() && coIleSlad > 0)
+        slad.reset(new PopulationTrace(plikSladu, bazowy.size(), wznowiono));
+
+    if (wznowiono) {
+        if (!najlepszyGenotyp.empty())
+            dekoder.dekoduj(najlepszyGenotyp, &najlepszyHarmonogram);
+    } else {
+        // === Inicjalizacja populacji ===
+        populacja.clear();
+        najlepszyMakespan = std::numeric_limits<int>::max();
+        najlepszyGenotyp.clear();
+        std::vector<std::vector<int>> zRegul;
+        std::vector<int> makespanyRegul;
+        int ileZRegul = std::min(rozmiarPopulacji, (int)(czescZRegul * rozmiarPopulacji));
+        if (ileZRegul > 0)
+            DispatchingRules(operacje, liczbaJobow, liczbaMaszyn).generuj(ileZRegul, kodowanie, gen, zRegul, makespanyRegul);
+
+        for (int i = 0; i < rozmiarPopulacji; ++i) {
+            Individual individual;
+            if (i < ileZRegul)
+                individual.priorytety.swap(zRegul[i]);
+            else
+                individual = stworzLosowyOsobnik(bazowy);
+            bool startowy = (i == 0 && genotypStartowy.size() == bazowy.size());
+            if (startowy)
+                individual.priorytety = genotypStartowy;
+            individual.fitness = ocenOsobnik(individual, dekoder);
+            populacja.push_back(individual);
+
+            // Najlepszy osobnik startowy (z reguł albo genotypStartowy) jest punktem odniesienia od początku
+            if (individual.fitness < najlepszyMakespan) {
+                najlepszyMakespan = individual.fitness;
+                najlepszyGenotyp = individual.priorytety;
+            }
+        }
+        if (!najlepszyGenotyp.empty())
+            dekoder.dekoduj(najlepszyGenotyp, &najlepszyHarmonogram);
     }
 
-    for (int epoka = 0; epoka < liczbaPokolen; ++epoka) {
-       // std::cout << "\n--- Epoka " << epoka + 1 << " ---\n";
-        std::vector<Individual> nowaPopulacja;
-
-        while ((int)nowaPopulacja.size() < rozmiarPopulacji) {
-            Individual r1 = turniej(populacja, tourSize, gen);
-            Individual r2 = turniej(populacja, tourSize, gen);
-          //  std::cout << "Turniej: r1.fitness = " << r1.fitness << ", r2.fitness = " << r2.fitness << "\n";
-
-            std::uniform_real_distribution<> disProb(0.0, 1.0);
-            double probabilityCrossover = disProb(gen);
-            //std::cout << "Prawd krzyżowania: "<<probabilityCrossover<<"\n";
-            Individual child1 = r1;
-            Individual child2 = r2;
-
-            if (probabilityCrossover < prawdopodobienstwoKrzyzowania) {
-                 std::pair<Individual, Individual> children = krzyzowanieOX(r1, r2, gen);
-                //  std::cout << "Krzyżowanie wykonane:\n";
-                 //   std::cout << "  Rodzic 1: ";
-                for (int g : r1.priorytety) std::cout << g << " ";
-                //std::cout << "\n  Rodzic 2: ";
-                for (int g : r2.priorytety) std::cout << g << " ";
-               // std::cout << "\n";
-                 child1 = children.first;
-                child2 = children.second;
-               
-               // std::cout << "  Dziecko 1: ";
-                for (int g : child1.priorytety) std::cout << g << " ";
-              //  std::cout << "\n  Dziecko 2: ";
-                for (int g : child2.priorytety) std::cout << g << " ";
-               // std::cout << "\n";
+    std::unique_ptr<CheckpointWriter> zapis;
+    if (!plikCheckpointu.empty())
+        zapis.reset(new CheckpointWriter(plikCheckpointu));
+
+    std::unique_ptr<MemeticImprover> memetyka;
+    if (memetyczne.tryb != TrybMemetyczny::Brak)
+        memetyka.reset(new MemeticImprover(operacje, liczbaJobow, liczbaMaszyn, trybDekodera, kodowanie, memetyczne));
+
+    // Stan ustalony: kopiec najgorszych i liczniki podpisów odtwarzane z populacji (także po wznowieniu)
+    KopiecIndeksowany najgorsi;
+    std::unordered_map<uint32_t, int> podpisy;
+    std::vector<Individual> potomstwo;
+    if (stanUstalony) {
+        std::vector<int> fitness(populacja.size());
+        for (int i = 0; i < (int)populacja.size(); ++i) {
+            fitness[i] = populacja[i].fitness;
+            if (odrzucajDuplikaty)
+                ++podpisy[populacja[i].podpis];
+        }
+        najgorsi.zbuduj(fitness);
+    }
+
+    for (; epoka < liczbaPokolen && najlepszyMakespan > cel; ++epoka) {
+        LOG_SLAD(Ewolucja, "Epoka " << epoka + 1);
+        if (stanUstalony)
+            pokolenieUstalone(najgorsi, podpisy, potomstwo, memetyka.get(), dekoder);
+        else
+            pokolenieGeneracyjne(memetyka.get(), dekoder);
+
+        if (slad && (epoka + 1) % coIleSlad == 0) {
+            METRYKA_FAZA(Logowanie);
+            zapiszSlad(epoka + 1, *slad);
+        }
+
+        for (const auto& individual : populacja) {
+            if (individual.fitness < najlepszyMakespan) {
+                najlepszyMakespan = individual.fitness;
+                najlepszyGenotyp = individual.priorytety;
+                // U Baldwina koszt osobnika należy do jego poprawionej wersji
+                if (memetyka && memetyczne.tryb == TrybMemetyczny::Baldwin)
+                    memetyka->popraw(najlepszyGenotyp);
+                dekoder.dekoduj(najlepszyGenotyp, &najlepszyHarmonogram);
+                METRYKA_DODAJ(Poprawy, 1);
+                zglosPoprawe(najlepszyMakespan);
+                LOG_DEBUG(Ewolucja, "Pokolenie " << epoka + 1 << ": nowy najlepszy makespan = " << najlepszyMakespan);
             }
-            double probabilityMutation = disProb(gen);
-           // std::cout << "Prawd mutacji: "<<probabilityMutation<<"\n";
-            if (probabilityMutation < prawdopodobienstwoMutacji) mutacjaSwap(child1);
-            if (probabilityMutation < prawdopodobienstwoMutacji) mutacjaSwap(child2);
-           //  for (int g : child1.priorytety) std::cout << g << " ";
-            //    std::cout << "\n  Dziecko 2: ";
-          //  for (int g : child2.priorytety) std::cout << g << " ";
-          //      std::cout << "\n";
-            child1.fitness = ocenOsobnik(child1, operacje);
-            child2.fitness = ocenOsobnik(child2, operacje);
-                 //       std::cout << "Fitness dzieci: child1 = " << child1.fitness << ", child2 = " << child2.fitness << "\n";
+        }
 
+        if (zapis && ((coIleCheckpoint > 0 && (epoka + 1) % coIleCheckpoint == 0) || czyZadanoCheckpointu())) {
+            METRYKA_FAZA(Logowanie);
+            if (slad)
+                slad->oproznij(); // ślad nie może być za checkpointem
+            zapiszCheckpoint(epoka + 1, sumaInstancji, *zapis);
+            potwierdzCheckpoint();
+        }
+        if (czyZadanoZatrzymania()) {
+            ++epoka;
+            break;
+        }
+    }
 
-            nowaPopulacja.push_back(child1); 
-            nowaPopulacja.push_back(child2);
+    // Zatrzymany przebieg zostawia stan do wznowienia; zakończony usuwa checkpoint
+    if (zapis && czyZadanoZatrzymania()) {
+        if (slad)
+            slad->oproznij();
+        zapiszCheckpoint(epoka, sumaInstancji, *zapis);
+    } else if (zapis) {
+        zapis->porzuc();
+    }
 }
 
-
-        // Dopisz dane do pliku CSV
-    for (size_t i = 0; i < nowaPopulacja.size(); ++i) {
-        plik << epoka + 1 << ";" << i << ";" << nowaPopulacja[i].fitness << ";";
-        for (size_t j = 0; j < nowaPopulacja[i].priorytety.size(); ++j) {
-            plik << nowaPopulacja[i].priorytety[j];
-            if (j < nowaPopulacja[i].priorytety.size() - 1) plik << "-";
+void EvolutionSolver::pokolenieGeneracyjne(MemeticImprover* memetyka, ScheduleDecoder& dekoder) {
+    METRYKA_FAZA(Sasiedztwo);
+    std::vector<Individual> nowaPopulacja;
+    std::unordered_set<uint32_t> podpisy;
+    int odrzucone = 0;
+    const int limitOdrzucen = 10 * rozmiarPopulacji; // zbiegnięta populacja nie może zablokować pętli
+
+    // Elitaryzm: najlepszy osobnik przechodzi bez zmian, więc pokolenie nie pogarsza wyniku
+    nowaPopulacja.reserve(rozmiarPopulacji);
+    const Individual& elita = *std::min_element(populacja.begin(), populacja.end(),
+        [](const Individual& a, const Individual& b) { return a.fitness < b.fitness; });
+    nowaPopulacja.push_back(elita);
+    if (odrzucajDuplikaty)
+        podpisy.insert(elita.podpis);
+
+    while ((int)nowaPopulacja.size() < rozmiarPopulacji) {
+        Individual r1 = populacja[turniej(populacja, tourSize, gen)];
+        Individual r2 = populacja[turniej(populacja, tourSize, gen)];
+        LOG_SLAD(Ewolucja, "Turniej: r1.fitness = " << r1.fitness << ", r2.fitness = " << r2.fitness);
+
+        std::uniform_real_distribution<> disProb(0.0, 1.0);
+        double probabilityCrossover = disProb(gen);
+        Individual child1 = r1;
+        Individual child2 = r2;
+
+        if (probabilityCrossover < prawdopodobienstwoKrzyzowania) {
+             std::pair<Individual, Individual> children;
+             if (kodowanie == Kodowanie::PowtorzeniaJobow)
+                 krzyzowanieJOX(r1.priorytety, r2.priorytety, children.first.priorytety, children.second.priorytety, liczbaJobow, gen);
+             else
+                 children = krzyzowanieOX(r1, r2, gen);
+            child1 = children.first;
+            child2 = children.second;
+        }
+        double probabilityMutation = disProb(gen);
+        if (probabilityMutation < prawdopodobienstwoMutacji) mutacjaSwap(child1);
+        if (probabilityMutation < prawdopodobienstwoMutacji) mutacjaSwap(child2);
+        LOG_SLAD(Ewolucja, "Dziecko 1: " << WektorLogu{ child1.priorytety });
+        LOG_SLAD(Ewolucja, "Dziecko 2: " << WektorLogu{ child2.priorytety });
+        child1.fitness = ocenOsobnik(child1, dekoder);
+        child2.fitness = ocenOsobnik(child2, dekoder);
+        LOG_SLAD(Ewolucja, "Fitness dzieci: child1 = " << child1.fitness << ", child2 = " << child2.fitness);
+
+
+        Individual* dzieci[2] = { &child1, &child2 };
+        for (Individual* dziecko : dzieci) {
+            if ((int)nowaPopulacja.size() >= rozmiarPopulacji)
+                break;
+            if (odrzucajDuplikaty && odrzucone < limitOdrzucen && !podpisy.insert(dziecko->podpis).second) {
+                ++odrzucone;
+                continue;
+            }
+            nowaPopulacja.push_back(*dziecko);
+            METRYKA_DODAJ(ZaakceptowaneRuchy, 1);
         }
-        plik << "\n";
     }
 
-        populacja = nowaPopulacja;
+    if (memetyka)
+        poprawPotomstwo(nowaPopulacja, *memetyka, dekoder);
 
-        for (const auto& individual : populacja) {
-            if (individual.fitness < najlepszyMakespan) {
-                najlepszyMakespan = individual.fitness;
-                najlepszyHarmonogram = budujHarmonogram(individual, operacje);
-            //    std::cout << "Pokolenie " << epoka + 1 << ": nowy najlepszy makespan = " << najlepszyMakespan << "\n";
+    populacja.swap(nowaPopulacja);
+}
+
+void EvolutionSolver::pokolenieUstalone(KopiecIndeksowany& najgorsi, std::unordered_map<uint32_t, int>& podpisy,
+                                        std::vector<Individual>& potomstwo, MemeticImprover* memetyka, ScheduleDecoder& dekoder) {
+    METRYKA_FAZA(Sasiedztwo);
+    std::uniform_real_distribution<> disProb(0.0, 1.0);
+    const int kroki = (rozmiarPopulacji + potomkowNaKrok - 1) / potomkowNaKrok;
+    potomstwo.resize(potomkowNaKrok); // bufory genotypów krążą między potomstwem a populacją
+    Individual zapas;                 // drugi potomek ostatniej pary przy nieparzystej liczbie
+
+    for (int krok = 0; krok < kroki; ++krok) {
+        int r1 = turniej(populacja, tourSize, gen);
+        int r2 = turniej(populacja, tourSize, gen);
+
+        for (int k = 0; k < potomkowNaKrok; k += 2) {
+            Individual& child1 = potomstwo[k];
+            Individual& child2 = k + 1 < potomkowNaKrok ? potomstwo[k + 1] : zapas;
+            child1.priorytety = populacja[r1].priorytety;
+            child2.priorytety = populacja[r2].priorytety;
+
+            if (disProb(gen) < prawdopodobienstwoKrzyzowania) {
+                if (kodowanie == Kodowanie::PowtorzeniaJobow) {
+                    krzyzowanieJOX(populacja[r1].priorytety, populacja[r2].priorytety, child1.priorytety, child2.priorytety, liczbaJobow, gen);
+                } else {
+                    std::pair<Individual, Individual> children = krzyzowanieOX(populacja[r1], populacja[r2], gen);
+                    child1.priorytety.swap(children.first.priorytety);
+                    child2.priorytety.swap(children.second.priorytety);
+                }
+            }
+            double probabilityMutation = disProb(gen);
+            if (probabilityMutation < prawdopodobienstwoMutacji) mutacjaSwap(child1);
+            if (probabilityMutation < prawdopodobienstwoMutacji) mutacjaSwap(child2);
+        }
+
+        // Memetyka potrzebuje dokładnych kosztów; bez niej potomek jest oceniany z progiem ofiary
+        if (memetyka) {
+            for (Individual& dziecko : potomstwo)
+                dziecko.fitness = ocenOsobnik(dziecko, dekoder);
+            poprawPotomstwo(potomstwo, *memetyka, dekoder);
+        }
+
+        for (Individual& dziecko : potomstwo) {
+            int ofiara = najgorsi.szczyt();
+            if (zastepowanie == Zastepowanie::PodobnyRodzic)
+                ofiara = odlegloscHamminga(dziecko.priorytety, populacja[r1].priorytety)
+                      <= odlegloscHamminga(dziecko.priorytety, populacja[r2].priorytety) ? r1 : r2;
+
+            // Remis też wchodzi (dryf po plateau); gorszy potomek nigdy – najlepszy osobnik nie ginie
+            const int prog = populacja[ofiara].fitness + 1;
+            if (!memetyka)
+                dziecko.fitness = ocenOsobnik(dziecko, dekoder, prog);
+            if (dziecko.fitness >= prog)
+                continue;
+            if (odrzucajDuplikaty && podpisy.count(dziecko.podpis))
+                continue;
+
+            if (odrzucajDuplikaty) {
+                if (--podpisy[populacja[ofiara].podpis] == 0)
+                    podpisy.erase(populacja[ofiara].podpis);
+                ++podpisy[dziecko.podpis];
             }
+            populacja[ofiara].priorytety.swap(dziecko.priorytety);
+            populacja[ofiara].fitness = dziecko.fitness;
+            populacja[ofiara].podpis = dziecko.podpis;
+            najgorsi.zmien(ofiara, dziecko.fitness);
+            METRYKA_DODAJ(ZaakceptowaneRuchy, 1);
+            LOG_SLAD(Ewolucja, "Krok " << krok + 1 << ": potomek " << dziecko.fitness << " zastepuje osobnika " << ofiara);
+
+            if (dziecko.fitness <= cel)
+                return;
         }
     }
 }
 
-EvolutionSolver::Individual EvolutionSolver::stworzLosowyOsobnik(int liczbaOperacji) {
+EvolutionSolver::Individual EvolutionSolver::stworzLosowyOsobnik(const std::vector<int>& bazowy) {
     Individual individual;
-    individual.priorytety.resize(liczbaOperacji);
-    //std::iota(individual.priorytety.begin(), individual.priorytety.end(), 0);
-    for (int i = 0; i < (int)individual.priorytety.size(); ++i) {
-    individual.priorytety[i] = i;
-}
-    std::mt19937 gen(std::random_device{}());
+    individual.priorytety = bazowy;
     std::shuffle(individual.priorytety.begin(), individual.priorytety.end(), gen);
     return individual;
 }
 
-int EvolutionSolver::ocenOsobnik(Individual& individual, const std::vector<OperationSchedule>& operacje) {
-    std::vector<OperationSchedule> kandydujace = operacje;
-    for (int i = 0; i < (int)individual.priorytety.size(); ++i) {
-        kandydujace[i].priority = individual.priorytety[i];
-    }
+int EvolutionSolver::ocenOsobnik(Individual& individual, ScheduleDecoder& dekoder, int prog) {
+    individual.podpis = 0;
+    if (cache == nullptr && !odrzucajDuplikaty)
+        return dekoder.dekodujDo(individual.priorytety, prog);
 
-    auto harmonogram = budujHarmonogram(individual, kandydujace);
-    int maks = 0;
-    for (const auto& o : harmonogram) {
-        if (o.end_time > maks) maks = o.end_time;
-    }
-    return maks;
+    int wynik = dekoder.ocenDo(individual.priorytety, EvaluationCache::hashGenotypu(individual.priorytety), prog);
+    if (wynik != ScheduleDecoder::ODCIETY)
+        individual.podpis = dekoder.getPodpis();
+    return wynik;
 }
 
-EvolutionSolver::Individual EvolutionSolver::turniej(const std::vector<Individual>& populacja, int tourSize, std::mt19937& gen) {
+int EvolutionSolver::turniej(const std::vector<Individual>& populacja, int tourSize, std::mt19937& gen) {
+    METRYKA_FAZA(Selekcja);
     std::uniform_int_distribution<> dist(0, (int)populacja.size() - 1);
-    Individual best = populacja[dist(gen)];
+    int best = dist(gen);
 
     for (int i = 1; i < tourSize; ++i) {
-        Individual kandydat = populacja[dist(gen)];
-        if (kandydat.fitness < best.fitness)
+        int kandydat = dist(gen);
+        if (populacja[kandydat].fitness < populacja[best].fitness)
             best = kandydat;
     }
 
@@ -145,7 +333,6 @@ EvolutionSolver::Individual EvolutionSolver::turniej(const std::vector<Individua
 }
 
 void EvolutionSolver::mutacjaSwap(Individual& individual) {
-    std::mt19937 gen(std::random_device{}());
     std::uniform_real_distribution<> probDist(0.0, 1.0);
     std::uniform_int_distribution<> geneDist(0, (int)individual.priorytety.size() - 1);
 
@@ -167,114 +354,152 @@ EvolutionSolver::krzyzowanieOX(const Individual& p1, const Individual& p2, std::
     int start = dist(gen), end = dist(gen);
     if (start > end) std::swap(start, end);
 
-   // std::cout << "Rozmiar: " << n << "\n";
-   // std::cout << "Zakres krzyżowania: start=" << start << ", end=" << end << "\n";
-   // std::cout << "Rodzic 1: ";
-   // for (int x : p1.priorytety) std::cout << x << " ";
-   // std::cout << "\nRodzic 2: ";
-   // for (int x : p2.priorytety) std::cout << x << " ";
-   // std::cout << "\n";
+    LOG_SLAD(Ewolucja, "OX: rozmiar " << n << ", zakres [" << start << ", " << end << "]");
+    LOG_SLAD(Ewolucja, "Rodzic 1: " << WektorLogu{ p1.priorytety });
+    LOG_SLAD(Ewolucja, "Rodzic 2: " << WektorLogu{ p2.priorytety });
 
     // Dziecko 1: segment od p1, reszta z p2
     Individual child1;
     child1.priorytety = std::vector<int>(n, -1);
     for (int i = start; i <= end; ++i)
         child1.priorytety[i] = p1.priorytety[i];
-    
-  //  std::cout << "Child1 po skopiowaniu segmentu: ";
-   // for (int x : child1.priorytety) std::cout << x << " ";
-   // std::cout << "\n";
 
     int index1 = (end + 1) % n;
     for (int i = 0; i < n; ++i) {
         int val = p2.priorytety[(end + 1 + i) % n];
         if (std::find(child1.priorytety.begin(), child1.priorytety.end(), val) == child1.priorytety.end()) {
             child1.priorytety[index1] = val;
-           // std::cout << "Dodano " << val << " do child1 na pozycję " << index1 << "\n";
             index1 = (index1 + 1) % n;
         }
     }
 
-    //std::cout << "Child1 końcowy: ";
-   // for (int x : child1.priorytety) std::cout << x << " ";
-   // std::cout << "\n";
-
     // Dziecko 2: segment od p2, reszta z p1
     Individual child2;
     child2.priorytety = std::vector<int>(n, -1);
     for (int i = start; i <= end; ++i)
         child2.priorytety[i] = p2.priorytety[i];
 
-   // std::cout << "Child2 po skopiowaniu segmentu: ";
-   // for (int x : child2.priorytety) std::cout << x << " ";
-   // std::cout << "\n";   
-        
     int index2 = (end + 1) % n;
     for (int i = 0; i < n; ++i) {
         int val = p1.priorytety[(end + 1 + i) % n];
         if (std::find(child2.priorytety.begin(), child2.priorytety.end(), val) == child2.priorytety.end()) {
             child2.priorytety[index2] = val;
-      //      std::cout << "Dodano " << val << " do child2 na pozycję " << index2 << "\n";
             index2 = (index2 + 1) % n;
         }
     }
 
-   // std::cout << "Child2 końcowy: ";
-   // for (int x : child2.priorytety) std::cout << x << " ";
-   // std::cout << "\n";
-
     return std::make_pair(child1, child2);
 }
 
-std::vector<OperationSchedule> EvolutionSolver::budujHarmonogram(const Individual& ch, const std::vector<OperationSchedule>& operacje) {
-    std::vector<OperationSchedule> kandydaci = operacje;
-    for (int i = 0; i < (int)ch.priorytety.size(); ++i) {
-        kandydaci[i].priority = ch.priorytety[i];
-        kandydaci[i].start_time = 0;
-        kandydaci[i].end_time = 0;
+std::vector<OperationSchedule> EvolutionSolver::budujHarmonogram(const Individual& ch, ScheduleDecoder& dekoder) {
+    std::vector<OperationSchedule> harmonogram;
+    dekoder.dekoduj(ch.priorytety, &harmonogram);
+    return harmonogram;
+}
+
+void EvolutionSolver::poprawPotomstwo(std::vector<Individual>& potomstwo, MemeticImprover& memetyka, ScheduleDecoder& dekoder) {
+    std::uniform_real_distribution<> los(0.0, 1.0);
+    std::vector<Individual*> wybrani;
+    std::vector<std::vector<int>*> genotypy;
+    for (Individual& osobnik : potomstwo) {
+        if (memetyczne.czescPotomstwa < 1.0 && los(gen) >= memetyczne.czescPotomstwa)
+            continue;
+        wybrani.push_back(&osobnik);
+        genotypy.push_back(&osobnik.priorytety);
     }
 
-    std::sort(kandydaci.begin(), kandydaci.end(), [](const auto& a, const auto& b) {
-        return a.priority < b.priority;
-    });
+    std::vector<int> fitness;
+    memetyka.popraw(genotypy, fitness);
 
-    std::vector<OperationSchedule> harmonogram;
-    std::vector<int> maszyna_wolna_od(liczbaMaszyn, 0);
-    std::vector<int> job_gotowy_od(liczbaJobow, 0);
-    std::vector<bool> czy_zrobione(kandydaci.size(), false);
-
-    while ((int)harmonogram.size() < (int)kandydaci.size()) {
-        for (int i = 0; i < (int)kandydaci.size(); ++i) {
-            if (czy_zrobione[i]) continue;
-            auto& op = kandydaci[i];
-
-            bool poprzedniaWykonana = (op.operation_id == 0);
-            if (!poprzedniaWykonana) {
-                for (int j = 0; j < (int)kandydaci.size(); ++j) {
-                    if (kandydaci[j].job_id == op.job_id &&
-                        kandydaci[j].operation_id == op.operation_id - 1 &&
-                        czy_zrobione[j]) {
-                        poprzedniaWykonana = true;
-                        break;
-                    }
-                }
-            }
+    for (size_t k = 0; k < wybrani.size(); ++k) {
+        wybrani[k]->fitness = fitness[k];
+        // Podpis (cache, duplikaty) musi odpowiadać nowemu genotypowi
+        if (memetyczne.tryb == TrybMemetyczny::Lamarck && (cache != nullptr || odrzucajDuplikaty))
+            wybrani[k]->fitness = ocenOsobnik(*wybrani[k], dekoder);
+    }
+}
 
-            if (poprzedniaWykonana) {
-                int start = std::max(maszyna_wolna_od[op.machine_id], job_gotowy_od[op.job_id]);
-                op.start_time = start;
-                op.end_time = start + op.processing_time;
+void EvolutionSolver::zapiszSlad(int pokolenie, PopulationTrace& slad) const {
+    std::vector<int> kolejnosc(populacja.size());
+    std::iota(kolejnosc.begin(), kolejnosc.end(), 0);
+    if (najlepszychSlad > 0 && najlepszychSlad < (int)populacja.size()) {
+        std::partial_sort(kolejnosc.begin(), kolejnosc.begin() + najlepszychSlad, kolejnosc.end(), [&](int a, int b) {
+            if (populacja[a].fitness != populacja[b].fitness) return populacja[a].fitness < populacja[b].fitness;
+            return a < b;
+        });
+        kolejnosc.resize(najlepszychSlad);
+        std::sort(kolejnosc.begin(), kolejnosc.end()); // w pliku w kolejności populacji, jak w CSV
+    }
 
-                maszyna_wolna_od[op.machine_id] = op.end_time;
-                job_gotowy_od[op.job_id] = op.end_time;
+    ProbkaPokolenia probka;
+    probka.pokolenie = pokolenie;
+    probka.geny.reserve(kolejnosc.size() * (populacja.empty() ? 0 : populacja[0].priorytety.size()));
+    for (int i : kolejnosc) {
+        probka.pozycje.push_back(i);
+        probka.fitness.push_back(populacja[i].fitness);
+        probka.geny.insert(probka.geny.end(), populacja[i].priorytety.begin(), populacja[i].priorytety.end());
+    }
+    slad.zlec(probka);
+}
 
-                czy_zrobione[i] = true;
-                harmonogram.push_back(op);
-            }
-        }
+void EvolutionSolver::zapiszCheckpoint(int epoka, uint64_t sumaInstancji, CheckpointWriter& zapis) const {
+    BuforZapisu b;
+    b.piszNaglowek("ewolucja", sumaInstancji, trybDekodera, kodowanie);
+    b.piszGenerator(gen);
+    b.piszInt(epoka);
+    b.piszInt(najlepszyMakespan);
+    b.piszWektor(najlepszyGenotyp);
+    b.piszInt(populacja.size());
+    for (size_t i = 0; i < populacja.size(); ++i) {
+        b.piszWektor(populacja[i].priorytety);
+        b.piszInt(populacja[i].fitness);
+        b.piszU64(populacja[i].podpis);
     }
+    b.zakoncz();
 
-    return harmonogram;
+    zapis.zlec(b.getDane());
+}
+
+bool EvolutionSolver::wczytajCheckpoint(uint64_t sumaInstancji, int& epoka) {
+    std::vector<char> dane;
+    if (!wczytajPlikBinarny(plikWznowienia, dane)) {
+        LOG_OSTRZEZENIE(Ewolucja, "Brak checkpointu " << plikWznowienia << " – start od nowa");
+        return false;
+    }
+
+    BuforOdczytu b(dane);
+    if (!b.czytajNaglowek("ewolucja", sumaInstancji, trybDekodera, kodowanie))
+        return false;
+
+    std::mt19937 g;
+    b.czytajGenerator(g);
+    int ep = b.czytajInt();
+    int najlepszy = b.czytajInt();
+    std::vector<int> genotyp;
+    b.czytajWektor(genotyp);
+    int rozmiar = b.czytajInt();
+
+    std::vector<Individual> wczytana;
+    for (int i = 0; i < rozmiar && b.ok(); ++i) {
+        Individual individual;
+        b.czytajWektor(individual.priorytety);
+        individual.fitness = b.czytajInt();
+        individual.podpis = static_cast<uint32_t>(b.czytajU64());
+        wczytana.push_back(individual);
+    }
+
+    if (!b.ok() || wczytana.empty()) {
+        LOG_OSTRZEZENIE(Ewolucja, "Niepelny checkpoint " << plikWznowienia);
+        return false;
+    }
+
+    gen = g;
+    epoka = ep;
+    najlepszyMakespan = najlepszy;
+    najlepszyGenotyp = genotyp;
+    populacja = wczytana;
+    LOG_INFO(Ewolucja, "Wznowiono z " << plikWznowienia << " od pokolenia " << epoka);
+    return true;
 }
 
 void EvolutionSolver::printSchedule() const {
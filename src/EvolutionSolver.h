@@ -2,8 +2,17 @@
 #define EVOLUTIONSOLVER_H
 
 #include "OperationSchedule.h"
+#include "ScheduleDecoder.h"
+#include "LocalSearch.h"
+#include "EvolutionarySolver.h"
 #include <vector>
 #include <random> 
+#include <string>
+#include <unordered_map>
+
+class CheckpointWriter;
+class PopulationTrace;
+class KopiecIndeksowany;
 
 class EvolutionSolver {
 public:
@@ -11,9 +20,49 @@ public:
     void solve(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn);
     void printSchedule() const;
 
+    // Wybór dekodera i kodowania genotypu (domyślnie półaktywny, priorytetowy)
+    void ustawTrybDekodera(TrybDekodera tryb) { trybDekodera = tryb; }
+    void ustawKodowanie(Kodowanie k) { kodowanie = k; }
+
+    // Zatrzymanie po osiągnięciu celu (np. znanego optimum)
+    void ustawCel(int cel) { this->cel = cel; }
+
+    // Wspólna pamięć podręczna ocen (jedna na instancję i tryb dekodera); nullptr = bez cache
+    void ustawCache(EvaluationCache* c) { cache = c; }
+    // Potomek dający harmonogram już obecny w nowej populacji jest odrzucany
+    void ustawOdrzucanieDuplikatow(bool odrzucaj) { odrzucajDuplikaty = odrzucaj; }
+
+    // Checkpoint co `coIle` pokoleń, na sygnał i przy zatrzymaniu (zakończony przebieg usuwa plik); pusta ścieżka = wyłączone
+    void ustawCheckpoint(const std::string& sciezka, int coIle) { plikCheckpointu = sciezka; coIleCheckpoint = coIle; }
+    // Następne solve() kontynuuje przebieg z checkpointu (dalej identycznie jak bez przerwy)
+    void wznowZ(const std::string& sciezka) { plikWznowienia = sciezka; }
+    void ustawZiarno(unsigned ziarno) { gen.seed(ziarno); }
+
+    // Podany genotyp (np. z archiwum) zastępuje pierwszego losowego osobnika; pusty = sama losowa populacja
+    void ustawGenotypStartowy(const std::vector<int>& g) { genotypStartowy = g; }
+    // Część początkowej populacji z reguł priorytetowych (DispatchingRules), reszta losowa; 0 = bez reguł
+    void ustawPopulacjeZRegul(double czesc) { czescZRegul = czesc; }
+
+    // Ślad populacji (PopulationTrace): co `coIle` pokoleń, `najlepszych` osobników (0 = cała populacja);
+    // pusta ścieżka = bez śladu. Domyślnie ewolucyjny.trc, każde pokolenie w całości.
+    void ustawSladPopulacji(const std::string& sciezka, int coIle = 1, int najlepszych = 0)
+    { plikSladu = sciezka; coIleSlad = coIle; najlepszychSlad = najlepszych; }
+
+    // Tryb memetyczny: część potomstwa przechodzi LocalSearch (równolegle) przed wejściem do populacji
+    void ustawMemetyczny(const UstawieniaMemetyczne& u) { memetyczne = u; }
+
+    // Stan ustalony (jak w EvolutionarySolver): `potomkow` dzieci na krok zastępuje w miejscu ofiarę,
+    // jeśli nie jest od niej gorsze. Pokolenie = rozmiar populacji potomków; 0 = pokolenia generacyjne.
+    void ustawStanUstalony(int potomkow = 2, Zastepowanie z = Zastepowanie::Najgorszy)
+    { stanUstalony = potomkow > 0; potomkowNaKrok = potomkow; zastepowanie = z; }
+
+    int getMakespan() const { return najlepszyMakespan; }
+    const std::vector<OperationSchedule>& getSchedule() const { return najlepszyHarmonogram; }
+
     struct Individual {
-        std::vector<int> priorytety;
-        int fitness; // ujednolicone z cpp
+        std::vector<int> priorytety; // genotyp w wybranym kodowaniu
+        int fitness = 0; // ujednolicone z cpp
+        uint32_t podpis = 0; // podpis harmonogramu (tylko z cache albo przy odrzucaniu duplikatów)
     };
 
 private:
@@ -26,16 +75,45 @@ private:
     int liczbaMaszyn;
 
     int najlepszyMakespan;
+    TrybDekodera trybDekodera;
+    Kodowanie kodowanie;
+    int cel;
+    EvaluationCache* cache;
+    bool odrzucajDuplikaty;
 
     std::vector<Individual> populacja;
     std::vector<OperationSchedule> najlepszyHarmonogram;
+    std::vector<int> najlepszyGenotyp;
+    std::vector<int> genotypStartowy;
+    double czescZRegul;
+    UstawieniaMemetyczne memetyczne;
+    bool stanUstalony;
+    int potomkowNaKrok;
+    Zastepowanie zastepowanie;
+
+    std::mt19937 gen;
+    std::string plikCheckpointu;
+    int coIleCheckpoint;
+    std::string plikWznowienia;
+    std::string plikSladu;
+    int coIleSlad;
+    int najlepszychSlad;
 
-    Individual stworzLosowyOsobnik(int liczbaOperacji);
+    Individual stworzLosowyOsobnik(const std::vector<int>& bazowy);
     void mutacjaSwap(Individual& individual);
 std::pair<Individual, Individual> krzyzowanieOX(const Individual& p1, const Individual& p2, std::mt19937& gen);
-    int ocenOsobnik(Individual& individual, const std::vector<OperationSchedule>& operacje);
-Individual turniej(const std::vector<Individual>& populacja, int tourSize, std::mt19937& gen);
-    std::vector<OperationSchedule> budujHarmonogram(const Individual& individual, const std::vector<OperationSchedule>& operacje);
+    // prog: ocena odcięta po osiągnięciu progu (ScheduleDecoder::dekodujDo), podpis wtedy 0
+    int ocenOsobnik(Individual& individual, ScheduleDecoder& dekoder, int prog = ScheduleDecoder::ODCIETY);
+    int turniej(const std::vector<Individual>& populacja, int tourSize, std::mt19937& gen); // indeks zwycięzcy
+    std::vector<OperationSchedule> budujHarmonogram(const Individual& individual, ScheduleDecoder& dekoder);
+
+    void pokolenieGeneracyjne(MemeticImprover* memetyka, ScheduleDecoder& dekoder);
+    void pokolenieUstalone(KopiecIndeksowany& najgorsi, std::unordered_map<uint32_t, int>& podpisy,
+                           std::vector<Individual>& potomstwo, MemeticImprover* memetyka, ScheduleDecoder& dekoder);
+    void poprawPotomstwo(std::vector<Individual>& potomstwo, MemeticImprover& memetyka, ScheduleDecoder& dekoder);
+    void zapiszSlad(int pokolenie, PopulationTrace& slad) const;
+    void zapiszCheckpoint(int epoka, uint64_t sumaInstancji, CheckpointWriter& zapis) const;
+    bool wczytajCheckpoint(uint64_t sumaInstancji, int& epoka);
 };
 
 #endif // EVOLUTIONSOLVER_H
@@ -1,25 +1,35 @@
 #include "EvolutionarySolver.h"
+#include "Checkpoint.h"
+#include "Metrics.h"
+#include "Log.h"
+#include "SolverEvents.h"
+#include "ResultWriter.h"
+#include "DispatchingRules.h"
+#include "IndexedHeap.h"
 #include <algorithm>
 #include <random>
 #include <iostream>
-#include <map>
 #include <fstream>
-#include <queue>      
-#include <stdexcept> 
+#include <unordered_set>
+#include <limits>
+#include <memory>
 
 
 EvolutionarySolver::EvolutionarySolver(int populacja, int pokolen, double pKrzyzowania, double pMutacji)
-    : rozmiarPopulacji(populacja), liczbaPokolen(pokolen), prawdopKrzyzowania(pKrzyzowania), prawdopMutacji(pMutacji)
+    : rozmiarPopulacji(populacja), liczbaPokolen(pokolen), prawdopKrzyzowania(pKrzyzowania), prawdopMutacji(pMutacji),
+      trybDekodera(TrybDekodera::Polaktywny), kodowanie(Kodowanie::Priorytety), cel(0),
+      cache(nullptr), odrzucajDuplikaty(false), czescZRegul(0.0), stanUstalony(false), potomkowNaKrok(2),
+      zastepowanie(Zastepowanie::Najgorszy), gen(std::random_device{}()), coIleCheckpoint(0)
 {}
 
-EvolutionarySolver::Individual EvolutionarySolver::turniej(const std::vector<Individual>& populacja) {
-    std::mt19937 gen(std::random_device{}());
+int EvolutionarySolver::turniej(const std::vector<Individual>& populacja) {
+    METRYKA_FAZA(Selekcja);
     std::uniform_int_distribution<> dist(0, populacja.size() - 1);
 
     int a = dist(gen);
     int b = dist(gen);
 
-    return (populacja[a].fitness < populacja[b].fitness) ? populacja[a] : populacja[b];
+    return (populacja[a].fitness < populacja[b].fitness) ? a : b;
 }
 
 void EvolutionarySolver::krzyzowanieOX(const std::vector<int>& rodzic1,
@@ -27,15 +37,14 @@ void EvolutionarySolver::krzyzowanieOX(const std::vector<int>& rodzic1,
                                        std::vector<int>& potomek1,
                                        std::vector<int>& potomek2) {
     int size = rodzic1.size();
-    std::mt19937 gen(std::random_device{}());
     std::uniform_int_distribution<> dist(0, size - 1);
 
     int start = dist(gen);
     int end = dist(gen);
     if (start > end) std::swap(start, end);
 
-    potomek1 = std::vector<int>(size, -1);
-    potomek2 = std::vector<int>(size, -1);
+    potomek1.assign(size, -1);
+    potomek2.assign(size, -1);
 
     // Kopiujemy segment
     for (int i = start; i <= end; ++i) {
@@ -65,7 +74,6 @@ void EvolutionarySolver::krzyzowanieOX(const std::vector<int>& rodzic1,
 }
 
 void EvolutionarySolver::mutacja(std::vector<int>& genotyp) {
-    std::mt19937 gen(std::random_device{}());
     std::uniform_int_distribution<> dist(0, genotyp.size() - 1);
 
     int a = dist(gen);
@@ -80,62 +88,105 @@ void EvolutionarySolver::solve(const std::vector<OperationSchedule>& operacje, i
     liczbaMaszyn = lMaszyn;
     operacjeRef = operacje;
 
-    std::mt19937 gen(std::random_device{}());
-    int liczbaOperacji = operacje.size();
+    ScheduleDecoder dekoder(operacje, liczbaJobow, liczbaMaszyn, trybDekodera, kodowanie);
+    dekoder.ustawCache(cache);
+    dekoder.ustawLiczeniePodpisu(odrzucajDuplikaty);
+    std::vector<int> bazowy = genotypBazowy(operacje, kodowanie);
 
     // === Inicjalizacja populacji ===
     std::vector<Individual> populacja;
+    int pok = 0;
 
-    for (int i = 0; i < rozmiarPopulacji; ++i)
+    uint64_t sumaInstancji = sumaKontrolnaInstancji(operacje, liczbaJobow, liczbaMaszyn);
+    if (plikWznowienia.empty() || !wczytajCheckpoint(sumaInstancji, populacja, pok))
     {
-        std::vector<int> genotyp(liczbaOperacji);
-        for (int j = 0; j < liczbaOperacji; ++j)
-            genotyp[j] = j;
+        std::vector<std::vector<int>> zRegul;
+        std::vector<int> makespanyRegul;
+        int ileZRegul = std::min(rozmiarPopulacji, (int)(czescZRegul * rozmiarPopulacji));
+        if (ileZRegul > 0)
+            DispatchingRules(operacje, liczbaJobow, liczbaMaszyn).generuj(ileZRegul, kodowanie, gen, zRegul, makespanyRegul);
 
-        std::shuffle(genotyp.begin(), genotyp.end(), gen);
+        for (int i = 0; i < rozmiarPopulacji; ++i)
+        {
+            std::vector<int> genotyp;
+            if (i < ileZRegul)
+            {
+                genotyp.swap(zRegul[i]);
+            }
+            else
+            {
+                genotyp = bazowy;
+                std::shuffle(genotyp.begin(), genotyp.end(), gen);
+            }
+            if (i == 0 && genotypStartowy.size() == bazowy.size())
+                genotyp = genotypStartowy;
 
-        Individual chromo = dekoduj(genotyp, operacje, liczbaJobow, liczbaMaszyn);
-        populacja.push_back(chromo);
+            Individual chromo = dekoduj(genotyp, dekoder);
+            populacja.push_back(chromo);
+        }
     }
 
-    // === Ewolucja ===
-    for (int pok = 0; pok < liczbaPokolen; ++pok)
-    {
-        std::vector<Individual> nowaPopulacja;
-
-        while (nowaPopulacja.size() < rozmiarPopulacji)
-        {
-            Individual rodzic1 = turniej(populacja);
-            Individual rodzic2 = turniej(populacja);
+    std::unique_ptr<CheckpointWriter> zapis;
+    if (!plikCheckpointu.empty())
+        zapis.reset(new CheckpointWriter(plikCheckpointu));
 
-            std::vector<int> potomek1 = rodzic1.genotyp;
-            std::vector<int> potomek2 = rodzic2.genotyp;
+    std::unique_ptr<MemeticImprover> memetyka;
+    if (memetyczne.tryb != TrybMemetyczny::Brak)
+        memetyka.reset(new MemeticImprover(operacje, liczbaJobow, liczbaMaszyn, trybDekodera, kodowanie, memetyczne));
 
-            double losKrzyz = (double)rand() / RAND_MAX;
-            if (losKrzyz < prawdopKrzyzowania)
-            {
-                krzyzowanieOX(rodzic1.genotyp, rodzic2.genotyp, potomek1, potomek2);
-            }
+    // Wznowienie przebiegu, który już osiągnął cel, nie może wykonać dodatkowego pokolenia
+    bool celOsiagniety = false;
+    int najlepszyFitness = std::numeric_limits<int>::max();
+    for (int i = 0; i < (int)populacja.size(); ++i)
+    {
+        if (populacja[i].fitness <= cel) celOsiagniety = true;
+        najlepszyFitness = std::min(najlepszyFitness, populacja[i].fitness);
+    }
 
-            double losMut1 = (double)rand() / RAND_MAX;
-            if (losMut1 < prawdopMutacji)
-                mutacja(potomek1);
+    // Stan ustalony: kopiec najgorszych i liczniki podpisów odtwarzane z populacji (także po wznowieniu)
+    KopiecIndeksowany najgorsi;
+    std::unordered_map<uint32_t, int> podpisy;
+    std::vector<Individual> potomstwo;
+    if (stanUstalony)
+    {
+        std::vector<int> fitness(populacja.size());
+        for (int i = 0; i < (int)populacja.size(); ++i)
+        {
+            fitness[i] = populacja[i].fitness;
+            if (odrzucajDuplikaty)
+                ++podpisy[populacja[i].podpis];
+        }
+        najgorsi.zbuduj(fitness);
+    }
 
-            double losMut2 = (double)rand() / RAND_MAX;
-            if (losMut2 < prawdopMutacji)
-                mutacja(potomek2);
+    // === Ewolucja ===
+    while (pok < liczbaPokolen && !celOsiagniety)
+    {
+        if (stanUstalony)
+            celOsiagniety = pokolenieUstalone(populacja, najgorsi, podpisy, potomstwo, memetyka.get(), dekoder, pok, najlepszyFitness);
+        else
+            celOsiagniety = pokolenieGeneracyjne(populacja, memetyka.get(), dekoder, pok, najlepszyFitness);
 
-            nowaPopulacja.push_back(dekoduj(potomek1, operacje, liczbaJobow, liczbaMaszyn));
-            if (nowaPopulacja.size() < rozmiarPopulacji)
-                nowaPopulacja.push_back(dekoduj(potomek2, operacje, liczbaJobow, liczbaMaszyn));
+        ++pok;
+        if (zapis && ((coIleCheckpoint > 0 && pok % coIleCheckpoint == 0) || czyZadanoCheckpointu()))
+        {
+            METRYKA_FAZA(Logowanie);
+            zapiszCheckpoint(populacja, pok, sumaInstancji, *zapis);
+            potwierdzCheckpoint();
         }
-
-        populacja = nowaPopulacja;
+        if (czyZadanoZatrzymania())
+            break;
     }
 
+    // Zatrzymany przebieg zostawia stan do wznowienia; zakończony usuwa checkpoint
+    if (zapis && czyZadanoZatrzymania())
+        zapiszCheckpoint(populacja, pok, sumaInstancji, *zapis);
+    else if (zapis)
+        zapis->porzuc();
+
     // === Najlepszy osobnik ===
     Individual best = populacja[0];
-    for (int i = 1; i < populacja.size(); ++i)
+    for (int i = 1; i < (int)populacja.size(); ++i)
     {
         if (populacja[i].fitness < best.fitness)
         {
@@ -143,112 +194,290 @@ void EvolutionarySolver::solve(const std::vector<OperationSchedule>& operacje, i
         }
     }
 
+    // U Baldwina koszt osobnika należy do jego poprawionej wersji
+    if (memetyka && memetyczne.tryb == TrybMemetyczny::Baldwin)
+        memetyka->popraw(best.genotyp);
     makespan = best.fitness;
-    schedule = best.harmonogram;
+    dekoder.dekoduj(best.genotyp, &schedule);
 }
 
-// w tym miejscu kopiujemy pełny harmonogram, a nie tylko goły genotyp
-EvolutionarySolver::Individual EvolutionarySolver::dekoduj(
-    const std::vector<int>& genotyp,
-    const std::vector<OperationSchedule>& operacje,
-    int liczbaJobow,
-    int liczbaMaszyn
-)
+bool EvolutionarySolver::pokolenieGeneracyjne(std::vector<Individual>& populacja, MemeticImprover* memetyka,
+                                              ScheduleDecoder& dekoder, int pok, int& najlepszyFitness)
 {
-    EvolutionarySolver::Individual osobnik;
-    osobnik.genotyp = genotyp;
-
-    // Ustaw priorytety operacjom według genotypu
-    std::vector<OperationSchedule> operacjeZPriorytetami = operacje;
-    for (int i = 0; i < genotyp.size(); ++i)
+    std::uniform_real_distribution<double> los(0.0, 1.0);
+    METRYKA_FAZA(Sasiedztwo);
+    std::vector<Individual> nowaPopulacja;
+    std::unordered_set<uint32_t> podpisy;
+    int odrzucone = 0;
+    const int limitOdrzucen = 10 * rozmiarPopulacji; // zbiegnięta populacja nie może zablokować pętli
+
+    while ((int)nowaPopulacja.size() < rozmiarPopulacji)
     {
-        operacjeZPriorytetami[i].priority = genotyp[i];
-    }
+        const Individual& rodzic1 = populacja[turniej(populacja)];
+        const Individual& rodzic2 = populacja[turniej(populacja)];
 
-    // Sortujemy operacje rosnąco po priorytecie
-    for (int i = 0; i < operacjeZPriorytetami.size() - 1; ++i)
-    {
-        for (int j = 0; j < operacjeZPriorytetami.size() - i - 1; ++j)
+        std::vector<int> potomek1 = rodzic1.genotyp;
+        std::vector<int> potomek2 = rodzic2.genotyp;
+
+        double losKrzyz = los(gen);
+        if (losKrzyz < prawdopKrzyzowania)
+        {
+            if (kodowanie == Kodowanie::PowtorzeniaJobow)
+                krzyzowanieJOX(rodzic1.genotyp, rodzic2.genotyp, potomek1, potomek2, liczbaJobow, gen);
+            else
+                krzyzowanieOX(rodzic1.genotyp, rodzic2.genotyp, potomek1, potomek2);
+        }
+
+        double losMut1 = los(gen);
+        if (losMut1 < prawdopMutacji)
+            mutacja(potomek1);
+
+        double losMut2 = los(gen);
+        if (losMut2 < prawdopMutacji)
+            mutacja(potomek2);
+
+        Individual dziecko1 = dekoduj(potomek1, dekoder);
+        if (odrzucajDuplikaty && odrzucone < limitOdrzucen && !podpisy.insert(dziecko1.podpis).second)
+            ++odrzucone;
+        else
         {
-            if (operacjeZPriorytetami[j].priority > operacjeZPriorytetami[j + 1].priority)
+            nowaPopulacja.push_back(dziecko1);
+            METRYKA_DODAJ(ZaakceptowaneRuchy, 1);
+        }
+
+        if ((int)nowaPopulacja.size() < rozmiarPopulacji)
+        {
+            Individual dziecko2 = dekoduj(potomek2, dekoder);
+            if (odrzucajDuplikaty && odrzucone < limitOdrzucen && !podpisy.insert(dziecko2.podpis).second)
+                ++odrzucone;
+            else
             {
-                OperationSchedule temp = operacjeZPriorytetami[j];
-                operacjeZPriorytetami[j] = operacjeZPriorytetami[j + 1];
-                operacjeZPriorytetami[j + 1] = temp;
+                nowaPopulacja.push_back(dziecko2);
+                METRYKA_DODAJ(ZaakceptowaneRuchy, 1);
             }
         }
     }
 
-    // Przygotowanie struktur pomocniczych
-    std::vector<OperationSchedule> harmonogram;
-    std::map<int, int> dostepMaszyny;
-    std::map<int, int> dostepJoba;
-    std::map<std::pair<int, int>, bool> wykonane;
+    if (memetyka)
+        poprawPotomstwo(nowaPopulacja, *memetyka, dekoder);
 
-    int wykonanych = 0;
-    while (wykonanych < operacjeZPriorytetami.size())
-    {
-        bool cosDodano = false;
+    populacja.swap(nowaPopulacja);
 
-        for (int i = 0; i < operacjeZPriorytetami.size(); ++i)
+    // Osiągnięto cel (np. znane optimum) – kończymy ewolucję
+    bool celOsiagniety = false;
+    for (int i = 0; i < (int)populacja.size(); ++i)
+    {
+        if (populacja[i].fitness <= cel) celOsiagniety = true;
+        if (populacja[i].fitness < najlepszyFitness)
         {
-            OperationSchedule& op = operacjeZPriorytetami[i];
-            std::pair<int, int> klucz = std::make_pair(op.job_id, op.operation_id);
+            najlepszyFitness = populacja[i].fitness;
+            METRYKA_DODAJ(Poprawy, 1);
+            zglosPoprawe(najlepszyFitness);
+            LOG_DEBUG(EA, "Pokolenie " << pok + 1 << ": nowy najlepszy makespan = " << najlepszyFitness);
+        }
+    }
+    return celOsiagniety;
+}
 
-            if (wykonane[klucz]) continue;
+bool EvolutionarySolver::pokolenieUstalone(std::vector<Individual>& populacja, KopiecIndeksowany& najgorsi,
+                                           std::unordered_map<uint32_t, int>& podpisy, std::vector<Individual>& potomstwo,
+                                           MemeticImprover* memetyka, ScheduleDecoder& dekoder, int pok, int& najlepszyFitness)
+{
+    METRYKA_FAZA(Sasiedztwo);
+    std::uniform_real_distribution<double> los(0.0, 1.0);
+    const int kroki = (rozmiarPopulacji + potomkowNaKrok - 1) / potomkowNaKrok;
+    potomstwo.resize(potomkowNaKrok); // bufory genotypów krążą między potomstwem a populacją, bez alokacji
+    std::vector<int> zapas;           // drugi potomek ostatniej pary przy nieparzystej liczbie
+
+    for (int krok = 0; krok < kroki; ++krok)
+    {
+        int r1 = turniej(populacja);
+        int r2 = turniej(populacja);
 
-            bool moznaWykonac = false;
-            if (op.operation_id == 0)
+        for (int k = 0; k < potomkowNaKrok; k += 2)
+        {
+            std::vector<int>& potomek1 = potomstwo[k].genotyp;
+            std::vector<int>& potomek2 = k + 1 < potomkowNaKrok ? potomstwo[k + 1].genotyp : zapas;
+            potomek1 = populacja[r1].genotyp;
+            potomek2 = populacja[r2].genotyp;
+
+            if (los(gen) < prawdopKrzyzowania)
             {
-                moznaWykonac = true;
+                if (kodowanie == Kodowanie::PowtorzeniaJobow)
+                    krzyzowanieJOX(populacja[r1].genotyp, populacja[r2].genotyp, potomek1, potomek2, liczbaJobow, gen);
+                else
+                    krzyzowanieOX(populacja[r1].genotyp, populacja[r2].genotyp, potomek1, potomek2);
             }
-            else
+            if (los(gen) < prawdopMutacji)
+                mutacja(potomek1);
+            if (los(gen) < prawdopMutacji)
+                mutacja(potomek2);
+        }
+
+        // Memetyka potrzebuje dokładnych kosztów; bez niej potomek jest oceniany z progiem ofiary
+        if (memetyka)
+        {
+            for (Individual& dziecko : potomstwo)
+                dziecko.fitness = ocenDo(dziecko.genotyp, dekoder, ScheduleDecoder::ODCIETY, dziecko.podpis);
+            poprawPotomstwo(potomstwo, *memetyka, dekoder);
+        }
+
+        for (Individual& dziecko : potomstwo)
+        {
+            int ofiara = najgorsi.szczyt();
+            if (zastepowanie == Zastepowanie::PodobnyRodzic)
+                ofiara = odlegloscHamminga(dziecko.genotyp, populacja[r1].genotyp)
+                      <= odlegloscHamminga(dziecko.genotyp, populacja[r2].genotyp) ? r1 : r2;
+
+            // Remis też wchodzi (dryf po plateau); gorszy potomek nigdy – najlepszy osobnik nie ginie
+            const int prog = populacja[ofiara].fitness + 1;
+            if (!memetyka)
+                dziecko.fitness = ocenDo(dziecko.genotyp, dekoder, prog, dziecko.podpis);
+            if (dziecko.fitness >= prog)
+                continue;
+            if (odrzucajDuplikaty && podpisy.count(dziecko.podpis))
+                continue;
+
+            if (odrzucajDuplikaty)
             {
-                std::pair<int, int> poprzednia = std::make_pair(op.job_id, op.operation_id - 1);
-                if (wykonane[poprzednia]) moznaWykonac = true;
+                if (--podpisy[populacja[ofiara].podpis] == 0)
+                    podpisy.erase(populacja[ofiara].podpis);
+                ++podpisy[dziecko.podpis];
             }
+            populacja[ofiara].genotyp.swap(dziecko.genotyp);
+            populacja[ofiara].fitness = dziecko.fitness;
+            populacja[ofiara].podpis = dziecko.podpis;
+            najgorsi.zmien(ofiara, dziecko.fitness);
+            METRYKA_DODAJ(ZaakceptowaneRuchy, 1);
 
-            if (moznaWykonac)
+            if (dziecko.fitness < najlepszyFitness)
             {
-                int czasStart = (dostepMaszyny[op.machine_id] > dostepJoba[op.job_id])
-                              ? dostepMaszyny[op.machine_id]
-                              : dostepJoba[op.job_id];
-
-                op.start_time = czasStart;
-                op.end_time = czasStart + op.processing_time;
-
-                dostepMaszyny[op.machine_id] = op.end_time;
-                dostepJoba[op.job_id] = op.end_time;
-                wykonane[klucz] = true;
-
-                harmonogram.push_back(op);
-                wykonanych++;
-                cosDodano = true;
+                najlepszyFitness = dziecko.fitness;
+                METRYKA_DODAJ(Poprawy, 1);
+                zglosPoprawe(najlepszyFitness);
+                LOG_DEBUG(EA, "Pokolenie " << pok + 1 << ", krok " << krok + 1 << ": nowy najlepszy makespan = " << najlepszyFitness);
             }
+            if (dziecko.fitness <= cel)
+                return true;
         }
+    }
+    return false;
+}
 
-        if (!cosDodano)
-        {
-            throw std::runtime_error("Błąd: Nie można zbudować poprawnego harmonogramu na podstawie priorytetów.");
-        }
+void EvolutionarySolver::poprawPotomstwo(std::vector<Individual>& potomstwo, MemeticImprover& memetyka, ScheduleDecoder& dekoder)
+{
+    std::uniform_real_distribution<double> los(0.0, 1.0);
+    std::vector<Individual*> wybrani;
+    std::vector<std::vector<int>*> genotypy;
+    for (Individual& osobnik : potomstwo)
+    {
+        if (memetyczne.czescPotomstwa < 1.0 && los(gen) >= memetyczne.czescPotomstwa)
+            continue;
+        wybrani.push_back(&osobnik);
+        genotypy.push_back(&osobnik.genotyp);
     }
 
-    // Liczymy makespan
-    int maksCzas = 0;
-    for (int i = 0; i < harmonogram.size(); ++i)
+    std::vector<int> fitness;
+    memetyka.popraw(genotypy, fitness);
+
+    for (size_t k = 0; k < wybrani.size(); ++k)
     {
-        if (harmonogram[i].end_time > maksCzas)
-        {
-            maksCzas = harmonogram[i].end_time;
-        }
+        // Podpis (cache, duplikaty) musi odpowiadać nowemu genotypowi
+        if (memetyczne.tryb == TrybMemetyczny::Lamarck && (cache != nullptr || odrzucajDuplikaty))
+            *wybrani[k] = dekoduj(wybrani[k]->genotyp, dekoder);
+        else
+            wybrani[k]->fitness = fitness[k];
     }
+}
 
-    osobnik.fitness = maksCzas;
-    osobnik.harmonogram = harmonogram;
+EvolutionarySolver::Individual EvolutionarySolver::dekoduj(const std::vector<int>& genotyp, ScheduleDecoder& dekoder)
+{
+    EvolutionarySolver::Individual osobnik;
+    osobnik.genotyp = genotyp;
+    osobnik.podpis = 0;
+    if (cache == nullptr && !odrzucajDuplikaty)
+    {
+        osobnik.fitness = dekoder.dekoduj(genotyp);
+    }
+    else
+    {
+        osobnik.fitness = dekoder.ocen(genotyp);
+        osobnik.podpis = dekoder.getPodpis();
+    }
     return osobnik;
 }
 
+int EvolutionarySolver::ocenDo(const std::vector<int>& genotyp, ScheduleDecoder& dekoder, int prog, uint32_t& podpis)
+{
+    podpis = 0;
+    if (cache == nullptr && !odrzucajDuplikaty)
+        return dekoder.dekodujDo(genotyp, prog);
+
+    int wynik = dekoder.ocenDo(genotyp, EvaluationCache::hashGenotypu(genotyp), prog);
+    if (wynik != ScheduleDecoder::ODCIETY)
+        podpis = dekoder.getPodpis();
+    return wynik;
+}
+
+
+void EvolutionarySolver::zapiszCheckpoint(const std::vector<Individual>& populacja, int pokolenie, uint64_t sumaInstancji, CheckpointWriter& zapis) const
+{
+    BuforZapisu b;
+    b.piszNaglowek("ewolucyjny", sumaInstancji, trybDekodera, kodowanie);
+    b.piszGenerator(gen);
+    b.piszInt(pokolenie);
+    b.piszInt(populacja.size());
+    for (int i = 0; i < (int)populacja.size(); ++i)
+    {
+        b.piszWektor(populacja[i].genotyp);
+        b.piszInt(populacja[i].fitness);
+        b.piszU64(populacja[i].podpis);
+    }
+    b.zakoncz();
+
+    zapis.zlec(b.getDane());
+}
+
+bool EvolutionarySolver::wczytajCheckpoint(uint64_t sumaInstancji, std::vector<Individual>& populacja, int& pokolenie)
+{
+    std::vector<char> dane;
+    if (!wczytajPlikBinarny(plikWznowienia, dane))
+    {
+        LOG_OSTRZEZENIE(EA, "Brak checkpointu " << plikWznowienia << " – start od nowa");
+        return false;
+    }
 
+    BuforOdczytu b(dane);
+    if (!b.czytajNaglowek("ewolucyjny", sumaInstancji, trybDekodera, kodowanie))
+        return false;
+
+    std::mt19937 g;
+    b.czytajGenerator(g);
+    int pok = b.czytajInt();
+    int rozmiar = b.czytajInt();
+
+    std::vector<Individual> wczytana;
+    for (int i = 0; i < rozmiar && b.ok(); ++i)
+    {
+        Individual osobnik;
+        b.czytajWektor(osobnik.genotyp);
+        osobnik.fitness = b.czytajInt();
+        osobnik.podpis = static_cast<uint32_t>(b.czytajU64());
+        wczytana.push_back(osobnik);
+    }
+
+    if (!b.ok() || wczytana.empty())
+    {
+        LOG_OSTRZEZENIE(EA, "Niepelny checkpoint " << plikWznowienia);
+        return false;
+    }
+
+    gen = g;
+    populacja = wczytana;
+    pokolenie = pok;
+    LOG_INFO(EA, "Wznowiono z " << plikWznowienia << " od pokolenia " << pokolenie);
+    return true;
+}
 
 void EvolutionarySolver::printSchedule() const {
     std::cout << "\n=== Najlepszy harmonogram (EvolutionarySolver) ===\n";
@@ -267,31 +496,15 @@ void EvolutionarySolver::printSchedule() const {
 
 void EvolutionarySolver::zapiszDoCSV(const std::string& nazwaPliku) const
 {
-    // Tworzymy obiekt plikowy do zapisu
-    std::ofstream out(nazwaPliku);
-
-    // Sprawdzamy, czy plik otworzył się poprawnie
-    if (!out.is_open()) {
-        std::cerr << "Nie można otworzyć pliku do zapisu: " << nazwaPliku << "\n";
-        return; // kończymy funkcję, jeśli nie udało się otworzyć pliku
-    }
-
-    // Nagłówek pliku CSV
-    out << "job_id,operation_id,machine_id,start_time,end_time\n";
-
-    // Iterujemy po wszystkich operacjach i zapisujemy ich dane do pliku
-    for (int i = 0; i < schedule.size(); ++i)
+    TekstCSV t(',');
+    t.zarezerwuj(schedule.size() * 24);
+    t.tekst() = "job_id,operation_id,machine_id,start_time,end_time\n";
+    for (const OperationSchedule& op : schedule)
     {
-        const OperationSchedule& op = schedule[i];
-
-        // Wypisujemy dane w formacie CSV (czyli oddzielone przecinkami)
-        out << op.job_id << ","
-            << op.operation_id << ","
-            << op.machine_id << ","
-            << op.start_time << ","
-            << op.end_time << "\n";
+        t.pole(op.job_id).pole(op.operation_id).pole(op.machine_id).pole(op.start_time).pole(op.end_time);
+        t.koniecWiersza();
     }
 
-    // Plik zostanie zamknięty automatycznie po zakończeniu funkcji (RAII)
+    ResultWriter::instancja().zapisz(nazwaPliku, t.tekst());
 }
 
@@ -2,8 +2,22 @@
 #define EVOLUTIONARY_SOLVER_H
 
 #include "OperationSchedule.h"
+#include "ScheduleDecoder.h"
+#include "LocalSearch.h"
 #include <vector>
 #include <string>
+#include <random>
+#include <unordered_map>
+
+class CheckpointWriter;
+class KopiecIndeksowany;
+
+// Kogo potomek wypiera w trybie stanu ustalonego
+enum class Zastepowanie
+{
+    Najgorszy,     // najgorszego osobnika populacji (kopiec indeksowany)
+    PodobnyRodzic  // bliższego (odległość Hamminga) z dwóch rodziców – zachowuje różnorodność
+};
 
 class EvolutionarySolver {
 public:
@@ -13,20 +27,53 @@ public:
     void printSchedule() const;
     void zapiszDoCSV(const std::string& nazwaPliku) const;
 
+    // Wybór dekodera i kodowania genotypu (domyślnie półaktywny, priorytetowy)
+    void ustawTrybDekodera(TrybDekodera tryb) { trybDekodera = tryb; }
+    void ustawKodowanie(Kodowanie k) { kodowanie = k; }
+
+    // Zatrzymanie po osiągnięciu celu (np. znanego optimum)
+    void ustawCel(int cel) { this->cel = cel; }
+
+    // Wspólna pamięć podręczna ocen (jedna na instancję i tryb dekodera); nullptr = bez cache
+    void ustawCache(EvaluationCache* c) { cache = c; }
+    // Potomek dający harmonogram już obecny w nowej populacji jest odrzucany
+    void ustawOdrzucanieDuplikatow(bool odrzucaj) { odrzucajDuplikaty = odrzucaj; }
+
+    // Checkpoint co `coIle` pokoleń, na sygnał i przy zatrzymaniu (zakończony przebieg usuwa plik); pusta ścieżka = wyłączone
+    void ustawCheckpoint(const std::string& sciezka, int coIle) { plikCheckpointu = sciezka; coIleCheckpoint = coIle; }
+    // Następne solve() kontynuuje przebieg z checkpointu (dalej identycznie jak bez przerwy)
+    void wznowZ(const std::string& sciezka) { plikWznowienia = sciezka; }
+    void ustawZiarno(unsigned ziarno) { gen.seed(ziarno); }
+
+    // Podany genotyp (np. z archiwum) zastępuje pierwszego losowego osobnika; pusty = sama losowa populacja
+    void ustawGenotypStartowy(const std::vector<int>& g) { genotypStartowy = g; }
+    // Część początkowej populacji z reguł priorytetowych (DispatchingRules), reszta losowa; 0 = bez reguł
+    void ustawPopulacjeZRegul(double czesc) { czescZRegul = czesc; }
+
+    // Tryb memetyczny: część potomstwa przechodzi LocalSearch (równolegle) przed wejściem do populacji
+    void ustawMemetyczny(const UstawieniaMemetyczne& u) { memetyczne = u; }
+
+    // Stan ustalony: zamiast całych pokoleń `potomkow` dzieci na krok, każde zastępuje w miejscu ofiarę
+    // tylko wtedy, gdy nie jest od niej gorsze (elitaryzm). Pokolenie = rozmiar populacji potomków.
+    void ustawStanUstalony(int potomkow = 2, Zastepowanie z = Zastepowanie::Najgorszy)
+    { stanUstalony = potomkow > 0; potomkowNaKrok = potomkow; zastepowanie = z; }
+
+    int getMakespan() const { return makespan; }
+    const std::vector<OperationSchedule>& getSchedule() const { return schedule; }
+
 private:
     struct Individual 
     {
-        std::vector<int> genotyp; // lista indeksów operacji
+        std::vector<int> genotyp; // priorytety operacji albo ciąg jobów (zależnie od kodowania)
         int fitness;              // makespan
-        std::vector<OperationSchedule> harmonogram;
+        uint32_t podpis;          // podpis harmonogramu (tylko z cache albo przy odrzucaniu duplikatów)
     };
 
-      Individual dekoduj(const std::vector<int>& genotyp,
-                       const std::vector<OperationSchedule>& operacje,
-                       int liczbaJobow,
-                       int liczbaMaszyn);
+    // Harmonogram budujemy tylko dla najlepszego osobnika, reszta populacji trzyma sam koszt
+    Individual dekoduj(const std::vector<int>& genotyp, ScheduleDecoder& dekoder);
 
-    Individual turniej(const std::vector<Individual>& populacja);
+    // Indeks zwycięzcy – bez kopiowania genotypu
+    int turniej(const std::vector<Individual>& populacja);
 
     void krzyzowanieOX(const std::vector<int>& rodzic1,
                        const std::vector<int>& rodzic2,
@@ -35,6 +82,20 @@ private:
 
     void mutacja(std::vector<int>& genotyp);
 
+    void poprawPotomstwo(std::vector<Individual>& potomstwo, MemeticImprover& memetyka, ScheduleDecoder& dekoder);
+
+    // Ocena z progiem odcięcia (ScheduleDecoder::dekodujDo); podpis tylko z cache albo przy odrzucaniu duplikatów
+    int ocenDo(const std::vector<int>& genotyp, ScheduleDecoder& dekoder, int prog, uint32_t& podpis);
+    // Jedno pokolenie (pełna wymiana populacji albo stan ustalony); zwraca true po osiągnięciu celu
+    bool pokolenieGeneracyjne(std::vector<Individual>& populacja, MemeticImprover* memetyka,
+                              ScheduleDecoder& dekoder, int pok, int& najlepszyFitness);
+    bool pokolenieUstalone(std::vector<Individual>& populacja, KopiecIndeksowany& najgorsi,
+                           std::unordered_map<uint32_t, int>& podpisy, std::vector<Individual>& potomstwo,
+                           MemeticImprover* memetyka, ScheduleDecoder& dekoder, int pok, int& najlepszyFitness);
+
+    void zapiszCheckpoint(const std::vector<Individual>& populacja, int pokolenie, uint64_t sumaInstancji, CheckpointWriter& zapis) const;
+    bool wczytajCheckpoint(uint64_t sumaInstancji, std::vector<Individual>& populacja, int& pokolenie);
+
     std::vector<OperationSchedule> schedule;
     int makespan;
     int liczbaJobow;
@@ -45,6 +106,22 @@ private:
     int liczbaPokolen;
     double prawdopKrzyzowania;
     double prawdopMutacji;
+    TrybDekodera trybDekodera;
+    Kodowanie kodowanie;
+    int cel;
+    EvaluationCache* cache;
+    bool odrzucajDuplikaty;
+    std::vector<int> genotypStartowy;
+    double czescZRegul;
+    UstawieniaMemetyczne memetyczne;
+    bool stanUstalony;
+    int potomkowNaKrok;
+    Zastepowanie zastepowanie;
+
+    std::mt19937 gen;
+    std::string plikCheckpointu;
+    int coIleCheckpoint;
+    std::string plikWznowienia;
 };
 
 #endif
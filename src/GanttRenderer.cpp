@@ -0,0 +1,434 @@
+#include "GanttRenderer.h"
+#include "CriticalPath.h"
+#include "Log.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+
+// Paleta "tab20" z matplotlib – te same kolory jobów co w dotychczasowych skryptach
+static const char* PALETA[20] = {
+    "#1f77b4", "#aec7e8", "#ff7f0e", "#ffbb78", "#2ca02c", "#98df8a", "#d62728", "#ff9896", "#9467bd", "#c5b0d5",
+    "#8c564b", "#c49c94", "#e377c2", "#f7b6d2", "#7f7f7f", "#c7c7c7", "#bcbd22", "#dbdb8d", "#17becf", "#9edae5"
+};
+static const char* KOLOR_SKUPIENIA = "#9a9a9a";
+static const char* KOLOR_KRYTYCZNY = "#d62728";
+
+static const int MARGINES_LEWY = 90;
+static const int MARGINES_PRAWY = 20;
+static const int MARGINES_GORNY = 40;
+static const int MARGINES_DOLNY = 40;
+
+namespace
+{
+    // Tekst wstawiany do SVG (tytuł podaje użytkownik) – znaki specjalne XML jako encje
+    std::string tekstXML(const std::string& tekst)
+    {
+        std::string wynik;
+        wynik.reserve(tekst.size());
+        for (char c : tekst)
+        {
+            switch (c)
+            {
+            case '&': wynik += "&amp;"; break;
+            case '<': wynik += "&lt;"; break;
+            case '>': wynik += "&gt;"; break;
+            case '"': wynik += "&quot;"; break;
+            default: wynik += c;
+            }
+        }
+        return wynik;
+    }
+
+    // Wspólne położenie elementów dla SVG i PNG
+    struct Uklad
+    {
+        int liczbaMaszyn;
+        int makespan;
+        double skala; // px na jednostkę czasu
+        int wiersz;
+        int szerokosc;
+        int wysokosc;
+        std::vector<std::vector<int>> operacjeMaszyn; // posortowane po starcie
+
+        double x(int czas) const { return MARGINES_LEWY + czas * skala; }
+        int y(int maszyna) const { return MARGINES_GORNY + maszyna * wiersz; }
+    };
+
+    bool przygotujUklad(const std::vector<OperationSchedule>& harmonogram, const OpcjeWykresuGantta& opcje, Uklad& u)
+    {
+        if (harmonogram.empty())
+        {
+            LOG_OSTRZEZENIE(Wykresy, "Pusty harmonogram – brak wykresu");
+            return false;
+        }
+
+        u.liczbaMaszyn = 0;
+        u.makespan = 1;
+        for (const OperationSchedule& op : harmonogram)
+        {
+            u.liczbaMaszyn = std::max(u.liczbaMaszyn, op.machine_id + 1);
+            u.makespan = std::max(u.makespan, op.end_time);
+        }
+
+        u.wiersz = std::max(2, opcje.wysokoscWiersza);
+        u.szerokosc = std::max(opcje.szerokosc, MARGINES_LEWY + MARGINES_PRAWY + 100);
+        u.wysokosc = MARGINES_GORNY + u.liczbaMaszyn * u.wiersz + MARGINES_DOLNY;
+        u.skala = double(u.szerokosc - MARGINES_LEWY - MARGINES_PRAWY) / u.makespan;
+
+        u.operacjeMaszyn.assign(u.liczbaMaszyn, std::vector<int>());
+        for (int i = 0; i < (int)harmonogram.size(); ++i)
+            u.operacjeMaszyn[harmonogram[i].machine_id].push_back(i);
+        for (std::vector<int>& ops : u.operacjeMaszyn)
+        {
+            std::sort(ops.begin(), ops.end(), [&](int a, int b) { return harmonogram[a].start_time < harmonogram[b].start_time; });
+        }
+        return true;
+    }
+
+    // Krok osi czasu: 1, 2 albo 5 razy potęga 10, około 10 podziałek
+    int krokOsi(int makespan)
+    {
+        double surowy = makespan / 10.0;
+        double rzad = std::pow(10.0, std::floor(std::log10(std::max(1.0, surowy))));
+        for (double m : { 1.0, 2.0, 5.0, 10.0 })
+        {
+            if (m * rzad >= surowy)
+                return std::max(1, int(m * rzad));
+        }
+        return std::max(1, int(10 * rzad));
+    }
+
+    // Indeksy operacji harmonogramu na ścieżce krytycznej – harmonogram służy też za listę operacji
+    std::vector<int> sciezkaKrytyczna(const std::vector<OperationSchedule>& harmonogram, const Uklad& u)
+    {
+        int liczbaJobow = 0;
+        for (const OperationSchedule& op : harmonogram)
+            liczbaJobow = std::max(liczbaJobow, op.job_id + 1);
+        SciezkaKrytyczna sciezka(harmonogram, liczbaJobow, u.liczbaMaszyn, Kodowanie::Priorytety);
+        sciezka.wczytaj(harmonogram);
+        return sciezka.getSciezka();
+    }
+}
+
+// ===== SVG =====
+
+bool zapiszWykresGanttaSVG(const std::vector<OperationSchedule>& harmonogram, const std::string& nazwaPliku,
+                           const OpcjeWykresuGantta& opcje)
+{
+    Uklad u;
+    if (!przygotujUklad(harmonogram, opcje, u))
+        return false;
+
+    std::vector<char> bufor(1 << 20);
+    std::ofstream out;
+    out.rdbuf()->pubsetbuf(bufor.data(), bufor.size());
+    out.open(nazwaPliku);
+    if (!out.is_open())
+    {
+        LOG_BLAD(Wykresy, "Nie mozna otworzyc pliku do zapisu: " << nazwaPliku);
+        return false;
+    }
+
+    char liczba[64];
+    auto px = [&liczba](double v) -> const char* {
+        std::snprintf(liczba, sizeof(liczba), "%.1f", v);
+        return liczba;
+    };
+
+    out << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << u.szerokosc << "\" height=\"" << u.wysokosc
+        << "\" font-family=\"sans-serif\" font-size=\"10\">\n";
+    out << "<rect width=\"100%\" height=\"100%\" fill=\"white\"/>\n";
+    out << "<text x=\"" << u.szerokosc / 2 << "\" y=\"24\" text-anchor=\"middle\" font-size=\"14\">" << tekstXML(opcje.tytul)
+        << " (makespan " << u.makespan << ")</text>\n";
+
+    const int wysokoscPaska = std::max(1, u.wiersz - 4);
+    const bool etykietyMaszyn = u.wiersz >= 10;
+    for (int m = 0; m < u.liczbaMaszyn; ++m)
+    {
+        int y = u.y(m);
+        if (etykietyMaszyn)
+        {
+            out << "<text x=\"" << MARGINES_LEWY - 6 << "\" y=\"" << y + u.wiersz / 2 + 4 << "\" text-anchor=\"end\">Maszyna "
+                << m << "</text>\n";
+        }
+
+        // Sąsiednie operacje węższe niż próg łączymy w jeden blok
+        const std::vector<int>& ops = u.operacjeMaszyn[m];
+        double skupienieOd = -1.0, skupienieDo = -1.0;
+        int wSkupieniu = 0;
+        auto zamknijSkupienie = [&]() {
+            if (wSkupieniu == 0) return;
+            out << "<rect x=\"" << px(skupienieOd) << "\" y=\"" << y + 2;
+            out << "\" width=\"" << px(std::max(1.0, skupienieDo - skupienieOd)) << "\" height=\"" << wysokoscPaska
+                << "\" fill=\"" << KOLOR_SKUPIENIA << "\"><title>" << wSkupieniu << " operacji</title></rect>\n";
+            wSkupieniu = 0;
+        };
+
+        for (int i : ops)
+        {
+            const OperationSchedule& op = harmonogram[i];
+            double x0 = u.x(op.start_time);
+            double w = (op.end_time - op.start_time) * u.skala;
+
+            if (w < opcje.minSzerokoscPx)
+            {
+                if (wSkupieniu > 0 && x0 > skupienieDo + 1.0)
+                    zamknijSkupienie();
+                if (wSkupieniu == 0)
+                {
+                    skupienieOd = x0;
+                    skupienieDo = x0 + w;
+                }
+                else
+                {
+                    skupienieDo = std::max(skupienieDo, x0 + w);
+                }
+                ++wSkupieniu;
+                continue;
+            }
+            zamknijSkupienie();
+
+            out << "<rect x=\"" << px(x0) << "\" y=\"" << y + 2;
+            out << "\" width=\"" << px(w) << "\" height=\"" << wysokoscPaska << "\" fill=\"" << PALETA[op.job_id % 20]
+                << "\" stroke=\"black\" stroke-width=\"0.5\"><title>J" << op.job_id << ".O" << op.operation_id << " ["
+                << op.start_time << ", " << op.end_time << ")</title></rect>\n";
+
+            // ~6 px na znak przy font-size 10
+            if (opcje.etykiety && u.wiersz >= 12)
+            {
+                int dlugosc = 4 + (op.job_id >= 10) + (op.job_id >= 100) + (op.operation_id >= 10) + (op.operation_id >= 100);
+                if (w >= 6.0 * dlugosc + 2)
+                {
+                    out << "<text x=\"" << px(x0 + 2) << "\" y=\"" << y + u.wiersz / 2 + 4 << "\">J" << op.job_id << ".O"
+                        << op.operation_id << "</text>\n";
+                }
+            }
+        }
+        zamknijSkupienie();
+    }
+
+    // Oś czasu
+    int dol = MARGINES_GORNY + u.liczbaMaszyn * u.wiersz;
+    out << "<line x1=\"" << MARGINES_LEWY << "\" y1=\"" << dol << "\" x2=\"" << px(u.x(u.makespan)) << "\" y2=\"" << dol
+        << "\" stroke=\"black\"/>\n";
+    int krok = krokOsi(u.makespan);
+    for (int t = 0; t <= u.makespan; t += krok)
+    {
+        out << "<line x1=\"" << px(u.x(t)) << "\" y1=\"" << dol << "\" x2=\"" << px(u.x(t)) << "\" y2=\"" << dol + 4
+            << "\" stroke=\"black\"/><text x=\"" << px(u.x(t)) << "\" y=\"" << dol + 16 << "\" text-anchor=\"middle\">" << t
+            << "</text>\n";
+    }
+    out << "<text x=\"" << u.szerokosc / 2 << "\" y=\"" << dol + 32 << "\" text-anchor=\"middle\">Czas</text>\n";
+
+    if (opcje.sciezkaKrytyczna)
+    {
+        out << "<g fill=\"none\" stroke=\"" << KOLOR_KRYTYCZNY << "\" stroke-width=\"2\">\n";
+        for (int i : sciezkaKrytyczna(harmonogram, u))
+        {
+            const OperationSchedule& op = harmonogram[i];
+            out << "<rect x=\"" << px(u.x(op.start_time)) << "\" y=\"" << u.y(op.machine_id) + 1;
+            out << "\" width=\"" << px(std::max(1.0, (op.end_time - op.start_time) * u.skala)) << "\" height=\""
+                << wysokoscPaska + 2 << "\"/>\n";
+        }
+        out << "</g>\n";
+    }
+
+    out << "</svg>\n";
+    out.flush();
+    if (!out)
+    {
+        LOG_BLAD(Wykresy, "Blad zapisu wykresu: " << nazwaPliku);
+        return false;
+    }
+    return true;
+}
+
+// ===== PNG =====
+
+namespace
+{
+    struct Obraz
+    {
+        int szerokosc;
+        int wysokosc;
+        std::vector<unsigned char> rgb;
+
+        Obraz(int w, int h) : szerokosc(w), wysokosc(h), rgb(std::size_t(w) * h * 3, 255) {}
+
+        void prostokat(int x0, int y0, int x1, int y1, const unsigned char kolor[3])
+        {
+            x0 = std::max(0, x0); y0 = std::max(0, y0);
+            x1 = std::min(szerokosc, x1); y1 = std::min(wysokosc, y1);
+            for (int y = y0; y < y1; ++y)
+            {
+                unsigned char* p = &rgb[(std::size_t(y) * szerokosc + x0) * 3];
+                for (int x = x0; x < x1; ++x, p += 3)
+                {
+                    p[0] = kolor[0]; p[1] = kolor[1]; p[2] = kolor[2];
+                }
+            }
+        }
+
+        void ramka(int x0, int y0, int x1, int y1, int grubosc, const unsigned char kolor[3])
+        {
+            prostokat(x0, y0, x1, y0 + grubosc, kolor);
+            prostokat(x0, y1 - grubosc, x1, y1, kolor);
+            prostokat(x0, y0, x0 + grubosc, y1, kolor);
+            prostokat(x1 - grubosc, y0, x1, y1, kolor);
+        }
+    };
+
+    void kolorZHex(const char* hex, unsigned char kolor[3])
+    {
+        unsigned int r = 0, g = 0, b = 0;
+        std::sscanf(hex, "#%02x%02x%02x", &r, &g, &b);
+        kolor[0] = (unsigned char)r; kolor[1] = (unsigned char)g; kolor[2] = (unsigned char)b;
+    }
+
+    std::vector<uint32_t> tablicaCRC()
+    {
+        std::vector<uint32_t> tablica(256);
+        for (uint32_t k = 0; k < 256; ++k)
+        {
+            uint32_t c = k;
+            for (int b = 0; b < 8; ++b)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            tablica[k] = c;
+        }
+        return tablica;
+    }
+
+    uint32_t crc32(const unsigned char* dane, std::size_t n)
+    {
+        static const std::vector<uint32_t> tablica = tablicaCRC();
+        uint32_t crc = 0xFFFFFFFFu;
+        for (std::size_t i = 0; i < n; ++i)
+            crc = tablica[(crc ^ dane[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    void piszU32(std::vector<unsigned char>& v, uint32_t x)
+    {
+        v.push_back((unsigned char)(x >> 24)); v.push_back((unsigned char)(x >> 16));
+        v.push_back((unsigned char)(x >> 8)); v.push_back((unsigned char)x);
+    }
+
+    void piszFragment(std::ofstream& out, const char* typ, const std::vector<unsigned char>& dane)
+    {
+        std::vector<unsigned char> blok;
+        piszU32(blok, (uint32_t)dane.size());
+        blok.insert(blok.end(), typ, typ + 4);
+        blok.insert(blok.end(), dane.begin(), dane.end());
+        piszU32(blok, crc32(blok.data() + 4, blok.size() - 4));
+        out.write((const char*)blok.data(), blok.size());
+    }
+}
+
+bool zapiszWykresGanttaPNG(const std::vector<OperationSchedule>& harmonogram, const std::string& nazwaPliku,
+                           const OpcjeWykresuGantta& opcje)
+{
+    Uklad u;
+    if (!przygotujUklad(harmonogram, opcje, u))
+        return false;
+
+    Obraz obraz(u.szerokosc, u.wysokosc);
+    unsigned char czarny[3] = { 0, 0, 0 };
+    unsigned char kolor[3];
+    const int wysokoscPaska = std::max(1, u.wiersz - 4);
+
+    // Paski: piksel jest malowany kolorem ostatniej operacji, która na niego trafia, więc drobne
+    // operacje same "łączą się" w rozdzielczości obrazu
+    for (const OperationSchedule& op : harmonogram)
+    {
+        int x0 = (int)std::floor(u.x(op.start_time));
+        int x1 = std::max(x0 + 1, (int)std::floor(u.x(op.end_time)));
+        int y0 = u.y(op.machine_id) + 2;
+        kolorZHex(PALETA[op.job_id % 20], kolor);
+        obraz.prostokat(x0, y0, x1, y0 + wysokoscPaska, kolor);
+        if (x1 - x0 >= 4 && wysokoscPaska >= 4)
+            obraz.ramka(x0, y0, x1, y0 + wysokoscPaska, 1, czarny);
+    }
+
+    int dol = MARGINES_GORNY + u.liczbaMaszyn * u.wiersz;
+    obraz.prostokat(MARGINES_LEWY, dol, (int)u.x(u.makespan) + 1, dol + 1, czarny);
+    int krok = krokOsi(u.makespan);
+    for (int t = 0; t <= u.makespan; t += krok)
+        obraz.prostokat((int)u.x(t), dol, (int)u.x(t) + 1, dol + 5, czarny);
+
+    if (opcje.sciezkaKrytyczna)
+    {
+        kolorZHex(KOLOR_KRYTYCZNY, kolor);
+        for (int i : sciezkaKrytyczna(harmonogram, u))
+        {
+            const OperationSchedule& op = harmonogram[i];
+            int x0 = (int)std::floor(u.x(op.start_time));
+            int x1 = std::max(x0 + 2, (int)std::floor(u.x(op.end_time)));
+            int y0 = u.y(op.machine_id) + 1;
+            obraz.ramka(x0, y0, x1, y0 + wysokoscPaska + 2, std::min(2, (wysokoscPaska + 2) / 2), kolor);
+        }
+    }
+
+    std::ofstream out(nazwaPliku, std::ios::binary);
+    if (!out.is_open())
+    {
+        LOG_BLAD(Wykresy, "Nie mozna otworzyc pliku do zapisu: " << nazwaPliku);
+        return false;
+    }
+
+    static const unsigned char SYGNATURA[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+    out.write((const char*)SYGNATURA, 8);
+
+    std::vector<unsigned char> ihdr;
+    piszU32(ihdr, u.szerokosc);
+    piszU32(ihdr, u.wysokosc);
+    unsigned char reszta[5] = { 8, 2, 0, 0, 0 }; // 8 bitów, RGB, deflate, filtry standardowe, bez przeplotu
+    ihdr.insert(ihdr.end(), reszta, reszta + 5);
+    piszFragment(out, "IHDR", ihdr);
+
+    // Strumień zlib z blokami "stored": wiersz = bajt filtra (0) + piksele
+    std::vector<unsigned char> surowe;
+    surowe.reserve(std::size_t(u.szerokosc * 3 + 1) * u.wysokosc);
+    for (int y = 0; y < u.wysokosc; ++y)
+    {
+        surowe.push_back(0);
+        const unsigned char* wiersz = &obraz.rgb[std::size_t(y) * u.szerokosc * 3];
+        surowe.insert(surowe.end(), wiersz, wiersz + u.szerokosc * 3);
+    }
+
+    std::vector<unsigned char> zlib;
+    zlib.reserve(surowe.size() + surowe.size() / 65535 * 5 + 16);
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+    std::size_t pozycja = 0;
+    do
+    {
+        std::size_t n = std::min<std::size_t>(65535, surowe.size() - pozycja);
+        bool ostatni = (pozycja + n == surowe.size());
+        zlib.push_back(ostatni ? 1 : 0);
+        zlib.push_back((unsigned char)(n & 0xFF));
+        zlib.push_back((unsigned char)(n >> 8));
+        zlib.push_back((unsigned char)(~n & 0xFF));
+        zlib.push_back((unsigned char)((~n >> 8) & 0xFF));
+        zlib.insert(zlib.end(), surowe.begin() + pozycja, surowe.begin() + pozycja + n);
+        pozycja += n;
+    } while (pozycja < surowe.size());
+
+    uint32_t a = 1, b = 0; // Adler-32
+    for (unsigned char c : surowe)
+    {
+        a = (a + c) % 65521;
+        b = (b + a) % 65521;
+    }
+    piszU32(zlib, (b << 16) | a);
+    piszFragment(out, "IDAT", zlib);
+    piszFragment(out, "IEND", std::vector<unsigned char>());
+
+    if (!out)
+    {
+        LOG_BLAD(Wykresy, "Blad zapisu wykresu: " << nazwaPliku);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,29 @@
+#ifndef GANTT_RENDERER_H
+#define GANTT_RENDERER_H
+
+#include "OperationSchedule.h"
+#include <vector>
+#include <string>
+
+// Wykres Gantta prosto z harmonogramu solvera (zamiast skryptów z harmogramy/).
+// Operacje węższe niż minSzerokoscPx, leżące obok siebie na maszynie, są łączone w jeden
+// szary blok, więc rozmiar pliku zależy od rozdzielczości, a nie od liczby operacji.
+struct OpcjeWykresuGantta
+{
+    int szerokosc = 1600;          // px, razem z marginesami
+    int wysokoscWiersza = 24;      // px na maszynę
+    double minSzerokoscPx = 2.0;   // węższe operacje są łączone
+    bool etykiety = true;          // "J.O" na operacjach, na których się mieszczą
+    bool sciezkaKrytyczna = true;  // obwódka operacji ścieżki krytycznej
+    std::string tytul = "Wykres Gantta dla harmonogramu JSSP";
+};
+
+// SVG zapisywane strumieniowo, maszyna po maszynie
+bool zapiszWykresGanttaSVG(const std::vector<OperationSchedule>& harmonogram, const std::string& nazwaPliku,
+                           const OpcjeWykresuGantta& opcje = OpcjeWykresuGantta());
+
+// PNG bez zewnętrznych bibliotek (nieskompresowany deflate) – same paski, bez tekstu
+bool zapiszWykresGanttaPNG(const std::vector<OperationSchedule>& harmonogram, const std::string& nazwaPliku,
+                           const OpcjeWykresuGantta& opcje = OpcjeWykresuGantta());
+
+#endif
@@ -0,0 +1,269 @@
+#include "GraspSolver.h"
+#include "LocalSearch.h"
+#include "ThreadPool.h"
+#include "SolutionArchive.h"
+#include "LowerBounds.h"
+#include "Checkpoint.h"
+#include "Metrics.h"
+#include "Log.h"
+#include "SolverEvents.h"
+#include "ResultWriter.h"
+#include <iostream>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <memory>
+#include <atomic>
+#include <cmath>
+
+// Iteracje w partii – stała, żeby aktualizacje alf (i wynik) nie zależały od liczby wątków
+static const int rozmiarPartii = 32;
+
+GraspSolver::GraspSolver(int liczbaIteracji)
+    : makespan(0), liczbaIteracji(liczbaIteracji), trybDekodera(TrybDekodera::Polaktywny),
+      kodowanie(Kodowanie::Priorytety), cel(0), dolneOgraniczenie(0), regula(RegulaPriorytetowa::MWKR),
+      maksKrokowLokalnych(100), watki(0), alfy({ 0.05, 0.1, 0.15, 0.2, 0.3, 0.4, 0.5 }),
+      ziarno(std::random_device{}()), coIleCheckpoint(0)
+{}
+
+std::vector<double> GraspSolver::prawdopodobienstwaAlf() const
+{
+    // Nieużyta alfa dostaje największą wagę, żeby każda została sprawdzona
+    std::vector<double> p(alfy.size(), 1.0);
+    if (makespan == std::numeric_limits<int>::max())
+        return p;
+    for (int a = 0; a < (int)alfy.size(); ++a)
+        if (liczbaAlf[a] > 0)
+            p[a] = std::pow(makespan / (sumaAlf[a] / liczbaAlf[a]), 10.0);
+    return p;
+}
+
+void GraspSolver::solve(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn)
+{
+    makespan = std::numeric_limits<int>::max();
+    kosztyIteracji.clear();
+    najlepszyGenotyp.clear();
+    sumaAlf.assign(alfy.size(), 0.0);
+    liczbaAlf.assign(alfy.size(), 0);
+
+    ScheduleDecoder dekoder(operacje, liczbaJobow, liczbaMaszyn, trybDekodera, kodowanie);
+
+    int iteracja = 0;
+    uint64_t sumaInstancji = sumaKontrolnaInstancji(operacje, liczbaJobow, liczbaMaszyn);
+    if (plikWznowienia.empty() || !wczytajCheckpoint(sumaInstancji, iteracja))
+    {
+        if (genotypStartowy.size() == operacje.size())
+        {
+            makespan = dekoder.dekoduj(genotypStartowy);
+            najlepszyGenotyp = genotypStartowy;
+        }
+    }
+
+    std::unique_ptr<CheckpointWriter> zapis;
+    if (!plikCheckpointu.empty())
+        zapis.reset(new CheckpointWriter(plikCheckpointu));
+
+    // Bufory robocze na wątek: konstrukcja i przeszukiwanie lokalne
+    PulaWatkow pula(watki);
+    std::vector<std::unique_ptr<DispatchingRules>> konstrukcje;
+    std::vector<std::unique_ptr<LocalSearch>> lokalne;
+    std::vector<std::vector<int>> kolejnosci(pula.getLiczbaWatkow());
+    for (int w = 0; w < pula.getLiczbaWatkow(); ++w)
+    {
+        konstrukcje.emplace_back(new DispatchingRules(operacje, liczbaJobow, liczbaMaszyn));
+        lokalne.emplace_back(new LocalSearch(operacje, liczbaJobow, liczbaMaszyn, trybDekodera, kodowanie));
+    }
+
+    std::atomic<int> wspolnyNajlepszy(makespan);
+    std::vector<int> wyniki(rozmiarPartii), uzyteAlfy(rozmiarPartii);
+    std::vector<std::vector<int>> genotypy(rozmiarPartii);
+
+    while (iteracja < liczbaIteracji && makespan > cel)
+    {
+        const int n = std::min(rozmiarPartii, liczbaIteracji - iteracja);
+        std::vector<double> prawdopodobienstwa = prawdopodobienstwaAlf();
+
+        pula.rownolegle(n, [&](int k, int w) {
+            wyniki[k] = -1;
+            if (wspolnyNajlepszy.load(std::memory_order_relaxed) <= cel)
+                return; // inny wątek osiągnął już cel
+
+            METRYKA_FAZA(Sasiedztwo);
+            std::seed_seq ziarnoIteracji{ ziarno, (unsigned)(iteracja + k) };
+            std::mt19937 g(ziarnoIteracji);
+            std::discrete_distribution<> wyborAlfy(prawdopodobienstwa.begin(), prawdopodobienstwa.end());
+            int a = wyborAlfy(g);
+
+            konstrukcje[w]->zbudujGRASP(regula, alfy[a], g, kolejnosci[w]);
+            genotypy[k] = genotypZKolejnosci(operacje, kolejnosci[w], kodowanie);
+            int wynik = lokalne[w]->popraw(genotypy[k], maksKrokowLokalnych);
+
+            int biezacy = wspolnyNajlepszy.load(std::memory_order_relaxed);
+            while (wynik < biezacy && !wspolnyNajlepszy.compare_exchange_weak(biezacy, wynik))
+                ;
+            wyniki[k] = wynik;
+            uzyteAlfy[k] = a;
+        });
+
+        // Statystyki i najlepszy wynik w kolejności iteracji (remis: wcześniejsza iteracja)
+        for (int k = 0; k < n; ++k)
+        {
+            if (wyniki[k] < 0)
+                continue;
+            kosztyIteracji.push_back(wyniki[k]);
+            sumaAlf[uzyteAlfy[k]] += wyniki[k];
+            liczbaAlf[uzyteAlfy[k]]++;
+            if (wyniki[k] < makespan)
+            {
+                makespan = wyniki[k];
+                najlepszyGenotyp = genotypy[k];
+                METRYKA_DODAJ(Poprawy, 1);
+                zglosPoprawe(makespan);
+                LOG_DEBUG(Grasp, "Iteracja " << iteracja + k << ": nowy najlepszy makespan = " << makespan
+                                  << " (alfa " << alfy[uzyteAlfy[k]] << ")");
+            }
+        }
+
+        int poprzednia = iteracja;
+        iteracja += n;
+        bool okresowy = coIleCheckpoint > 0 && iteracja / coIleCheckpoint != poprzednia / coIleCheckpoint;
+        if (zapis && (okresowy || czyZadanoCheckpointu()))
+        {
+            METRYKA_FAZA(Logowanie);
+            zapiszCheckpoint(iteracja, sumaInstancji, *zapis);
+            potwierdzCheckpoint();
+        }
+        if (czyZadanoZatrzymania())
+            break;
+    }
+
+    // Zatrzymany przebieg zostawia stan do wznowienia; zakończony usuwa checkpoint
+    if (zapis && czyZadanoZatrzymania())
+        zapiszCheckpoint(iteracja, sumaInstancji, *zapis);
+    else if (zapis)
+        zapis->porzuc();
+
+    if (!najlepszyGenotyp.empty())
+        dekoder.dekoduj(najlepszyGenotyp, &schedule);
+}
+
+void GraspSolver::zapiszCheckpoint(int iteracja, uint64_t sumaInstancji, CheckpointWriter& zapis) const
+{
+    BuforZapisu b;
+    b.piszNaglowek("grasp", sumaInstancji, trybDekodera, kodowanie);
+    b.piszU64(ziarno);
+    b.piszInt(iteracja);
+    b.piszInt(makespan);
+    b.piszWektor(najlepszyGenotyp);
+    b.piszWektor(kosztyIteracji);
+    b.piszWektor(sumaAlf);
+    b.piszWektor(liczbaAlf);
+    b.zakoncz();
+
+    zapis.zlec(b.getDane());
+}
+
+bool GraspSolver::wczytajCheckpoint(uint64_t sumaInstancji, int& iteracja)
+{
+    std::vector<char> dane;
+    if (!wczytajPlikBinarny(plikWznowienia, dane))
+    {
+        LOG_OSTRZEZENIE(Grasp, "Brak checkpointu " << plikWznowienia << " – start od nowa");
+        return false;
+    }
+
+    BuforOdczytu b(dane);
+    if (!b.czytajNaglowek("grasp", sumaInstancji, trybDekodera, kodowanie))
+        return false;
+
+    unsigned z = (unsigned)b.czytajU64();
+    int it = b.czytajInt();
+    int najlepszy = b.czytajInt();
+    std::vector<int> genotyp, koszty, liczba;
+    std::vector<double> suma;
+    b.czytajWektor(genotyp);
+    b.czytajWektor(koszty);
+    b.czytajWektor(suma);
+    b.czytajWektor(liczba);
+
+    if (!b.ok() || suma.size() != alfy.size() || liczba.size() != alfy.size())
+    {
+        LOG_OSTRZEZENIE(Grasp, "Niepelny checkpoint " << plikWznowienia);
+        return false;
+    }
+
+    ziarno = z;
+    iteracja = it;
+    makespan = najlepszy;
+    najlepszyGenotyp = genotyp;
+    kosztyIteracji = koszty;
+    sumaAlf = suma;
+    liczbaAlf = liczba;
+    LOG_INFO(Grasp, "Wznowiono z " << plikWznowienia << " od iteracji " << iteracja);
+    return true;
+}
+
+void GraspSolver::wypiszStatystykiAlf() const
+{
+    std::cout << "[GRASP] alfa (iteracje, sredni makespan):";
+    for (int a = 0; a < (int)alfy.size(); ++a)
+    {
+        std::cout << " " << alfy[a] << " (" << liczbaAlf[a] << ", ";
+        if (liczbaAlf[a] > 0)
+            std::cout << sumaAlf[a] / liczbaAlf[a];
+        else
+            std::cout << "-";
+        std::cout << ")";
+    }
+    std::cout << "\n";
+}
+
+void GraspSolver::printSchedule() const
+{
+    std::cout << "\n=== Najlepszy harmonogram (GraspSolver) ===\n";
+    std::cout << "Makespan: " << makespan << "\n";
+    std::cout << "Operacje:\n";
+    std::cout << "Job\tOpID\tMaszyna\tStart\tEnd\n";
+
+    for (const OperationSchedule& op : schedule)
+    {
+        std::cout << op.job_id << "\t"
+                  << op.operation_id << "\t"
+                  << op.machine_id << "\t"
+                  << op.start_time << "\t"
+                  << op.end_time << "\n";
+    }
+}
+
+void GraspSolver::zapiszDoCSV(const std::string& nazwaPliku) const
+{
+    TekstCSV t(',');
+    t.zarezerwuj(schedule.size() * 24);
+    t.tekst() = "job_id,operation_id,machine_id,start_time,end_time\n";
+    for (const OperationSchedule& op : schedule)
+    {
+        t.pole(op.job_id).pole(op.operation_id).pole(op.machine_id).pole(op.start_time).pole(op.end_time);
+        t.koniecWiersza();
+    }
+
+    ResultWriter::instancja().zapisz(nazwaPliku, t.tekst());
+}
+
+void GraspSolver::zapiszStatystykiDoCSV(const std::string& nazwaPliku, int run) const
+{
+    if (kosztyIteracji.empty())
+    {
+        std::cerr << "Brak danych do zapisania statystyk.\n";
+        return;
+    }
+
+    double best = *std::min_element(kosztyIteracji.begin(), kosztyIteracji.end());
+    double worst = *std::max_element(kosztyIteracji.begin(), kosztyIteracji.end());
+    double avg = std::accumulate(kosztyIteracji.begin(), kosztyIteracji.end(), 0.0) / kosztyIteracji.size();
+
+    TekstCSV t;
+    t.pole(run).pole(best).pole(avg).pole(worst).pole(obliczGap(makespan, dolneOgraniczenie));
+    t.koniecWiersza();
+    ResultWriter::instancja().dopisz(nazwaPliku, "run;best;average;worst;gap\n", t.tekst());
+}
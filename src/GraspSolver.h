@@ -0,0 +1,86 @@
+#ifndef GRASP_SOLVER_H
+#define GRASP_SOLVER_H
+
+#include "OperationSchedule.h"
+#include "ScheduleDecoder.h"
+#include "DispatchingRules.h"
+#include <vector>
+#include <string>
+
+class CheckpointWriter;
+
+// GRASP: losowa zachłanna konstrukcja (Giffler–Thompson z listą kandydatów RCL) i LocalSearch
+// po ścieżce krytycznej. Iteracje są niezależne i idą partiami w puli wątków; wspólny najlepszy
+// wynik zatrzymuje wszystkie wątki po osiągnięciu celu. Reaktywny GRASP: alfa jest losowana
+// z prawdopodobieństwami proporcjonalnymi do (najlepszy / średni wynik tej alfy)^10, uaktualnianymi
+// między partiami. Każda iteracja ma własny generator z (ziarno, numer iteracji), więc wynik
+// nie zależy od liczby wątków.
+class GraspSolver
+{
+public:
+    GraspSolver(int liczbaIteracji);
+
+    void solve(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn);
+    void printSchedule() const;
+    void zapiszDoCSV(const std::string& nazwaPliku) const;
+    void zapiszStatystykiDoCSV(const std::string& nazwaPliku, int run) const;
+    // Liczba użyć i średni wynik każdej alfy na std::cout
+    void wypiszStatystykiAlf() const;
+
+    int getMakespan() const { return makespan; }
+    const std::vector<OperationSchedule>& getSchedule() const { return schedule; }
+
+    // Wybór dekodera i kodowania genotypu (domyślnie półaktywny, priorytetowy)
+    void ustawTrybDekodera(TrybDekodera tryb) { trybDekodera = tryb; }
+    void ustawKodowanie(Kodowanie k) { kodowanie = k; }
+
+    // Zatrzymanie po osiągnięciu celu (np. znanego optimum) i dolne ograniczenie do liczenia gapu
+    void ustawCel(int cel) { this->cel = cel; }
+    void ustawDolneOgraniczenie(int lb) { dolneOgraniczenie = lb; }
+
+    // Reguła oceniająca kandydatów (domyślnie MWKR) i limit kroków LocalSearch na iterację
+    void ustawKonstrukcje(RegulaPriorytetowa r, int maksKrokow) { regula = r; maksKrokowLokalnych = maksKrokow; }
+    // 0 = std::thread::hardware_concurrency()
+    void ustawWatki(int n) { watki = n; }
+
+    // Checkpoint co `coIle` iteracji (zaokrąglone do partii), na sygnał i przy zatrzymaniu (zakończony przebieg usuwa plik); pusta ścieżka = wyłączone
+    void ustawCheckpoint(const std::string& sciezka, int coIle) { plikCheckpointu = sciezka; coIleCheckpoint = coIle; }
+    // Następne solve() kontynuuje przebieg z checkpointu (dalej identycznie jak bez przerwy)
+    void wznowZ(const std::string& sciezka) { plikWznowienia = sciezka; }
+    void ustawZiarno(unsigned ziarno) { this->ziarno = ziarno; }
+
+    // Podany genotyp (np. z archiwum) jest początkowym najlepszym rozwiązaniem; pusty = brak
+    void ustawGenotypStartowy(const std::vector<int>& g) { genotypStartowy = g; }
+
+private:
+    // Prawdopodobieństwa alf na następną partię
+    std::vector<double> prawdopodobienstwaAlf() const;
+
+    void zapiszCheckpoint(int iteracja, uint64_t sumaInstancji, CheckpointWriter& zapis) const;
+    bool wczytajCheckpoint(uint64_t sumaInstancji, int& iteracja);
+
+    std::vector<OperationSchedule> schedule;
+    int makespan;
+    int liczbaIteracji;
+    std::vector<int> kosztyIteracji;
+    TrybDekodera trybDekodera;
+    Kodowanie kodowanie;
+    int cel;
+    int dolneOgraniczenie;
+    RegulaPriorytetowa regula;
+    int maksKrokowLokalnych;
+    int watki;
+
+    std::vector<double> alfy;
+    std::vector<double> sumaAlf;   // suma wyników iteracji z daną alfą
+    std::vector<int> liczbaAlf;    // liczba iteracji z daną alfą
+
+    std::vector<int> najlepszyGenotyp;
+    std::vector<int> genotypStartowy;
+    unsigned ziarno;
+    std::string plikCheckpointu;
+    int coIleCheckpoint;
+    std::string plikWznowienia;
+};
+
+#endif
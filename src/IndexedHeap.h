@@ -0,0 +1,86 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <vector>
+#include <utility>
+
+// Kopiec binarny (max) nad elementami 0..n-1 z zapamiętaną pozycją każdego elementu:
+// szczyt() w O(1), zmiana klucza dowolnego elementu w O(log n).
+// Remis kluczy rozstrzyga większy numer elementu, więc kolejność nie zależy od historii zmian.
+class KopiecIndeksowany
+{
+public:
+    void zbuduj(const std::vector<int>& nowe)
+    {
+        klucze = nowe;
+        kopiec.resize(klucze.size());
+        pozycja.resize(klucze.size());
+        for (int e = 0; e < (int)klucze.size(); ++e)
+        {
+            kopiec[e] = e;
+            pozycja[e] = e;
+        }
+        for (int p = (int)kopiec.size() / 2 - 1; p >= 0; --p)
+            wDol(p);
+    }
+
+    bool pusty() const { return kopiec.empty(); }
+    int szczyt() const { return kopiec[0]; }
+    int klucz(int e) const { return klucze[e]; }
+
+    void zmien(int e, int klucz)
+    {
+        int stary = klucze[e];
+        klucze[e] = klucz;
+        if (klucz > stary)
+            wGore(pozycja[e]);
+        else
+            wDol(pozycja[e]);
+    }
+
+private:
+    std::vector<int> kopiec;  // kopiec[p] = element na pozycji p
+    std::vector<int> pozycja; // pozycja[e] = pozycja elementu e w kopcu
+    std::vector<int> klucze;
+
+    bool wyzej(int a, int b) const
+    {
+        return klucze[a] > klucze[b] || (klucze[a] == klucze[b] && a > b);
+    }
+
+    void zamien(int p, int q)
+    {
+        std::swap(kopiec[p], kopiec[q]);
+        pozycja[kopiec[p]] = p;
+        pozycja[kopiec[q]] = q;
+    }
+
+    void wGore(int p)
+    {
+        while (p > 0 && wyzej(kopiec[p], kopiec[(p - 1) / 2]))
+        {
+            zamien(p, (p - 1) / 2);
+            p = (p - 1) / 2;
+        }
+    }
+
+    void wDol(int p)
+    {
+        const int n = (int)kopiec.size();
+        while (true)
+        {
+            int naj = p;
+            int l = 2 * p + 1, r = 2 * p + 2;
+            if (l < n && wyzej(kopiec[l], kopiec[naj]))
+                naj = l;
+            if (r < n && wyzej(kopiec[r], kopiec[naj]))
+                naj = r;
+            if (naj == p)
+                return;
+            zamien(p, naj);
+            p = naj;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,76 @@
+#include "LocalSearch.h"
+#include "Metrics.h"
+#include <algorithm>
+
+LocalSearch::LocalSearch(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                         TrybDekodera tryb, Kodowanie kodowanie)
+    : operacje(operacje), dekoder(operacje, liczbaJobow, liczbaMaszyn, tryb, kodowanie),
+      sciezka(this->operacje, liczbaJobow, liczbaMaszyn, kodowanie)
+{}
+
+int LocalSearch::popraw(std::vector<int>& genotyp, int maksKrokow)
+{
+    int wynik = dekoder.dekoduj(genotyp, &harmonogram);
+
+    METRYKA_FAZA(Sasiedztwo);
+    for (int krok = 0; krok < maksKrokow; ++krok)
+    {
+        sciezka.wczytaj(harmonogram);
+        sciezka.pozycjeGenow(genotyp);
+
+        int najlepszyKoszt = wynik;
+        int najlepszyA = -1, najlepszyB = -1;
+        for (const std::pair<int, int>& ruch : sciezka.getRuchy())
+        {
+            int a = sciezka.getPozycja(ruch.first);
+            int b = sciezka.getPozycja(ruch.second);
+            std::swap(genotyp[a], genotyp[b]);
+            int koszt = dekoder.dekodujDo(genotyp, najlepszyKoszt);
+            std::swap(genotyp[a], genotyp[b]); // cofnięcie ruchu
+            if (koszt < najlepszyKoszt)
+            {
+                najlepszyKoszt = koszt;
+                najlepszyA = a;
+                najlepszyB = b;
+            }
+        }
+        if (najlepszyA < 0)
+            break; // minimum lokalne
+
+        std::swap(genotyp[najlepszyA], genotyp[najlepszyB]);
+        wynik = dekoder.dekoduj(genotyp, &harmonogram);
+        METRYKA_DODAJ(ZaakceptowaneRuchy, 1);
+    }
+    return wynik;
+}
+
+// ===== MemeticImprover =====
+
+MemeticImprover::MemeticImprover(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                                 TrybDekodera tryb, Kodowanie kodowanie, const UstawieniaMemetyczne& ustawienia)
+    : ustawienia(ustawienia), pula(ustawienia.watki)
+{
+    for (int w = 0; w < pula.getLiczbaWatkow(); ++w)
+        przestrzenie.emplace_back(new LocalSearch(operacje, liczbaJobow, liczbaMaszyn, tryb, kodowanie));
+}
+
+void MemeticImprover::popraw(const std::vector<std::vector<int>*>& genotypy, std::vector<int>& fitness)
+{
+    fitness.resize(genotypy.size());
+    pula.rownolegle((int)genotypy.size(), [&](int k, int watek) {
+        if (ustawienia.tryb == TrybMemetyczny::Lamarck)
+        {
+            fitness[k] = przestrzenie[watek]->popraw(*genotypy[k], ustawienia.maksKrokow);
+        }
+        else
+        {
+            std::vector<int> kopia = *genotypy[k];
+            fitness[k] = przestrzenie[watek]->popraw(kopia, ustawienia.maksKrokow);
+        }
+    });
+}
+
+int MemeticImprover::popraw(std::vector<int>& genotyp)
+{
+    return przestrzenie[0]->popraw(genotyp, ustawienia.maksKrokow);
+}
@@ -0,0 +1,68 @@
+#ifndef LOCAL_SEARCH_H
+#define LOCAL_SEARCH_H
+
+#include "OperationSchedule.h"
+#include "ScheduleDecoder.h"
+#include "CriticalPath.h"
+#include "ThreadPool.h"
+#include <vector>
+#include <memory>
+
+// Co robi poprawa lokalna z genotypem potomka
+enum class TrybMemetyczny
+{
+    Brak,
+    Lamarck,  // poprawiony genotyp zastępuje potomka
+    Baldwin   // potomek zostaje, dostaje tylko koszt po poprawie
+};
+
+struct UstawieniaMemetyczne
+{
+    TrybMemetyczny tryb = TrybMemetyczny::Brak;
+    double czescPotomstwa = 1.0; // prawdopodobieństwo poprawy pojedynczego potomka
+    int maksKrokow = 50;         // limit kroków najszybszego spadku na potomka
+    int watki = 0;               // 0 = std::thread::hardware_concurrency()
+};
+
+// Najszybszy spadek w sąsiedztwie N1: zamiana dwóch sąsiednich operacji ścieżki krytycznej
+// na tej samej maszynie. Ruch to zamiana ich genów (priorytetów albo wystąpień jobów w ciągu),
+// oceniana dekoderem solvera, więc poprawiony genotyp różni się od wejściowego tylko
+// w zamienionych genach. Obiekt to bufory robocze jednego wątku.
+class LocalSearch
+{
+public:
+    LocalSearch(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                TrybDekodera tryb, Kodowanie kodowanie);
+
+    // Poprawia genotyp w miejscu (nigdy na gorszy) i zwraca jego makespan wg dekodera
+    int popraw(std::vector<int>& genotyp, int maksKrokow);
+
+private:
+    std::vector<OperationSchedule> operacje; // kopia – ścieżka trzyma do niej referencję
+    ScheduleDecoder dekoder;
+    SciezkaKrytyczna sciezka;
+    std::vector<OperationSchedule> harmonogram;
+};
+
+// Poprawa potomstwa w puli wątków, z osobnym LocalSearch na wątek.
+// Każdy genotyp jest poprawiany deterministycznie, więc wynik nie zależy od liczby wątków.
+class MemeticImprover
+{
+public:
+    MemeticImprover(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                    TrybDekodera tryb, Kodowanie kodowanie, const UstawieniaMemetyczne& ustawienia);
+
+    // Lamarck: genotypy są podmieniane na poprawione; Baldwin: zmienia się tylko fitness
+    void popraw(const std::vector<std::vector<int>*>& genotypy, std::vector<int>& fitness);
+    // Jeden genotyp w wątku wołającym (np. odtworzenie najlepszego rozwiązania w trybie Baldwina)
+    int popraw(std::vector<int>& genotyp);
+
+    const UstawieniaMemetyczne& getUstawienia() const { return ustawienia; }
+
+private:
+    UstawieniaMemetyczne ustawienia;
+    PulaWatkow pula;
+    std::vector<std::unique_ptr<LocalSearch>> przestrzenie; // po jednej na wątek puli
+};
+
+#endif
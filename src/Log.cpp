@@ -0,0 +1,193 @@
+#include "Log.h"
+#include "Metrics.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+
+static const char* NAZWY_POZIOMOW[] = { "slad", "debug", "info", "ostrzezenie", "blad", "wylaczony" };
+static const char* NAZWY_KATEGORII[LICZBA_KATEGORII_LOGU] = { "Ogolne", "Random", "GRASP", "Tabu", "SA",
+                                                              "Ewolucja", "EA", "Rescheduler", "Checkpoint",
+                                                              "Archiwum", "Wyniki", "Populacja", "Wykresy" };
+
+static const std::chrono::steady_clock::time_point startDziennika = std::chrono::steady_clock::now();
+
+static const char* nazwaPoziomu(PoziomLogu poziom)
+{
+    return NAZWY_POZIOMOW[static_cast<int>(poziom) - static_cast<int>(PoziomLogu::Slad)];
+}
+
+static std::string maleLitery(std::string s)
+{
+    for (char& c : s)
+        if (c >= 'A' && c <= 'Z')
+            c = char(c - 'A' + 'a');
+    return s;
+}
+
+static bool poziomZNazwy(const std::string& nazwa, PoziomLogu& poziom)
+{
+    for (int p = static_cast<int>(PoziomLogu::Slad); p <= static_cast<int>(PoziomLogu::Wylaczony); ++p)
+    {
+        if (nazwa == NAZWY_POZIOMOW[p - static_cast<int>(PoziomLogu::Slad)])
+        {
+            poziom = static_cast<PoziomLogu>(p);
+            return true;
+        }
+    }
+    return false;
+}
+
+static std::string tekstJSON(const std::string& s)
+{
+    static const char* HEX = "0123456789abcdef";
+    std::string wynik;
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+            wynik += '\\';
+        if (c == '\n')
+        {
+            wynik += "\\n";
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            // Pozostałe znaki sterujące (\t, \r, ...) jako \u00XX – JSON ich nie dopuszcza dosłownie
+            wynik += "\\u00";
+            wynik += HEX[(c >> 4) & 0xf];
+            wynik += HEX[c & 0xf];
+        }
+        else
+        {
+            wynik += c;
+        }
+    }
+    return wynik;
+}
+
+Dziennik& Dziennik::instancja()
+{
+    static Dziennik dziennik;
+    return dziennik;
+}
+
+void Dziennik::ustawPoziom(PoziomLogu poziom)
+{
+    for (int k = 0; k < LICZBA_KATEGORII_LOGU; ++k)
+        progiLogu[k].store(static_cast<int>(poziom), std::memory_order_relaxed);
+}
+
+void Dziennik::ustawPoziom(KategoriaLogu kategoria, PoziomLogu poziom)
+{
+    progiLogu[static_cast<int>(kategoria)].store(static_cast<int>(poziom), std::memory_order_relaxed);
+}
+
+bool Dziennik::konfiguruj(const std::string& opis)
+{
+    bool ok = true;
+    std::stringstream ss(opis);
+    std::string element;
+    while (std::getline(ss, element, ','))
+    {
+        if (element.empty())
+            continue;
+
+        size_t rowne = element.find('=');
+        PoziomLogu poziom;
+        if (!poziomZNazwy(maleLitery(element.substr(rowne == std::string::npos ? 0 : rowne + 1)), poziom))
+        {
+            std::cerr << "Nieznany poziom logu: " << element << "\n";
+            ok = false;
+            continue;
+        }
+        if (rowne == std::string::npos)
+        {
+            ustawPoziom(poziom);
+            continue;
+        }
+
+        std::string nazwa = maleLitery(element.substr(0, rowne));
+        int k = 0;
+        while (k < LICZBA_KATEGORII_LOGU && maleLitery(NAZWY_KATEGORII[k]) != nazwa)
+            ++k;
+        if (k == LICZBA_KATEGORII_LOGU)
+        {
+            std::cerr << "Nieznana kategoria logu: " << nazwa << "\n";
+            ok = false;
+            continue;
+        }
+        ustawPoziom(static_cast<KategoriaLogu>(k), poziom);
+    }
+    return ok;
+}
+
+void Dziennik::konfigurujZeSrodowiska()
+{
+    const char* opis = std::getenv("JSSP_LOG");
+    if (opis != nullptr)
+        konfiguruj(opis);
+}
+
+bool Dziennik::ustawPlik(const std::string& sciezka, bool json)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (plik.is_open())
+        plik.close();
+    this->json = json;
+    if (sciezka.empty())
+        return true;
+
+    plik.open(sciezka, std::ios::app);
+    if (!plik.is_open())
+    {
+        std::cerr << "Nie mozna otworzyc pliku do zapisu: " << sciezka << "\n";
+        return false;
+    }
+    return true;
+}
+
+void Dziennik::zapisz(PoziomLogu poziom, KategoriaLogu kategoria, const std::string& tekst)
+{
+    METRYKA_FAZA(Logowanie);
+    double czas = std::chrono::duration<double>(std::chrono::steady_clock::now() - startDziennika).count();
+    const char* nazwa = NAZWY_KATEGORII[static_cast<int>(kategoria)];
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::ostringstream wiersz;
+    wiersz << std::fixed << std::setprecision(3);
+    if (plik.is_open() && json)
+    {
+        wiersz << "{\"t\": " << czas << ", \"level\": \"" << nazwaPoziomu(poziom) << "\", \"category\": \""
+               << maleLitery(nazwa) << "\", \"msg\": \"" << tekstJSON(tekst) << "\"}\n";
+    }
+    else
+    {
+        // Na konsoli Info i wyżej wyglądają jak dotychczasowe komunikaty solverów
+        if (kategoria != KategoriaLogu::Ogolne)
+            wiersz << "[" << nazwa << "] ";
+        if (plik.is_open() || poziom < PoziomLogu::Info)
+            wiersz << nazwaPoziomu(poziom) << " +" << czas << "s: ";
+        wiersz << tekst << "\n";
+    }
+
+    if (plik.is_open())
+        plik << wiersz.str() << std::flush;
+    else if (poziom == PoziomLogu::Info)
+        std::cout << wiersz.str();
+    else
+        std::cerr << wiersz.str();
+}
+
+int LimitLogu::przepusc()
+{
+    int64_t sekunda = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now() - startDziennika).count() + 1;
+    int64_t biezace = okno.load(std::memory_order_relaxed);
+    if (biezace != sekunda && okno.compare_exchange_strong(biezace, sekunda))
+        wOknie.store(0, std::memory_order_relaxed);
+
+    if (wOknie.fetch_add(1, std::memory_order_relaxed) < naSekunde)
+        return pominiete.exchange(0, std::memory_order_relaxed);
+    pominiete.fetch_add(1, std::memory_order_relaxed);
+    return -1;
+}
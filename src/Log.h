@@ -0,0 +1,156 @@
+#ifndef LOG_H
+#define LOG_H
+
+// Dziennik komunikatów solverów: poziom w czasie kompilacji, progi kategorii w czasie działania
+// i limit komunikatów na sekundę dla miejsc w gorących pętlach.
+// -DJSSP_LOG_POZIOM=Info (albo Debug, Ostrzezenie...) usuwa z kodu wszystko poniżej tego poziomu;
+// domyślnie kompilacja z NDEBUG zostawia od Info w górę, a bez niego wszystko. Wyłączony komunikat
+// kosztuje jeden odczyt i porównanie – argumenty nie są wtedy nawet liczone.
+#ifndef JSSP_LOG_POZIOM
+#ifdef NDEBUG
+#define JSSP_LOG_POZIOM Info
+#else
+#define JSSP_LOG_POZIOM Slad
+#endif
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Info ma wartość 0, żeby wyzerowane progi kategorii oznaczały domyślny poziom
+enum class PoziomLogu
+{
+    Slad = -2,       // pojedyncze ruchy, osobniki, genotypy
+    Debug = -1,      // przebieg algorytmu (iteracje, pokolenia, sytuacje bez wyjścia)
+    Info = 0,        // wznowienia i podsumowania
+    Ostrzezenie = 1, // pominięte dane, start od nowa
+    Blad = 2,
+    Wylaczony = 3
+};
+
+enum class KategoriaLogu
+{
+    Ogolne,
+    Random,
+    Grasp,
+    Tabu,
+    SA,
+    Ewolucja,    // EvolutionSolver
+    EA,          // EvolutionarySolver
+    Rescheduler,
+    Checkpoint,
+    Archiwum,    // SolutionArchive i wczytywanie harmonogramów
+    Wyniki,      // ResultWriter
+    Populacja,   // PopulationTrace
+    Wykresy,     // GanttRenderer
+    Liczba
+};
+
+const int LICZBA_KATEGORII_LOGU = static_cast<int>(KategoriaLogu::Liczba);
+
+// Progi kategorii; czytane bez blokady przy każdym komunikacie
+inline std::atomic<int> progiLogu[LICZBA_KATEGORII_LOGU];
+
+inline bool czyLogowac(KategoriaLogu kategoria, PoziomLogu poziom)
+{
+    return static_cast<int>(poziom) >= progiLogu[static_cast<int>(kategoria)].load(std::memory_order_relaxed);
+}
+
+class Dziennik
+{
+public:
+    static Dziennik& instancja();
+
+    void ustawPoziom(PoziomLogu poziom);                          // wszystkie kategorie
+    void ustawPoziom(KategoriaLogu kategoria, PoziomLogu poziom);
+    // Np. "debug" albo "info,tabu=slad,ewolucja=debug"; false przy nieznanej nazwie (reszta jest stosowana)
+    bool konfiguruj(const std::string& opis);
+    // Konfiguracja ze zmiennej środowiskowej JSSP_LOG (ten sam format), jeśli jest ustawiona
+    void konfigurujZeSrodowiska();
+
+    // Komunikaty do pliku (json = jeden obiekt JSON na wiersz); pusta ścieżka = konsola:
+    // Info na std::cout, reszta na std::cerr
+    bool ustawPlik(const std::string& sciezka, bool json = false);
+
+    void zapisz(PoziomLogu poziom, KategoriaLogu kategoria, const std::string& tekst);
+
+private:
+    Dziennik() : json(false) {}
+
+    std::mutex mutex;
+    std::ofstream plik;
+    bool json;
+};
+
+// Limit komunikatów jednego miejsca w kodzie (okno jednej sekundy).
+// Zwraca -1, gdy komunikat trzeba pominąć, inaczej liczbę pominiętych od poprzedniego.
+class LimitLogu
+{
+public:
+    explicit LimitLogu(int naSekunde) : naSekunde(naSekunde), okno(0), wOknie(0), pominiete(0) {}
+    int przepusc();
+
+private:
+    const int naSekunde;
+    std::atomic<int64_t> okno;
+    std::atomic<int> wOknie;
+    std::atomic<int> pominiete;
+};
+
+// Wypisanie wektora (np. genotypu) w treści komunikatu: LOG_SLAD(Ewolucja, "dziecko: " << WektorLogu{ g })
+struct WektorLogu
+{
+    const std::vector<int>& wartosci;
+};
+
+inline std::ostream& operator<<(std::ostream& out, const WektorLogu& w)
+{
+    for (size_t i = 0; i < w.wartosci.size(); ++i)
+        out << (i ? " " : "") << w.wartosci[i];
+    return out;
+}
+
+#define LOG_WKOMPILOWANY(poziom) (static_cast<int>(PoziomLogu::poziom) >= static_cast<int>(PoziomLogu::JSSP_LOG_POZIOM))
+
+#define LOG_KOMUNIKAT(poziom, kategoria, tresc)                                                             \
+    do                                                                                                      \
+    {                                                                                                       \
+        if (LOG_WKOMPILOWANY(poziom) && czyLogowac(KategoriaLogu::kategoria, PoziomLogu::poziom))          \
+        {                                                                                                   \
+            std::ostringstream strumienLogu;                                                                \
+            strumienLogu << tresc;                                                                          \
+            Dziennik::instancja().zapisz(PoziomLogu::poziom, KategoriaLogu::kategoria, strumienLogu.str()); \
+        }                                                                                                   \
+    } while (0)
+
+// Co najwyżej naSekunde komunikatów z tego miejsca; liczba pominiętych trafia do następnego
+#define LOG_LIMIT(poziom, kategoria, naSekunde, tresc)                                                      \
+    do                                                                                                      \
+    {                                                                                                       \
+        if (LOG_WKOMPILOWANY(poziom) && czyLogowac(KategoriaLogu::kategoria, PoziomLogu::poziom))          \
+        {                                                                                                   \
+            static LimitLogu limitLogu(naSekunde);                                                          \
+            int pominieteLogu = limitLogu.przepusc();                                                       \
+            if (pominieteLogu >= 0)                                                                         \
+            {                                                                                               \
+                std::ostringstream strumienLogu;                                                            \
+                strumienLogu << tresc;                                                                      \
+                if (pominieteLogu > 0)                                                                      \
+                    strumienLogu << " (pominieto " << pominieteLogu << " podobnych)";                      \
+                Dziennik::instancja().zapisz(PoziomLogu::poziom, KategoriaLogu::kategoria, strumienLogu.str()); \
+            }                                                                                               \
+        }                                                                                                   \
+    } while (0)
+
+#define LOG_SLAD(kategoria, tresc) LOG_KOMUNIKAT(Slad, kategoria, tresc)
+#define LOG_DEBUG(kategoria, tresc) LOG_KOMUNIKAT(Debug, kategoria, tresc)
+#define LOG_INFO(kategoria, tresc) LOG_KOMUNIKAT(Info, kategoria, tresc)
+#define LOG_OSTRZEZENIE(kategoria, tresc) LOG_KOMUNIKAT(Ostrzezenie, kategoria, tresc)
+#define LOG_BLAD(kategoria, tresc) LOG_KOMUNIKAT(Blad, kategoria, tresc)
+
+#endif
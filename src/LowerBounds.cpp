@@ -0,0 +1,163 @@
+#include "LowerBounds.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <queue>
+#include <cctype>
+#include <cstdlib>
+
+int DolneOgraniczenia::wartosc() const
+{
+    return std::max(najdluzszyJob, std::max(najbardziejObciazona, jednaMaszyna));
+}
+
+// Preemptywny harmonogram Jacksona: zawsze wykonuj dostępne zadanie z największym ogonem.
+// Jest optymalny dla 1|r_j,pmtn,q_j|Cmax, więc daje poprawne dolne ograniczenie.
+int preemptywnyJackson(std::vector<ZadanieJednomaszynowe>& zadania)
+{
+    std::sort(zadania.begin(), zadania.end(), [](const ZadanieJednomaszynowe& a, const ZadanieJednomaszynowe& b) {
+        return a.r < b.r;
+    });
+
+    // (ogon, pozostały czas)
+    std::priority_queue<std::pair<int, int>> dostepne;
+    int t = 0;
+    int wynik = 0;
+    int idx = 0;
+    const int n = zadania.size();
+
+    while (idx < n || !dostepne.empty())
+    {
+        if (dostepne.empty() && zadania[idx].r > t)
+            t = zadania[idx].r;
+
+        while (idx < n && zadania[idx].r <= t)
+        {
+            dostepne.push(std::make_pair(zadania[idx].q, zadania[idx].p));
+            ++idx;
+        }
+
+        std::pair<int, int> biezace = dostepne.top();
+        dostepne.pop();
+
+        // Wykonujemy do końca albo do najbliższego uwolnienia, które może je wywłaszczyć
+        int doUwolnienia = (idx < n) ? zadania[idx].r - t : biezace.second;
+        int ile = std::min(biezace.second, doUwolnienia);
+        t += ile;
+        biezace.second -= ile;
+
+        if (biezace.second == 0)
+            wynik = std::max(wynik, t + biezace.first);
+        else
+            dostepne.push(biezace);
+    }
+
+    return wynik;
+}
+
+DolneOgraniczenia obliczDolneOgraniczenia(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn)
+{
+    DolneOgraniczenia lb;
+    lb.najdluzszyJob = 0;
+    lb.najbardziejObciazona = 0;
+    lb.jednaMaszyna = 0;
+
+    std::vector<int> dlugoscJoba(liczbaJobow, 0);
+    std::vector<int> obciazenie(liczbaMaszyn, 0);
+    for (int i = 0; i < (int)operacje.size(); ++i)
+    {
+        dlugoscJoba[operacje[i].job_id] += operacje[i].processing_time;
+        obciazenie[operacje[i].machine_id] += operacje[i].processing_time;
+    }
+    for (int j = 0; j < liczbaJobow; ++j)
+        lb.najdluzszyJob = std::max(lb.najdluzszyJob, dlugoscJoba[j]);
+    for (int m = 0; m < liczbaMaszyn; ++m)
+        lb.najbardziejObciazona = std::max(lb.najbardziejObciazona, obciazenie[m]);
+
+    // Głowa = suma czasów poprzednich operacji joba, ogon = suma następnych
+    std::vector<int> glowa(operacje.size(), 0);
+    std::vector<std::vector<int>> operacjeJoba(liczbaJobow);
+    for (int i = 0; i < (int)operacje.size(); ++i)
+        operacjeJoba[operacje[i].job_id].push_back(i);
+
+    std::vector<std::vector<ZadanieJednomaszynowe>> naMaszynie(liczbaMaszyn);
+    for (int j = 0; j < liczbaJobow; ++j)
+    {
+        std::vector<int>& ops = operacjeJoba[j];
+        std::sort(ops.begin(), ops.end(), [&](int a, int b) {
+            return operacje[a].operation_id < operacje[b].operation_id;
+        });
+
+        int suma = 0;
+        for (int k = 0; k < (int)ops.size(); ++k)
+        {
+            const OperationSchedule& op = operacje[ops[k]];
+            ZadanieJednomaszynowe z;
+            z.r = suma;
+            z.p = op.processing_time;
+            z.q = dlugoscJoba[j] - suma - op.processing_time;
+            naMaszynie[op.machine_id].push_back(z);
+            suma += op.processing_time;
+        }
+    }
+
+    for (int m = 0; m < liczbaMaszyn; ++m)
+    {
+        if (!naMaszynie[m].empty())
+            lb.jednaMaszyna = std::max(lb.jednaMaszyna, preemptywnyJackson(naMaszynie[m]));
+    }
+
+    return lb;
+}
+
+bool wczytajZnaneOptima(const std::string& sciezka, std::map<std::string, ZnaneOptimum>& optima)
+{
+    std::ifstream file(sciezka);
+    if (!file.is_open())
+    {
+        std::cerr << "Nie mozna otworzyc pliku: " << sciezka << "\n";
+        return false;
+    }
+
+    std::string line;
+    std::getline(file, line); // nagłówek "Name Size LB UB"
+
+    while (std::getline(file, line))
+    {
+        std::istringstream iss(line);
+        std::string nazwa, rozmiar, lbTekst, ubTekst;
+        if (!(iss >> nazwa >> rozmiar >> lbTekst >> ubTekst))
+            continue;
+
+        // "1231(Ta1994)" -> 1231, źródło w nawiasie pomijamy
+        ZnaneOptimum opt;
+        opt.lb = std::atoi(lbTekst.c_str());
+        opt.ub = std::atoi(ubTekst.c_str());
+
+        std::transform(nazwa.begin(), nazwa.end(), nazwa.begin(), [](unsigned char c) { return std::tolower(c); });
+        optima[nazwa] = opt;
+    }
+
+    return true;
+}
+
+std::string nazwaInstancji(const std::string& sciezka)
+{
+    std::string::size_type poczatek = sciezka.find_last_of("/\\");
+    std::string nazwa = (poczatek == std::string::npos) ? sciezka : sciezka.substr(poczatek + 1);
+
+    std::string::size_type kropka = nazwa.find_last_of('.');
+    if (kropka != std::string::npos)
+        nazwa = nazwa.substr(0, kropka);
+
+    std::transform(nazwa.begin(), nazwa.end(), nazwa.begin(), [](unsigned char c) { return std::tolower(c); });
+    return nazwa;
+}
+
+double obliczGap(int makespan, int dolneOgraniczenie)
+{
+    if (dolneOgraniczenie <= 0)
+        return 0.0;
+    return 100.0 * (makespan - dolneOgraniczenie) / dolneOgraniczenie;
+}
@@ -0,0 +1,50 @@
+#ifndef LOWER_BOUNDS_H
+#define LOWER_BOUNDS_H
+
+#include "OperationSchedule.h"
+#include <vector>
+#include <string>
+#include <map>
+
+// Dolne ograniczenia makespanu liczone raz na instancję
+struct DolneOgraniczenia
+{
+    int najdluzszyJob;          // max suma czasów operacji joba
+    int najbardziejObciazona;   // max suma czasów operacji na maszynie
+    int jednaMaszyna;           // max po maszynach z 1|r_j,pmtn,q_j|Cmax (głowy i ogony z jobów)
+
+    int wartosc() const;
+};
+
+// Operacja w podproblemie jednomaszynowym: głowa (r), czas (p), ogon (q)
+struct ZadanieJednomaszynowe
+{
+    int r;
+    int p;
+    int q;
+};
+
+// Optimum 1|r_j,pmtn,q_j|Cmax (preemptywny harmonogram Jacksona); sortuje zadania po r
+int preemptywnyJackson(std::vector<ZadanieJednomaszynowe>& zadania);
+
+DolneOgraniczenia obliczDolneOgraniczenia(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn);
+
+// LB/UB z literatury (ta/optima.txt)
+struct ZnaneOptimum
+{
+    int lb;
+    int ub;
+
+    bool czyUdowodnione() const { return lb == ub; }
+};
+
+// Wczytuje optima.txt do mapy: nazwa instancji małymi literami ("ta01") -> LB/UB
+bool wczytajZnaneOptima(const std::string& sciezka, std::map<std::string, ZnaneOptimum>& optima);
+
+// "ta\\ta01.txt" albo "ta/ta01.txt" -> "ta01"
+std::string nazwaInstancji(const std::string& sciezka);
+
+// Luka względem dolnego ograniczenia w procentach
+double obliczGap(int makespan, int dolneOgraniczenie);
+
+#endif
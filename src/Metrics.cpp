@@ -0,0 +1,282 @@
+#include "Metrics.h"
+
+#if JSSP_METRYKI
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+static const char* NAZWY_LICZNIKOW[LICZBA_LICZNIKOW] = { "evaluations", "accepted_moves", "improvements", "restarts", "pruned_evaluations" };
+static const char* NAZWY_FAZ[LICZBA_FAZ] = { "decode", "neighborhood", "selection", "logging" };
+
+static const std::chrono::steady_clock::time_point START_PROCESU = std::chrono::steady_clock::now();
+
+uint64_t czasNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - START_PROCESU).count();
+}
+
+// Czas procesora całego procesu (std::clock na Windows zwraca czas ścienny)
+static double czasCPU()
+{
+#ifdef _WIN32
+    FILETIME utworzenie, zakonczenie, jadro, uzytkownik;
+    if (!GetProcessTimes(GetCurrentProcess(), &utworzenie, &zakonczenie, &jadro, &uzytkownik))
+        return 0.0;
+    ULARGE_INTEGER j, u;
+    j.LowPart = jadro.dwLowDateTime;
+    j.HighPart = jadro.dwHighDateTime;
+    u.LowPart = uzytkownik.dwLowDateTime;
+    u.HighPart = uzytkownik.dwHighDateTime;
+    return (j.QuadPart + u.QuadPart) * 1e-7; // jednostki po 100 ns
+#else
+    rusage r;
+    if (getrusage(RUSAGE_SELF, &r) != 0)
+        return 0.0;
+    return r.ru_utime.tv_sec + r.ru_stime.tv_sec + (r.ru_utime.tv_usec + r.ru_stime.tv_usec) * 1e-6;
+#endif
+}
+
+uint64_t szczytowaPamiecKB()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return 0;
+    return pmc.PeakWorkingSetSize / 1024;
+#else
+    rusage r;
+    if (getrusage(RUSAGE_SELF, &r) != 0)
+        return 0;
+#ifdef __APPLE__
+    return r.ru_maxrss / 1024; // macOS podaje bajty
+#else
+    return r.ru_maxrss;
+#endif
+#endif
+}
+
+BlokLicznikow::BlokLicznikow()
+    : aktywnaFaza(-1), znacznik(0)
+{
+    for (int i = 0; i < LICZBA_LICZNIKOW; ++i)
+        liczniki[i].store(0, std::memory_order_relaxed);
+    for (int i = 0; i < LICZBA_FAZ; ++i)
+        czasFaz[i].store(0, std::memory_order_relaxed);
+}
+
+RejestrMetryk::RejestrMetryk()
+    : run(0), koniecProbkowania(false)
+{
+    poczatekRunu = MigawkaMetryk();
+    for (int i = 0; i < LICZBA_LICZNIKOW; ++i)
+        licznikiZakonczonych[i] = 0;
+    for (int i = 0; i < LICZBA_FAZ; ++i)
+        czasFazZakonczonych[i] = 0;
+}
+
+RejestrMetryk::~RejestrMetryk()
+{
+    zatrzymajProbkowanie();
+}
+
+RejestrMetryk& RejestrMetryk::instancja()
+{
+    static RejestrMetryk rejestr;
+    return rejestr;
+}
+
+namespace
+{
+// Zwraca blok wątku do rejestru przy jego zakończeniu; tworzony tylko przy rejestracji,
+// więc gorąca ścieżka (blokWatku) zostaje zwykłym wskaźnikiem
+struct ZwolnienieBloku
+{
+    BlokLicznikow* blok = nullptr;
+    ~ZwolnienieBloku()
+    {
+        if (blok != nullptr)
+            RejestrMetryk::instancja().zwolnijWatek(blok);
+        blokWatku = nullptr;
+    }
+};
+}
+
+BlokLicznikow* RejestrMetryk::zarejestrujWatek()
+{
+    static thread_local ZwolnienieBloku zwolnienie;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!wolneBloki.empty())
+    {
+        zwolnienie.blok = wolneBloki.back();
+        wolneBloki.pop_back();
+    }
+    else
+    {
+        bloki.push_back(std::unique_ptr<BlokLicznikow>(new BlokLicznikow()));
+        zwolnienie.blok = bloki.back().get();
+    }
+    return zwolnienie.blok;
+}
+
+void RejestrMetryk::zwolnijWatek(BlokLicznikow* blok)
+{
+    // Przeniesienie do sumy i wyzerowanie pod blokadą – migawka widzi liczniki dokładnie raz
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int i = 0; i < LICZBA_LICZNIKOW; ++i)
+        licznikiZakonczonych[i] += blok->liczniki[i].exchange(0, std::memory_order_relaxed);
+    for (int i = 0; i < LICZBA_FAZ; ++i)
+        czasFazZakonczonych[i] += blok->czasFaz[i].exchange(0, std::memory_order_relaxed);
+    blok->aktywnaFaza = -1;
+    wolneBloki.push_back(blok);
+}
+
+MigawkaMetryk RejestrMetryk::migawka() const
+{
+    MigawkaMetryk m = MigawkaMetryk();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int i = 0; i < LICZBA_LICZNIKOW; ++i)
+            m.liczniki[i] = licznikiZakonczonych[i];
+        for (int i = 0; i < LICZBA_FAZ; ++i)
+            m.czasFaz[i] = czasFazZakonczonych[i];
+        for (int b = 0; b < (int)bloki.size(); ++b)
+        {
+            for (int i = 0; i < LICZBA_LICZNIKOW; ++i)
+                m.liczniki[i] += bloki[b]->liczniki[i].load(std::memory_order_relaxed);
+            for (int i = 0; i < LICZBA_FAZ; ++i)
+                m.czasFaz[i] += bloki[b]->czasFaz[i].load(std::memory_order_relaxed);
+        }
+    }
+    m.czasScienny = czasNs() * 1e-9;
+    m.czasCPU = czasCPU();
+    return m;
+}
+
+void RejestrMetryk::rozpocznijRun(const std::string& solver, int run)
+{
+    MigawkaMetryk m = migawka();
+    std::lock_guard<std::mutex> lock(mutex);
+    this->solver = solver;
+    this->run = run;
+    poczatekRunu = m;
+}
+
+bool RejestrMetryk::zakonczRun(const std::string& plikJSON)
+{
+    MigawkaMetryk koniec = migawka();
+    std::string nazwa;
+    int numer;
+    MigawkaMetryk poczatek;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        nazwa = solver;
+        numer = run;
+        poczatek = poczatekRunu;
+    }
+
+    std::ofstream out(plikJSON);
+    if (!out.is_open())
+    {
+        std::cerr << "Nie mozna otworzyc pliku do zapisu: " << plikJSON << "\n";
+        return false;
+    }
+
+    double wall = koniec.czasScienny - poczatek.czasScienny;
+    double cpu = koniec.czasCPU - poczatek.czasCPU;
+    uint64_t ewaluacje = koniec.liczniki[0] - poczatek.liczniki[0];
+
+    out << "{\n";
+    out << "  \"solver\": \"" << nazwa << "\",\n";
+    out << "  \"run\": " << numer << ",\n";
+    out << "  \"wall_s\": " << wall << ",\n";
+    out << "  \"cpu_s\": " << cpu << ",\n";
+    out << "  \"cpu_utilization\": " << (wall > 0 ? cpu / wall : 0.0) << ",\n";
+    out << "  \"peak_rss_kb\": " << szczytowaPamiecKB() << ",\n";
+    out << "  \"evals_per_sec\": " << (wall > 0 ? ewaluacje / wall : 0.0) << ",\n";
+
+    out << "  \"counters\": {";
+    for (int i = 0; i < LICZBA_LICZNIKOW; ++i)
+        out << (i ? ", " : " ") << "\"" << NAZWY_LICZNIKOW[i] << "\": " << koniec.liczniki[i] - poczatek.liczniki[i];
+    out << " },\n";
+
+    // Czas poza wszystkimi fazami to "other"
+    double wFazach = 0.0;
+    out << "  \"phases_s\": {";
+    for (int i = 0; i < LICZBA_FAZ; ++i)
+    {
+        double s = (koniec.czasFaz[i] - poczatek.czasFaz[i]) * 1e-9;
+        wFazach += s;
+        out << (i ? ", " : " ") << "\"" << NAZWY_FAZ[i] << "\": " << s;
+    }
+    out << ", \"other\": " << (wall > wFazach ? wall - wFazach : 0.0) << " }\n";
+    out << "}\n";
+    return true;
+}
+
+void RejestrMetryk::uruchomProbkowanie(const std::string& plik, int interwalMs)
+{
+    zatrzymajProbkowanie();
+    {
+        std::lock_guard<std::mutex> lock(mutexProbkowania);
+        koniecProbkowania = false;
+    }
+    watekProbkowania = std::thread(&RejestrMetryk::petlaProbkowania, this, plik, interwalMs);
+}
+
+void RejestrMetryk::zatrzymajProbkowanie()
+{
+    if (!watekProbkowania.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutexProbkowania);
+        koniecProbkowania = true;
+    }
+    warunekProbkowania.notify_one();
+    watekProbkowania.join();
+}
+
+void RejestrMetryk::petlaProbkowania(std::string plik, int interwalMs)
+{
+    std::ofstream out(plik, std::ios::app);
+    if (!out.is_open())
+    {
+        std::cerr << "Nie mozna otworzyc pliku do zapisu: " << plik << "\n";
+        return;
+    }
+
+    MigawkaMetryk poprzednia = migawka();
+    std::unique_lock<std::mutex> lock(mutexProbkowania);
+    while (!warunekProbkowania.wait_for(lock, std::chrono::milliseconds(interwalMs), [this] { return koniecProbkowania; }))
+    {
+        lock.unlock();
+        MigawkaMetryk m = migawka();
+        std::string nazwa;
+        {
+            std::lock_guard<std::mutex> lockRejestru(mutex);
+            nazwa = solver;
+        }
+
+        double dt = m.czasScienny - poprzednia.czasScienny;
+        out << "{\"t_s\": " << m.czasScienny << ", \"solver\": \"" << nazwa << "\"";
+        for (int i = 0; i < LICZBA_LICZNIKOW; ++i)
+            out << ", \"" << NAZWY_LICZNIKOW[i] << "\": " << m.liczniki[i];
+        out << ", \"evals_per_sec\": " << (dt > 0 ? (m.liczniki[0] - poprzednia.liczniki[0]) / dt : 0.0)
+            << ", \"cpu_utilization\": " << (dt > 0 ? (m.czasCPU - poprzednia.czasCPU) / dt : 0.0)
+            << ", \"peak_rss_kb\": " << szczytowaPamiecKB() << "}\n";
+        out.flush();
+
+        poprzednia = m;
+        lock.lock();
+    }
+}
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+// Metryki solverów: liczniki i czasy faz liczone w wątkach bez blokad, zbierane przez rejestr.
+// Kompilacja z -DJSSP_METRYKI=0 usuwa całą instrumentację z pętli solverów (makra są puste).
+#ifndef JSSP_METRYKI
+#define JSSP_METRYKI 1
+#endif
+
+#if JSSP_METRYKI
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+enum class LicznikMetryk
+{
+    Ewaluacje,
+    ZaakceptowaneRuchy,
+    Poprawy,
+    Restarty,
+    OdcieteEwaluacje, // ewaluacje przerwane po przekroczeniu progu (część Ewaluacje)
+    Liczba
+};
+
+// Fazy są rozłączne: faza zagnieżdżona (np. dekodowanie w trakcie przeglądu sąsiedztwa)
+// wstrzymuje pomiar fazy zewnętrznej
+enum class FazaMetryk
+{
+    Dekodowanie,
+    Sasiedztwo,
+    Selekcja,
+    Logowanie,
+    Liczba
+};
+
+const int LICZBA_LICZNIKOW = static_cast<int>(LicznikMetryk::Liczba);
+const int LICZBA_FAZ = static_cast<int>(FazaMetryk::Liczba);
+
+// Liczniki jednego wątku. Pisze tylko właściciel (load + store, bez operacji atomowych RMW),
+// czyta rejestr przy podsumowaniu i wątek próbkujący.
+struct BlokLicznikow
+{
+    std::atomic<uint64_t> liczniki[LICZBA_LICZNIKOW];
+    std::atomic<uint64_t> czasFaz[LICZBA_FAZ]; // ns
+
+    // Stan pomiaru faz – używany wyłącznie przez właściciela
+    int aktywnaFaza;
+    uint64_t znacznik;
+
+    BlokLicznikow();
+};
+
+// Suma liczników ze wszystkich wątków w danej chwili
+struct MigawkaMetryk
+{
+    uint64_t liczniki[LICZBA_LICZNIKOW];
+    uint64_t czasFaz[LICZBA_FAZ];
+    double czasScienny; // s od startu procesu
+    double czasCPU;     // s procesora (wszystkie wątki)
+};
+
+class RejestrMetryk
+{
+public:
+    static RejestrMetryk& instancja();
+
+    // Blok dla bieżącego wątku: zwolniony przez zakończony wątek albo nowy. Przy końcu wątku
+    // jego liczniki trafiają do sumy zakończonych, a blok wraca do puli – pule wątków tworzone
+    // na każde żądanie (tryb serwera) nie powiększają rejestru.
+    BlokLicznikow* zarejestrujWatek();
+    void zwolnijWatek(BlokLicznikow* blok);
+    MigawkaMetryk migawka() const;
+
+    // Run = jedno solve(); wynik to różnica migawek z początku i końca
+    void rozpocznijRun(const std::string& solver, int run);
+    bool zakonczRun(const std::string& plikJSON);
+
+    // Okresowe próbki (JSON lines) w osobnym wątku
+    void uruchomProbkowanie(const std::string& plik, int interwalMs);
+    void zatrzymajProbkowanie();
+
+    ~RejestrMetryk();
+
+private:
+    RejestrMetryk();
+    void petlaProbkowania(std::string plik, int interwalMs);
+
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<BlokLicznikow>> bloki; // żyją do końca programu
+    std::vector<BlokLicznikow*> wolneBloki;            // po zakończonych wątkach, wyzerowane
+    uint64_t licznikiZakonczonych[LICZBA_LICZNIKOW];
+    uint64_t czasFazZakonczonych[LICZBA_FAZ];
+
+    std::string solver;
+    int run;
+    MigawkaMetryk poczatekRunu;
+
+    std::mutex mutexProbkowania;
+    std::condition_variable warunekProbkowania;
+    bool koniecProbkowania;
+    std::thread watekProbkowania;
+};
+
+uint64_t czasNs();
+uint64_t szczytowaPamiecKB();
+
+inline thread_local BlokLicznikow* blokWatku = nullptr;
+
+inline BlokLicznikow& blokBiezacegoWatku()
+{
+    if (blokWatku == nullptr)
+        blokWatku = RejestrMetryk::instancja().zarejestrujWatek();
+    return *blokWatku;
+}
+
+inline void dodajMetryke(LicznikMetryk licznik, uint64_t ile)
+{
+    std::atomic<uint64_t>& l = blokBiezacegoWatku().liczniki[static_cast<int>(licznik)];
+    l.store(l.load(std::memory_order_relaxed) + ile, std::memory_order_relaxed);
+}
+
+// Mierzy czas od konstrukcji do destrukcji jako czas danej fazy
+class PomiarFazy
+{
+public:
+    explicit PomiarFazy(FazaMetryk faza);
+    ~PomiarFazy();
+
+private:
+    BlokLicznikow& blok;
+    int poprzednia;
+};
+
+inline void doliczCzasFazy(BlokLicznikow& blok, uint64_t teraz)
+{
+    if (blok.aktywnaFaza >= 0)
+    {
+        std::atomic<uint64_t>& c = blok.czasFaz[blok.aktywnaFaza];
+        c.store(c.load(std::memory_order_relaxed) + (teraz - blok.znacznik), std::memory_order_relaxed);
+    }
+    blok.znacznik = teraz;
+}
+
+inline PomiarFazy::PomiarFazy(FazaMetryk faza)
+    : blok(blokBiezacegoWatku()), poprzednia(blok.aktywnaFaza)
+{
+    doliczCzasFazy(blok, czasNs());
+    blok.aktywnaFaza = static_cast<int>(faza);
+}
+
+inline PomiarFazy::~PomiarFazy()
+{
+    doliczCzasFazy(blok, czasNs());
+    blok.aktywnaFaza = poprzednia;
+}
+
+#define METRYKI_SKLEJ2(a, b) a##b
+#define METRYKI_SKLEJ(a, b) METRYKI_SKLEJ2(a, b)
+
+#define METRYKA_DODAJ(licznik, ile) dodajMetryke(LicznikMetryk::licznik, (ile))
+#define METRYKA_FAZA(faza) PomiarFazy METRYKI_SKLEJ(pomiarFazy, __LINE__)(FazaMetryk::faza)
+#define METRYKI_ROZPOCZNIJ_RUN(solver, run) RejestrMetryk::instancja().rozpocznijRun((solver), (run))
+#define METRYKI_ZAKONCZ_RUN(plik) RejestrMetryk::instancja().zakonczRun(plik)
+#define METRYKI_PROBKUJ(plik, interwalMs) RejestrMetryk::instancja().uruchomProbkowanie((plik), (interwalMs))
+#define METRYKI_ZATRZYMAJ_PROBKOWANIE() RejestrMetryk::instancja().zatrzymajProbkowanie()
+
+#else // JSSP_METRYKI
+
+#define METRYKA_DODAJ(licznik, ile) ((void)0)
+#define METRYKA_FAZA(faza) ((void)0)
+#define METRYKI_ROZPOCZNIJ_RUN(solver, run) ((void)0)
+#define METRYKI_ZAKONCZ_RUN(plik) ((void)0)
+#define METRYKI_PROBKUJ(plik, interwalMs) ((void)0)
+#define METRYKI_ZATRZYMAJ_PROBKOWANIE() ((void)0)
+#endif
+
+#endif
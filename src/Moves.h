@@ -0,0 +1,82 @@
+#ifndef MOVES_H
+#define MOVES_H
+
+#include "EvaluationCache.h"
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+// Ruchy na genotypie wykonywane w miejscu: zastosuj -> oceń -> (odrzucony) cofnij.
+// Zamiana kosztuje O(1), wstawienie i odwrócenie O(|j - i|) – bez kopii całego genotypu.
+// Każdy ruch zachowuje multizbiór genów, więc działa w obu kodowaniach.
+enum class RodzajRuchu
+{
+    Zamiana,     // zamiana genów na pozycjach i, j
+    Wstawienie,  // gen z pozycji i przeniesiony na pozycję j (reszta przesunięta o jeden)
+    Odwrocenie   // odwrócenie fragmentu [min(i, j), max(i, j)]
+};
+const int LICZBA_RODZAJOW_RUCHU = 3;
+
+struct Ruch
+{
+    RodzajRuchu rodzaj;
+    int i;
+    int j;
+};
+
+inline void przesunGen(std::vector<int>& genotyp, int z, int na)
+{
+    if (z < na)
+        std::rotate(genotyp.begin() + z, genotyp.begin() + z + 1, genotyp.begin() + na + 1);
+    else if (na < z)
+        std::rotate(genotyp.begin() + na, genotyp.begin() + z, genotyp.begin() + z + 1);
+}
+
+inline void odwrocFragment(std::vector<int>& genotyp, int i, int j)
+{
+    std::reverse(genotyp.begin() + std::min(i, j), genotyp.begin() + std::max(i, j) + 1);
+}
+
+// Hash Zobrista fragmentu [od, do] – XOR przed i po ruchu aktualizuje hash całego genotypu
+inline uint64_t hashFragmentu(const std::vector<int>& genotyp, int od, int doPozycji)
+{
+    uint64_t h = 0;
+    for (int p = od; p <= doPozycji; ++p)
+        h ^= EvaluationCache::zobrist(p, genotyp[p]);
+    return h;
+}
+
+// Wykonuje ruch; jeśli hash != nullptr, aktualizuje go (EvaluationCache::hashGenotypu) bez liczenia od nowa
+inline void zastosujRuch(std::vector<int>& genotyp, const Ruch& r, uint64_t* hash = nullptr)
+{
+    if (r.rodzaj == RodzajRuchu::Zamiana)
+    {
+        if (hash != nullptr)
+            *hash = EvaluationCache::hashPoZamianie(*hash, r.i, r.j, genotyp[r.i], genotyp[r.j]);
+        std::swap(genotyp[r.i], genotyp[r.j]);
+        return;
+    }
+
+    int od = std::min(r.i, r.j), doPozycji = std::max(r.i, r.j);
+    if (hash != nullptr)
+        *hash ^= hashFragmentu(genotyp, od, doPozycji);
+    if (r.rodzaj == RodzajRuchu::Wstawienie)
+        przesunGen(genotyp, r.i, r.j);
+    else
+        odwrocFragment(genotyp, r.i, r.j);
+    if (hash != nullptr)
+        *hash ^= hashFragmentu(genotyp, od, doPozycji);
+}
+
+// Odwrotność zastosujRuch (zamiana i odwrócenie są inwolucjami, wstawienie cofa wstawienie j -> i)
+inline void cofnijRuch(std::vector<int>& genotyp, const Ruch& r)
+{
+    if (r.rodzaj == RodzajRuchu::Zamiana)
+        std::swap(genotyp[r.i], genotyp[r.j]);
+    else if (r.rodzaj == RodzajRuchu::Wstawienie)
+        przesunGen(genotyp, r.j, r.i);
+    else
+        odwrocFragment(genotyp, r.i, r.j);
+}
+
+#endif
@@ -0,0 +1,268 @@
+#include "PathRelinking.h"
+#include "SolutionArchive.h"
+#include "Checkpoint.h"
+#include "Metrics.h"
+#include <algorithm>
+#include <limits>
+
+// ===== ElitePool =====
+
+bool ElitePool::dodaj(const std::vector<int>& genotyp, int koszt, uint64_t podpis)
+{
+    if (genotyp.empty() || pojemnosc <= 0)
+        return false;
+    if (std::find(podpisy.begin(), podpisy.end(), podpis) != podpisy.end())
+        return false;
+
+    if ((int)genotypy.size() < pojemnosc)
+    {
+        genotypy.push_back(genotyp);
+        koszty.push_back(koszt);
+        podpisy.push_back(podpis);
+        return true;
+    }
+
+    int najgorszy = (int)(std::max_element(koszty.begin(), koszty.end()) - koszty.begin());
+    if (koszt >= koszty[najgorszy])
+        return false;
+    genotypy[najgorszy] = genotyp;
+    koszty[najgorszy] = koszt;
+    podpisy[najgorszy] = podpis;
+    return true;
+}
+
+void ElitePool::zapisz(BuforZapisu& b) const
+{
+    b.piszInt((int)genotypy.size());
+    for (int i = 0; i < (int)genotypy.size(); ++i)
+    {
+        b.piszWektor(genotypy[i]);
+        b.piszInt(koszty[i]);
+        b.piszU64(podpisy[i]);
+    }
+}
+
+void ElitePool::wczytaj(BuforOdczytu& b)
+{
+    wyczysc();
+    int n = b.czytajInt();
+    for (int i = 0; i < n && b.ok(); ++i)
+    {
+        std::vector<int> g;
+        b.czytajWektor(g);
+        int koszt = b.czytajInt();
+        uint64_t podpis = b.czytajU64();
+        genotypy.push_back(g);
+        koszty.push_back(koszt);
+        podpisy.push_back(podpis);
+    }
+}
+
+// ===== PathRelinking =====
+
+PathRelinking::PathRelinking(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                             TrybDekodera tryb, Kodowanie kodowanie)
+    : operacje(operacje), liczbaJobow(liczbaJobow), liczbaMaszyn(liczbaMaszyn), kodowanie(kodowanie),
+      dekoder(operacje, liczbaJobow, liczbaMaszyn, tryb, kodowanie)
+{
+    const int N = operacje.size();
+    indeks.assign(liczbaJobow, std::vector<int>());
+    for (int i = 0; i < N; ++i)
+    {
+        const OperationSchedule& op = operacje[i];
+        if (op.operation_id >= (int)indeks[op.job_id].size())
+            indeks[op.job_id].resize(op.operation_id + 1, -1);
+        indeks[op.job_id][op.operation_id] = i;
+    }
+    poprzednikJoba.assign(N, -1);
+    nastepnikJoba.assign(N, -1);
+    for (int i = 0; i < N; ++i)
+        if (operacje[i].operation_id > 0)
+        {
+            int p = indeks[operacje[i].job_id][operacje[i].operation_id - 1];
+            poprzednikJoba[i] = p;
+            nastepnikJoba[p] = i;
+        }
+
+    pozycjaA.resize(N);
+    nastepnikMaszyny.resize(N);
+    stopien.resize(N);
+    glowa.resize(N);
+    kolejka.resize(N);
+    porzadek.resize(N);
+}
+
+void PathRelinking::sekwencje(const std::vector<int>& genotyp, std::vector<std::vector<int>>& sek)
+{
+    dekoder.dekoduj(genotyp, &harmonogram);
+    for (int k = 0; k < (int)harmonogram.size(); ++k)
+    {
+        int i = indeks[harmonogram[k].job_id][harmonogram[k].operation_id];
+        kolejka[k] = i;
+        glowa[i] = harmonogram[k].start_time;
+    }
+    // Przy wstawianiu w luki kolejność planowania nie jest kolejnością na maszynie
+    std::stable_sort(kolejka.begin(), kolejka.end(), [&](int a, int b) { return glowa[a] < glowa[b]; });
+
+    sek.assign(liczbaMaszyn, std::vector<int>());
+    for (int i : kolejka)
+        sek[operacje[i].machine_id].push_back(i);
+}
+
+int PathRelinking::ocenSekwencje(const std::vector<std::vector<int>>& sek)
+{
+    const int N = operacje.size();
+    std::fill(nastepnikMaszyny.begin(), nastepnikMaszyny.end(), -1);
+    for (int i = 0; i < N; ++i)
+    {
+        stopien[i] = (poprzednikJoba[i] >= 0) ? 1 : 0;
+        glowa[i] = 0;
+    }
+    for (const std::vector<int>& s : sek)
+        for (int p = 1; p < (int)s.size(); ++p)
+        {
+            nastepnikMaszyny[s[p - 1]] = s[p];
+            ++stopien[s[p]];
+        }
+
+    // Kahn: kolejność topologiczna i najwcześniejsze starty w jednym przejściu
+    int poczatek = 0, koniecKolejki = 0;
+    for (int i = 0; i < N; ++i)
+        if (stopien[i] == 0)
+            kolejka[koniecKolejki++] = i;
+
+    int makespan = 0;
+    while (poczatek < koniecKolejki)
+    {
+        int i = kolejka[poczatek];
+        porzadek[poczatek++] = i;
+        int k = glowa[i] + operacje[i].processing_time;
+        makespan = std::max(makespan, k);
+        for (int n : { nastepnikJoba[i], nastepnikMaszyny[i] })
+        {
+            if (n < 0)
+                continue;
+            glowa[n] = std::max(glowa[n], k);
+            if (--stopien[n] == 0)
+                kolejka[koniecKolejki++] = n;
+        }
+    }
+    return (poczatek == N) ? makespan : -1; // nieprzetworzone operacje leżą na cyklu
+}
+
+int PathRelinking::relinkuj(const std::vector<int>& poczatek, const std::vector<int>& cel, std::vector<int>& wynik)
+{
+    METRYKA_FAZA(Sasiedztwo);
+    sekwencje(cel, sekB);
+    sekwencje(poczatek, sekA);
+
+    int roznice = 0;
+    for (int m = 0; m < liczbaMaszyn; ++m)
+        for (int p = 0; p < (int)sekA[m].size(); ++p)
+        {
+            pozycjaA[sekA[m][p]] = p;
+            if (sekA[m][p] != sekB[m][p])
+                ++roznice;
+        }
+    // Środkowa połowa ścieżki musi zawierać choć jeden punkt
+    const int odleglosc = roznice;
+    const int odKonca = std::max(1, odleglosc / 4);
+    if (odleglosc < 6)
+        return -1;
+
+    std::vector<int> pierwszaRoznica(liczbaMaszyn, 0);
+    int najlepszyKoszt = std::numeric_limits<int>::max();
+    najlepszyPorzadek.clear();
+
+    while (roznice > 0)
+    {
+        // Kandydaci: na każdej maszynie pierwsza pozycja różna od celu
+        int wybrana = -1;
+        int kosztWybranej = std::numeric_limits<int>::max();
+        for (int m = 0; m < liczbaMaszyn; ++m)
+        {
+            int& p = pierwszaRoznica[m];
+            while (p < (int)sekA[m].size() && sekA[m][p] == sekB[m][p])
+                ++p;
+            if (p == (int)sekA[m].size())
+                continue;
+
+            int q = pozycjaA[sekB[m][p]];
+            std::swap(sekA[m][p], sekA[m][q]);
+            int koszt = ocenSekwencje(sekA);
+            std::swap(sekA[m][p], sekA[m][q]); // cofnięcie ruchu
+            METRYKA_DODAJ(Ewaluacje, 1);
+
+            if (wybrana < 0 || (koszt >= 0 && (kosztWybranej < 0 || koszt < kosztWybranej)))
+            {
+                wybrana = m;
+                kosztWybranej = koszt;
+            }
+        }
+        if (wybrana < 0)
+            break;
+
+        // Wszystkie zamiany dają cykl – idziemy dalej przez rozwiązanie niedopuszczalne
+        int m = wybrana;
+        int p = pierwszaRoznica[m];
+        int q = pozycjaA[sekB[m][p]];
+        std::swap(sekA[m][p], sekA[m][q]);
+        pozycjaA[sekA[m][p]] = p;
+        pozycjaA[sekA[m][q]] = q;
+        roznice -= (sekA[m][q] == sekB[m][q]) ? 2 : 1;
+
+        bool srodek = roznice >= odKonca && odleglosc - roznice >= odKonca;
+        if (srodek && kosztWybranej >= 0 && kosztWybranej < najlepszyKoszt)
+        {
+            najlepszyKoszt = ocenSekwencje(sekA);
+            najlepszyPorzadek = porzadek;
+        }
+    }
+
+    if (najlepszyPorzadek.empty())
+        return -1;
+    wynik = genotypZKolejnosci(operacje, najlepszyPorzadek, kodowanie);
+    return dekoder.dekoduj(wynik);
+}
+
+uint64_t PathRelinking::podpis(const std::vector<int>& genotyp)
+{
+    sekwencje(genotyp, sekA);
+    uint64_t h = 1469598103934665603ULL; // FNV-1a
+    for (const std::vector<int>& s : sekA)
+        for (int i : s)
+        {
+            h ^= (uint64_t)i;
+            h *= 1099511628211ULL;
+        }
+    return h;
+}
+
+// ===== PathRelinkingPool =====
+
+PathRelinkingPool::PathRelinkingPool(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                                     TrybDekodera tryb, Kodowanie kodowanie, int watki)
+    : pula(watki)
+{
+    for (int w = 0; w < pula.getLiczbaWatkow(); ++w)
+        przestrzenie.emplace_back(new PathRelinking(operacje, liczbaJobow, liczbaMaszyn, tryb, kodowanie));
+}
+
+int PathRelinkingPool::najlepszy(const std::vector<std::pair<const std::vector<int>*, const std::vector<int>*>>& pary,
+                                 std::vector<int>& wynik)
+{
+    std::vector<std::vector<int>> wyniki(pary.size());
+    std::vector<int> koszty(pary.size(), -1);
+    pula.rownolegle((int)pary.size(), [&](int k, int watek) {
+        koszty[k] = przestrzenie[watek]->relinkuj(*pary[k].first, *pary[k].second, wyniki[k]);
+    });
+
+    int najlepsza = -1;
+    for (int k = 0; k < (int)pary.size(); ++k)
+        if (koszty[k] >= 0 && (najlepsza < 0 || koszty[k] < koszty[najlepsza]))
+            najlepsza = k;
+    if (najlepsza < 0)
+        return -1;
+    wynik.swap(wyniki[najlepsza]);
+    return koszty[najlepsza];
+}
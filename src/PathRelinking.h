@@ -0,0 +1,106 @@
+#ifndef PATH_RELINKING_H
+#define PATH_RELINKING_H
+
+#include "OperationSchedule.h"
+#include "ScheduleDecoder.h"
+#include "ThreadPool.h"
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+class BuforZapisu;
+class BuforOdczytu;
+
+// Co robi przeszukiwanie po zbyt długim braku poprawy
+enum class Dywersyfikacja
+{
+    LosowyRestart,  // losowa permutacja genotypu
+    PathRelinking   // najlepszy punkt pośredni między rozwiązaniami z puli elitarnej
+};
+
+// Pula najlepszych, wzajemnie różnych rozwiązań – materiał do path relinkingu.
+// Różne genotypy mogą dawać ten sam harmonogram, więc o powtórzeniu decyduje podpis sekwencji maszyn.
+class ElitePool
+{
+public:
+    explicit ElitePool(int pojemnosc = 10) : pojemnosc(pojemnosc) {}
+
+    // Dodaje rozwiązanie, jeśli podpisu jeszcze nie ma i pula ma miejsce albo jest lepsze od najgorszego
+    bool dodaj(const std::vector<int>& genotyp, int koszt, uint64_t podpis);
+
+    int rozmiar() const { return (int)genotypy.size(); }
+    const std::vector<int>& genotyp(int i) const { return genotypy[i]; }
+    int koszt(int i) const { return koszty[i]; }
+    void wyczysc() { genotypy.clear(); koszty.clear(); podpisy.clear(); }
+
+    void zapisz(BuforZapisu& b) const;
+    void wczytaj(BuforOdczytu& b);
+
+private:
+    int pojemnosc;
+    std::vector<std::vector<int>> genotypy;
+    std::vector<int> koszty;
+    std::vector<uint64_t> podpisy;
+};
+
+// Path relinking w przestrzeni sekwencji maszyn: rozwiązanie początkowe dochodzi do docelowego
+// zamianami operacji na maszynach (każda ustawia jedną pozycję tak jak w rozwiązaniu docelowym).
+// W każdym kroku wybierana jest najlepsza z takich zamian (po jednej na maszynę). Rozwiązania
+// pośrednie są oceniane najdłuższą ścieżką w grafie (O(N), bez dekodowania), zamiany tworzące cykl
+// są pomijane. Wynikiem jest najlepszy punkt ze środkowej połowy ścieżki – punkty tuż przy końcach
+// to w praktyce te same minima lokalne. Obiekt to bufory robocze jednego wątku.
+class PathRelinking
+{
+public:
+    PathRelinking(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                  TrybDekodera tryb, Kodowanie kodowanie);
+
+    // Najlepsze rozwiązanie pośrednie (bez końców ścieżki) jako genotyp w kodowaniu solvera;
+    // zwraca jego makespan wg dekodera albo -1, gdy rozwiązania są zbyt bliskie
+    int relinkuj(const std::vector<int>& poczatek, const std::vector<int>& cel, std::vector<int>& wynik);
+
+    // Hash sekwencji maszyn zdekodowanego genotypu (ten sam harmonogram = ten sam podpis)
+    uint64_t podpis(const std::vector<int>& genotyp);
+
+private:
+    void sekwencje(const std::vector<int>& genotyp, std::vector<std::vector<int>>& sek);
+    // Makespan dla sekwencji maszyn (-1 przy cyklu); kolejność topologiczna trafia do "porzadek"
+    int ocenSekwencje(const std::vector<std::vector<int>>& sek);
+
+    std::vector<OperationSchedule> operacje;
+    int liczbaJobow;
+    int liczbaMaszyn;
+    Kodowanie kodowanie;
+    ScheduleDecoder dekoder;
+
+    std::vector<int> poprzednikJoba;
+    std::vector<int> nastepnikJoba;
+    std::vector<std::vector<int>> indeks; // [job][operacja] -> indeks operacji
+
+    // Bufory robocze
+    std::vector<OperationSchedule> harmonogram;
+    std::vector<std::vector<int>> sekA, sekB;
+    std::vector<int> pozycjaA;
+    std::vector<int> nastepnikMaszyny, stopien, glowa, kolejka, porzadek, najlepszyPorzadek;
+};
+
+// Kilka par relinkowanych naraz w puli wątków, z osobnym PathRelinking na wątek
+class PathRelinkingPool
+{
+public:
+    PathRelinkingPool(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                      TrybDekodera tryb, Kodowanie kodowanie, int watki = 0);
+
+    // Najlepszy punkt pośredni ze wszystkich par (poczatek, cel); -1, gdy żadna para nie dała wyniku.
+    // Wynik nie zależy od liczby wątków (remisy rozstrzyga numer pary).
+    int najlepszy(const std::vector<std::pair<const std::vector<int>*, const std::vector<int>*>>& pary,
+                  std::vector<int>& wynik);
+
+    uint64_t podpis(const std::vector<int>& genotyp) { return przestrzenie[0]->podpis(genotyp); }
+
+private:
+    PulaWatkow pula;
+    std::vector<std::unique_ptr<PathRelinking>> przestrzenie;
+};
+
+#endif
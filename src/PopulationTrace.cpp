@@ -0,0 +1,317 @@
+#include "PopulationTrace.h"
+#include "Log.h"
+#include <cstring>
+#include <cstdint>
+
+static const char MAGIC_SLADU[7] = { 'J', 'S', 'S', 'P', 'T', 'R', 'C' };
+static const int WERSJA_SLADU = 1;
+static const std::size_t MAKS_KOLEJKA = 4; // pokolenia czekające na zapis
+
+enum TrybGenotypu : char { Pelny = 0, WzgledemPoprzedniego = 1, WzgledemPozycji = 2 };
+
+static void piszVarint(std::vector<char>& out, uint64_t v)
+{
+    while (v >= 0x80)
+    {
+        out.push_back(static_cast<char>((v & 0x7F) | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<char>(v));
+}
+
+static void piszZigzag(std::vector<char>& out, int64_t v)
+{
+    piszVarint(out, (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+}
+
+// Zmienione geny jako (odstęp od poprzedniej zmiany, wartość)
+static void kodujRoznice(std::vector<char>& out, const int* g, const int* wzorzec, int n)
+{
+    int zmian = 0;
+    for (int i = 0; i < n; ++i)
+        zmian += (g[i] != wzorzec[i]);
+    piszVarint(out, zmian);
+    int ostatni = -1;
+    for (int i = 0; i < n; ++i)
+    {
+        if (g[i] == wzorzec[i])
+            continue;
+        piszVarint(out, i - ostatni - 1);
+        piszZigzag(out, g[i]);
+        ostatni = i;
+    }
+}
+
+// ===== PopulationTrace =====
+
+PopulationTrace::PopulationTrace(const std::string& sciezka, int dlugoscGenotypu, bool dopisz)
+    : buforPliku(1 << 20), otwarty(false), dlugosc(dlugoscGenotypu), osobnikowPoprzednio(0),
+      zapisuje(false), koniec(false)
+{
+    plik.rdbuf()->pubsetbuf(buforPliku.data(), buforPliku.size());
+    plik.open(sciezka, std::ios::binary | (dopisz ? std::ios::app : std::ios::trunc));
+    if (!plik.is_open())
+    {
+        LOG_BLAD(Populacja, "Nie mozna otworzyc pliku sladu populacji: " << sciezka);
+        return;
+    }
+    otwarty = true;
+
+    std::vector<char> naglowek(MAGIC_SLADU, MAGIC_SLADU + sizeof(MAGIC_SLADU));
+    piszVarint(naglowek, WERSJA_SLADU);
+    piszVarint(naglowek, dlugosc);
+    plik.write(naglowek.data(), naglowek.size());
+
+    watek = std::thread(&PopulationTrace::petla, this);
+}
+
+PopulationTrace::~PopulationTrace()
+{
+    if (!otwarty)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        koniec = true;
+    }
+    warunek.notify_all();
+    watek.join();
+    plik.flush();
+}
+
+void PopulationTrace::zlec(ProbkaPokolenia& probka)
+{
+    if (!otwarty)
+        return;
+    std::unique_lock<std::mutex> lock(mutex);
+    warunek.wait(lock, [this] { return kolejka.size() < MAKS_KOLEJKA; });
+    kolejka.emplace_back();
+    kolejka.back().pokolenie = probka.pokolenie;
+    kolejka.back().pozycje.swap(probka.pozycje);
+    kolejka.back().fitness.swap(probka.fitness);
+    kolejka.back().geny.swap(probka.geny);
+    lock.unlock();
+    warunek.notify_all();
+}
+
+void PopulationTrace::oproznij()
+{
+    if (!otwarty)
+        return;
+    std::unique_lock<std::mutex> lock(mutex);
+    warunek.wait(lock, [this] { return kolejka.empty() && !zapisuje; });
+    plik.flush();
+}
+
+void PopulationTrace::petla()
+{
+    ProbkaPokolenia probka;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        warunek.wait(lock, [this] { return !kolejka.empty() || koniec; });
+        if (kolejka.empty())
+            return; // koniec i nic do zapisania
+
+        probka = std::move(kolejka.front());
+        kolejka.pop_front();
+        zapisuje = true;
+
+        lock.unlock();
+        koduj(probka);
+        plik.write(wyjscie.data(), wyjscie.size());
+        lock.lock();
+
+        zapisuje = false;
+        warunek.notify_all();
+    }
+}
+
+void PopulationTrace::koduj(const ProbkaPokolenia& probka)
+{
+    const int n = probka.pozycje.size();
+    wyjscie.clear();
+    wyjscie.push_back('G');
+    piszVarint(wyjscie, probka.pokolenie);
+    piszVarint(wyjscie, n);
+
+    std::vector<char> pelny, roznica;
+    for (int k = 0; k < n; ++k)
+    {
+        const int* g = probka.geny.data() + (std::size_t)k * dlugosc;
+        piszVarint(wyjscie, probka.pozycje[k]);
+        piszZigzag(wyjscie, probka.fitness[k]);
+
+        // pelny kończy z najkrótszą postacią genotypu
+        pelny.clear();
+        for (int i = 0; i < dlugosc; ++i)
+            piszZigzag(pelny, g[i]);
+        char tryb = Pelny;
+
+        if (k > 0)
+        {
+            roznica.clear();
+            kodujRoznice(roznica, g, g - dlugosc, dlugosc);
+            if (roznica.size() < pelny.size())
+            {
+                tryb = WzgledemPoprzedniego;
+                pelny.swap(roznica);
+            }
+        }
+        if (k < osobnikowPoprzednio)
+        {
+            roznica.clear();
+            kodujRoznice(roznica, g, poprzedniRekord.data() + (std::size_t)k * dlugosc, dlugosc);
+            if (roznica.size() < pelny.size())
+            {
+                tryb = WzgledemPozycji;
+                pelny.swap(roznica);
+            }
+        }
+
+        wyjscie.push_back(tryb);
+        wyjscie.insert(wyjscie.end(), pelny.begin(), pelny.end());
+    }
+
+    poprzedniRekord = probka.geny;
+    osobnikowPoprzednio = n;
+}
+
+// ===== Odczyt =====
+
+namespace
+{
+class CzytnikSladu
+{
+public:
+    explicit CzytnikSladu(std::istream& in) : in(in), blad(false) {}
+
+    bool bajt(char& c)
+    {
+        if (!in.get(c)) { blad = true; return false; }
+        return true;
+    }
+    uint64_t varint()
+    {
+        uint64_t v = 0;
+        char c;
+        for (int przesuniecie = 0; przesuniecie < 64 && bajt(c); przesuniecie += 7)
+        {
+            v |= static_cast<uint64_t>(static_cast<unsigned char>(c) & 0x7F) << przesuniecie;
+            if (!(c & 0x80))
+                return v;
+        }
+        blad = true;
+        return 0;
+    }
+    int64_t zigzag()
+    {
+        uint64_t v = varint();
+        return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+    }
+    void roznica(int* g, const int* wzorzec, int n)
+    {
+        std::memcpy(g, wzorzec, sizeof(int) * n);
+        uint64_t zmian = varint();
+        int pozycja = -1;
+        for (uint64_t z = 0; z < zmian && !blad; ++z)
+        {
+            pozycja += static_cast<int>(varint()) + 1;
+            int wartosc = static_cast<int>(zigzag());
+            if (pozycja < 0 || pozycja >= n) { blad = true; return; }
+            g[pozycja] = wartosc;
+        }
+    }
+
+    std::istream& in;
+    bool blad;
+};
+}
+
+bool rozwinSladPopulacji(const std::string& plikSladu, const std::string& plikCSV)
+{
+    std::ifstream in(plikSladu, std::ios::binary);
+    if (!in.is_open())
+    {
+        LOG_BLAD(Populacja, "Nie mozna otworzyc pliku sladu populacji: " << plikSladu);
+        return false;
+    }
+    std::ofstream out(plikCSV);
+    if (!out.is_open())
+    {
+        LOG_BLAD(Populacja, "Nie mozna otworzyc pliku: " << plikCSV);
+        return false;
+    }
+    out << "Pokolenie;Populacja;Fitness;Priorytety\n";
+
+    CzytnikSladu c(in);
+    int dlugosc = -1;
+    std::vector<int> rekord, poprzedni;
+    int osobnikowPoprzednio = 0;
+    long long pokolen = 0;
+    char znacznik;
+
+    while (in.get(znacznik))
+    {
+        if (znacznik == MAGIC_SLADU[0])
+        {
+            char magic[sizeof(MAGIC_SLADU) - 1];
+            if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC_SLADU + 1, sizeof(magic)) != 0 ||
+                c.varint() != WERSJA_SLADU)
+            {
+                LOG_BLAD(Populacja, "Plik " << plikSladu << " nie jest sladem populacji w obslugiwanej wersji");
+                return false;
+            }
+            dlugosc = static_cast<int>(c.varint());
+            osobnikowPoprzednio = 0; // nowy segment zaczyna kodowanie od zera
+            continue;
+        }
+        if (znacznik != 'G' || dlugosc < 0)
+        {
+            c.blad = true;
+            break;
+        }
+
+        int pokolenie = static_cast<int>(c.varint());
+        int n = static_cast<int>(c.varint());
+        if (c.blad)
+            break;
+        rekord.assign((std::size_t)n * dlugosc, 0);
+        for (int k = 0; k < n && !c.blad; ++k)
+        {
+            int pozycja = static_cast<int>(c.varint());
+            int fitness = static_cast<int>(c.zigzag());
+            char tryb = 0;
+            c.bajt(tryb);
+            int* g = rekord.data() + (std::size_t)k * dlugosc;
+
+            if (tryb == Pelny)
+                for (int i = 0; i < dlugosc; ++i)
+                    g[i] = static_cast<int>(c.zigzag());
+            else if (tryb == WzgledemPoprzedniego && k > 0)
+                c.roznica(g, g - dlugosc, dlugosc);
+            else if (tryb == WzgledemPozycji && k < osobnikowPoprzednio)
+                c.roznica(g, poprzedni.data() + (std::size_t)k * dlugosc, dlugosc);
+            else
+                c.blad = true;
+            if (c.blad)
+                break;
+
+            out << pokolenie << ";" << pozycja << ";" << fitness << ";";
+            for (int i = 0; i < dlugosc; ++i)
+            {
+                out << g[i];
+                if (i < dlugosc - 1) out << "-";
+            }
+            out << "\n";
+        }
+        if (c.blad)
+            break;
+        poprzedni.swap(rekord);
+        osobnikowPoprzednio = n;
+        ++pokolen;
+    }
+
+    if (c.blad)
+        LOG_OSTRZEZENIE(Populacja, "Slad " << plikSladu << " jest obciety albo uszkodzony – rozwinieto " << pokolen << " pokolen");
+    return !c.blad;
+}
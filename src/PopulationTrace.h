@@ -0,0 +1,68 @@
+#ifndef POPULATION_TRACE_H
+#define POPULATION_TRACE_H
+
+#include <vector>
+#include <string>
+#include <deque>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Ślad populacji EvolutionSolver zamiast pełnego ewolucyjny.csv.
+// Plik to ciąg segmentów (nowy przy każdym otwarciu, także po wznowieniu z checkpointu):
+//   "JSSPTRC" + wersja, długość genotypu, potem rekordy 'G': pokolenie, liczba osobników
+//   i dla każdego: pozycja w populacji, fitness, genotyp.
+// Genotyp jest zapisywany w całości albo jako lista zmienionych genów względem poprzedniego
+// osobnika w rekordzie lub osobnika z tej samej pozycji w poprzednim rekordzie – co wyjdzie krócej.
+// Wszystkie liczby jako varinty (LEB128, zigzag).
+
+// Próbka jednego pokolenia przekazywana do wątku zapisu
+struct ProbkaPokolenia
+{
+    int pokolenie = 0;
+    std::vector<int> pozycje;   // pozycje osobników w populacji
+    std::vector<int> fitness;
+    std::vector<int> geny;      // genotypy kolejnych osobników jeden za drugim
+};
+
+class PopulationTrace
+{
+public:
+    // dopisz = true dokleja nowy segment do istniejącego pliku (wznowienie)
+    PopulationTrace(const std::string& sciezka, int dlugoscGenotypu, bool dopisz);
+    ~PopulationTrace(); // zapisuje oczekujące próbki i kończy wątek
+
+    bool ok() const { return otwarty; }
+
+    // Przejmuje próbkę; czeka tylko wtedy, gdy w kolejce jest już kilka niezapisanych pokoleń
+    void zlec(ProbkaPokolenia& probka);
+    // Czeka, aż wszystkie zlecone próbki trafią na dysk (przed checkpointem)
+    void oproznij();
+
+private:
+    void petla();
+    void koduj(const ProbkaPokolenia& probka);
+
+    std::ofstream plik;
+    std::vector<char> buforPliku;
+    bool otwarty;
+    int dlugosc;
+
+    // stan kodowania różnicowego (tylko wątek zapisu)
+    std::vector<int> poprzedniRekord;
+    int osobnikowPoprzednio;
+    std::vector<char> wyjscie;
+
+    std::mutex mutex;
+    std::condition_variable warunek;
+    std::deque<ProbkaPokolenia> kolejka;
+    bool zapisuje;
+    bool koniec;
+    std::thread watek;
+};
+
+// Rozwija ślad do układu ewolucyjny.csv (Pokolenie;Populacja;Fitness;Priorytety)
+bool rozwinSladPopulacji(const std::string& plikSladu, const std::string& plikCSV);
+
+#endif
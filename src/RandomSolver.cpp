@@ -1,168 +1,363 @@
 #include "RandomSolver.h"
 #include "OperationSchedule.h"
+#include "ScheduleDecoder.h"
+#include "LowerBounds.h"
+#include "Checkpoint.h"
+#include "Metrics.h"
+#include "Log.h"
+#include "SolverEvents.h"
+#include "ResultWriter.h"
+#include "ThreadPool.h"
 #include <iostream>
 #include <fstream>
 #include <random>
 #include <algorithm>
 #include <numeric> // std::accumulate
-#include <fstream>
+#include <limits>
+#include <memory>
+#include <atomic>
 
 
 RandomSolver::RandomSolver(int liczbaProb)
-    : liczbaProb(liczbaProb), makespan(0)
+    : liczbaProb(liczbaProb), makespan(0), trybDekodera(TrybDekodera::Polaktywny),
+      kodowanie(Kodowanie::Priorytety), cel(0), dolneOgraniczenie(0),
+      gen(std::random_device{}()), watki(1), odcinanie(false), coIleCheckpoint(0)
 {}
 
 
+// Prób w paczce trybu równoległego – stała, żeby podział na paczki (i wynik) nie zależał od liczby wątków
+static const int rozmiarPaczki = 256;
+
 void RandomSolver::solve(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn)
 {
-    std::mt19937 gen(std::random_device{}());
+    if (watki != 1)
+    {
+        solveRownolegle(operacje, liczbaJobow, liczbaMaszyn);
+        return;
+    }
 
     // Ustawiamy początkowy makespan na bardzo dużą wartość (żeby każdy harmonogram był lepszy)
     makespan = std::numeric_limits<int>::max();
 
     // Czyścimy wektor kosztów prób (dla statystyk)
     kosztyProb.clear();
+    najlepszyGenotyp.clear();
+
+    // Jeden dekoder na cały solve – trzyma bufory robocze między próbami
+    ScheduleDecoder dekoder(operacje, liczbaJobow, liczbaMaszyn, trybDekodera, kodowanie);
 
-    // Liczba wszystkich operacji we wszystkich jobach
-    int liczbaOperacji = operacje.size();
+    // Genotyp bazowy: 0,1,2,...,N-1 albo numery jobów (dla kodowania z powtórzeniami)
+    std::vector<int> priorytety = genotypBazowy(operacje, kodowanie);
 
-    // Wykonujemy wiele prób (losowych harmonogramów)
-    for (int prob = 0; prob < liczbaProb; ++prob)
+    // Tasowanie jest przyrostowe, więc przy wznowieniu potrzebny jest też bieżący genotyp
+    int prob = 0;
+    uint64_t sumaInstancji = sumaKontrolnaInstancji(operacje, liczbaJobow, liczbaMaszyn);
+    if (!plikWznowienia.empty() && wczytajCheckpoint(sumaInstancji, prob, priorytety))
     {
+        if (!najlepszyGenotyp.empty())
+            dekoder.dekoduj(najlepszyGenotyp, &schedule);
+    }
+    else if (genotypStartowy.size() == priorytety.size())
+    {
+        makespan = dekoder.dekoduj(genotypStartowy, &schedule);
+        najlepszyGenotyp = genotypStartowy;
+    }
 
-        // === KROK 1: Skopiuj operacje i nadaj im losowe, unikalne priorytety ===
-        std::vector<OperationSchedule> kandydaci = operacje;
+    std::unique_ptr<CheckpointWriter> zapis;
+    if (!plikCheckpointu.empty())
+        zapis.reset(new CheckpointWriter(plikCheckpointu));
 
-        // Tworzymy wektor liczb 0,1,2,...,N-1
-        std::vector<int> priorytety(liczbaOperacji);
-        for (int i = 0; i < liczbaOperacji; ++i)
+    // Wykonujemy wiele prób (losowych harmonogramów); po osiągnięciu celu (np. znanego optimum)
+    // dalsze próby nic nie dadzą
+    for (; prob < liczbaProb && makespan > cel; ++prob)
+    {
+        METRYKA_FAZA(Sasiedztwo);
+
+        // === KROK 1: Tasujemy genotyp, aby każda operacja dostała inny, losowy numer ===
+        std::shuffle(priorytety.begin(), priorytety.end(), gen);
+
+        // === KROK 2: Dekodujemy harmonogram i liczymy makespan ===
+        int wynik = odcinanie ? dekoder.dekodujDo(priorytety, makespan) : dekoder.dekoduj(priorytety);
+
+        // === KROK 3: Jeśli ten harmonogram jest najlepszy dotąd – zbuduj go i zapamiętaj ===
+        if (wynik < makespan)
         {
-            priorytety[i] = i;
+            makespan = wynik;
+            dekoder.dekoduj(priorytety, &schedule);
+            najlepszyGenotyp = priorytety;
+            METRYKA_DODAJ(Poprawy, 1);
+            zglosPoprawe(makespan);
+            LOG_DEBUG(Random, "Proba " << prob << ": nowy najlepszy makespan = " << makespan);
         }
 
-        // Tasujemy priorytety, aby każda operacja dostała inny, losowy numer
-        std::shuffle(priorytety.begin(), priorytety.end(), gen);
+        // Zapisz wynik tej próby (dla statystyk)
+        if (wynik != ScheduleDecoder::ODCIETY)
+            kosztyProb.push_back(wynik);
 
-        // Przypisujemy każdej operacji losowy priorytet oraz zerujemy czasy
-        for (int i = 0; i < liczbaOperacji; ++i)
+        if (zapis && ((coIleCheckpoint > 0 && (prob + 1) % coIleCheckpoint == 0) || czyZadanoCheckpointu()))
         {
-            kandydaci[i].priority = priorytety[i];
-            kandydaci[i].start_time = 0;
-            kandydaci[i].end_time = 0;
+            METRYKA_FAZA(Logowanie);
+            zapiszCheckpoint(prob + 1, priorytety, sumaInstancji, *zapis);
+            potwierdzCheckpoint();
         }
-        /* std::cout << "Przypisane priorytety:\n";
-    for (const auto& op : kandydaci)
-    {
-        std::cout << "Job " << op.job_id << ", Op " << op.operation_id 
-                  << ", Maszyna " << op.machine_id << ", Priorytet: " << op.priority << "\n";
-    }*/
-        // === KROK 2: Sortujemy operacje po priorytecie rosnąco ===
-        std::vector<int> indeksy(liczbaOperacji);
-        for (int i = 0; i < liczbaOperacji; ++i)
+        if (czyZadanoZatrzymania())
         {
-            indeksy[i] = i;
+            ++prob;
+            break;
         }
-        
-        //Sortowanie kubełkowe
-        std::sort(indeksy.begin(), indeksy.end(), PorownywaczIndeksowPoPriorytecie(&kandydaci));
-
-        // === KROK 3: Tworzymy harmonogram, trzymając ograniczenia technologiczne ===
-        std::vector<OperationSchedule> harmonogram;
+    }
 
-        std::vector<int> maszyna_wolna_od(liczbaMaszyn, 0);
-        std::vector<int> job_gotowy_od(liczbaJobow, 0);
-        std::vector<bool> czy_zrobione(liczbaOperacji, false);
+    // Zatrzymany przebieg zostawia stan do wznowienia; zakończony usuwa checkpoint
+    if (zapis && czyZadanoZatrzymania())
+        zapiszCheckpoint(prob, priorytety, sumaInstancji, *zapis);
+    else if (zapis)
+        zapis->porzuc();
+}
 
-        // Dopóki nie zaplanujemy wszystkich operacji
-        while (harmonogram.size() < kandydaci.size())
-        {
-            bool dodano = false;
+void RandomSolver::zapiszCheckpoint(int prob, const std::vector<int>& priorytety, uint64_t sumaInstancji, CheckpointWriter& zapis) const
+{
+    BuforZapisu b;
+    b.piszNaglowek("random", sumaInstancji, trybDekodera, kodowanie);
+    b.piszGenerator(gen);
+    b.piszInt(prob);
+    b.piszInt(makespan);
+    b.piszWektor(priorytety);
+    b.piszWektor(najlepszyGenotyp);
+    b.piszWektor(kosztyProb);
+    b.zakoncz();
+
+    zapis.zlec(b.getDane());
+}
 
-            for (int ii = 0; ii < indeksy.size(); ++ii)
-            {
-                int i = indeksy[ii]; // ← Używamy wcześniej posortowanych indeksów!
-                OperationSchedule& op = kandydaci[i];
+bool RandomSolver::wczytajCheckpoint(uint64_t sumaInstancji, int& prob, std::vector<int>& priorytety)
+{
+    std::vector<char> dane;
+    if (!wczytajPlikBinarny(plikWznowienia, dane))
+    {
+        LOG_OSTRZEZENIE(Random, "Brak checkpointu " << plikWznowienia << " – start od nowa");
+        return false;
+    }
 
-                if (czy_zrobione[i]) continue; // już zaplanowana
+    BuforOdczytu b(dane);
+    if (!b.czytajNaglowek("random", sumaInstancji, trybDekodera, kodowanie))
+        return false;
+
+    std::mt19937 g;
+    b.czytajGenerator(g);
+    int p = b.czytajInt();
+    int najlepszy = b.czytajInt();
+    std::vector<int> genotyp, najlepszyG;
+    std::vector<double> koszty;
+    b.czytajWektor(genotyp);
+    b.czytajWektor(najlepszyG);
+    b.czytajWektor(koszty);
+
+    if (!b.ok() || genotyp.size() != priorytety.size())
+    {
+        LOG_OSTRZEZENIE(Random, "Niepelny checkpoint " << plikWznowienia);
+        return false;
+    }
 
-                bool poprzedniaWykonana = false;
+    gen = g;
+    prob = p;
+    makespan = najlepszy;
+    priorytety = genotyp;
+    najlepszyGenotyp = najlepszyG;
+    kosztyProb = koszty;
+    LOG_INFO(Random, "Wznowiono z " << plikWznowienia << " od proby " << prob);
+    return true;
+}
 
-                if (op.operation_id == 0)
-                {
-                    poprzedniaWykonana = true;
-                }
-                else
-                {
 
-                // szukamy indeksu poprzedniej operacji w kandydaci
-                for (int j = 0; j < kandydaci.size(); ++j)
-                {
-                    if (kandydaci[j].job_id == op.job_id && kandydaci[j].operation_id == op.operation_id - 1 && czy_zrobione[j])
-                    {
-                            poprzedniaWykonana = true;
-                            break;
-                    }
-                }
-                }
+void RandomSolver::solveRownolegle(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn)
+{
+    makespan = std::numeric_limits<int>::max();
+    kosztyProb.clear();
+    najlepszyGenotyp.clear();
 
-                if (poprzedniaWykonana)
-                {
-                    int czasMaszyny = maszyna_wolna_od[op.machine_id]; //od kiedy maszyna, na której ma się odbyć ta operacja, jest dostępna.
-                    int czasJoba = job_gotowy_od[op.job_id]; //od kiedy job może kontynuować (czyli kiedy skończył poprzednią operację).
-                    int czasStart = (czasMaszyny > czasJoba) ? czasMaszyny : czasJoba;
+    // Przestrzeń robocza na wątek: dekoder, tasowany genotyp i lokalnie najlepszy (koszt, numer próby)
+    struct Watek
+    {
+        std::unique_ptr<ScheduleDecoder> dekoder;
+        std::vector<int> priorytety;
+        std::vector<int> najlepszyGenotyp;
+        int najlepszyKoszt = std::numeric_limits<int>::max();
+        int najlepszaProba = -1;
+    };
+    PulaWatkow pula(watki);
+    std::vector<Watek> przestrzenie(pula.getLiczbaWatkow());
+    for (Watek& w : przestrzenie)
+        w.dekoder.reset(new ScheduleDecoder(operacje, liczbaJobow, liczbaMaszyn, trybDekodera, kodowanie));
+    const std::vector<int> bazowy = genotypBazowy(operacje, kodowanie);
+
+    int prob = 0;
+    unsigned ziarno = gen();
+    uint64_t sumaInstancji = sumaKontrolnaInstancji(operacje, liczbaJobow, liczbaMaszyn);
+    if (plikWznowienia.empty() || !wczytajCheckpointRownolegly(sumaInstancji, prob, ziarno))
+    {
+        if (genotypStartowy.size() == bazowy.size())
+        {
+            makespan = przestrzenie[0].dekoder->dekoduj(genotypStartowy);
+            najlepszyGenotyp = genotypStartowy;
+        }
+    }
 
-                    op.start_time = czasStart;
-                    op.end_time = czasStart + op.processing_time;
+    std::unique_ptr<CheckpointWriter> zapis;
+    if (!plikCheckpointu.empty())
+        zapis.reset(new CheckpointWriter(plikCheckpointu));
 
-                    maszyna_wolna_od[op.machine_id] = op.end_time; //ta maszyna będzie znów wolna dopiero po tej operacji
-                    job_gotowy_od[op.job_id] = op.end_time; // job będzie gotowy do kolejnej operacji też dopiero wtedy
+    // Koszty prób partii trafiają na swoje miejsca; -1 = próba pominięta po osiągnięciu celu
+    const int paczekWPartii = 8 * pula.getLiczbaWatkow();
+    std::vector<double> kosztyPartii;
+    std::atomic<int> wspolnyNajlepszy(makespan);
 
+    while (prob < liczbaProb && makespan > cel)
+    {
+        // Paczki są wyznaczone przez numery prób (paczka c = próby [c * rozmiarPaczki, (c + 1) * rozmiarPaczki)),
+        // więc partie i wznowienia w środku paczki nie zmieniają losowanych permutacji
+        const int pierwszaPaczka = prob / rozmiarPaczki;
+        const int koniecPartii = (int)std::min<long long>(liczbaProb, (long long)(pierwszaPaczka + paczekWPartii) * rozmiarPaczki);
+        const int wPartii = koniecPartii - prob;
+        const int paczek = (koniecPartii - 1) / rozmiarPaczki - pierwszaPaczka + 1;
+        kosztyPartii.assign(wPartii, -1.0);
+        for (Watek& w : przestrzenie)
+            w.najlepszaProba = -1;
+
+        pula.rownolegle(paczek, [&](int p, int watek) {
+            METRYKA_FAZA(Sasiedztwo);
+            Watek& w = przestrzenie[watek];
+            const int paczka = pierwszaPaczka + p;
+            std::seed_seq ziarnoPaczki{ ziarno, (unsigned)paczka };
+            std::mt19937 g(ziarnoPaczki);
+            w.priorytety = bazowy;
+
+            const int od = std::max(paczka * rozmiarPaczki, prob);
+            const int doProby = std::min((paczka + 1) * rozmiarPaczki, koniecPartii);
+            for (int k = paczka * rozmiarPaczki; k < od; ++k)
+                std::shuffle(w.priorytety.begin(), w.priorytety.end(), g); // próby wykonane przed wznowieniem
+            for (int k = od; k < doProby; ++k)
+            {
+                if (wspolnyNajlepszy.load(std::memory_order_relaxed) <= cel)
+                    return; // inny wątek osiągnął już cel
 
-                    czy_zrobione[i] = true;
-                    harmonogram.push_back(op);
-                    dodano = true;
+                std::shuffle(w.priorytety.begin(), w.priorytety.end(), g);
+                int wynik;
+                if (odcinanie)
+                {
+                    // Próba równa najlepszej może jeszcze wygrać remis wcześniejszym numerem, stąd +1
+                    int prog = std::min(w.najlepszyKoszt, wspolnyNajlepszy.load(std::memory_order_relaxed));
+                    wynik = w.dekoder->dekodujDo(w.priorytety, prog == ScheduleDecoder::ODCIETY ? prog : prog + 1);
+                    if (wynik == ScheduleDecoder::ODCIETY)
+                        continue;
                 }
-            }
-
-
-              /*    std::cout << "Zaplanowane Job " << op.job_id << ", Op " << op.operation_id
-                          << " na maszynie " << op.machine_id
-                          << " od " << op.start_time << " do " << op.end_time << "\n";
-           */ }
-
+                else
+                    wynik = w.dekoder->dekoduj(w.priorytety);
+                kosztyPartii[k - prob] = wynik;
 
-            if (!dodano)
-            {
-                std::cerr << "Błąd: Nie udało się zaplanować żadnej operacji.\n";
-                break;
+                // Remis rozstrzyga wcześniejsza próba – ten sam wynik przy każdej liczbie wątków
+                if (wynik < w.najlepszyKoszt || (wynik == w.najlepszyKoszt && w.najlepszaProba >= 0 && k < w.najlepszaProba))
+                {
+                    w.najlepszyKoszt = wynik;
+                    w.najlepszaProba = k;
+                    w.najlepszyGenotyp = w.priorytety;
+                    int biezacy = wspolnyNajlepszy.load(std::memory_order_relaxed);
+                    while (wynik < biezacy && !wspolnyNajlepszy.compare_exchange_weak(biezacy, wynik))
+                        ;
+                }
             }
+        });
+
+        // Redukcja: lokalnie najlepsze z tej partii (najmniejszy koszt, potem numer próby) i koszty w kolejności prób
+        const Watek* zwyciezca = nullptr;
+        for (const Watek& w : przestrzenie)
+            if (w.najlepszaProba >= 0 && w.najlepszyKoszt < makespan &&
+                (zwyciezca == nullptr || w.najlepszyKoszt < zwyciezca->najlepszyKoszt ||
+                 (w.najlepszyKoszt == zwyciezca->najlepszyKoszt && w.najlepszaProba < zwyciezca->najlepszaProba)))
+                zwyciezca = &w;
+        if (zwyciezca != nullptr)
+        {
+            makespan = zwyciezca->najlepszyKoszt;
+            najlepszyGenotyp = zwyciezca->najlepszyGenotyp;
+            METRYKA_DODAJ(Poprawy, 1);
+            zglosPoprawe(makespan);
         }
-
-        // === KROK 4: Liczymy makespan – koniec najpóźniejszej operacji ===
-        int wynik = 0;
-        for (int i = 0; i < harmonogram.size(); ++i)
+        for (Watek& w : przestrzenie)
+            w.najlepszyKoszt = makespan;
+        for (double k : kosztyPartii)
+            if (k >= 0.0)
+                kosztyProb.push_back(k);
+
+        int poprzednia = prob;
+        prob += wPartii;
+        bool okresowy = coIleCheckpoint > 0 && prob / coIleCheckpoint != poprzednia / coIleCheckpoint;
+        if (zapis && (okresowy || czyZadanoCheckpointu()))
         {
-            if (harmonogram[i].end_time > wynik)
-            {
-                wynik = harmonogram[i].end_time;
-            }
+            METRYKA_FAZA(Logowanie);
+            zapiszCheckpointRownolegly(prob, ziarno, sumaInstancji, *zapis);
+            potwierdzCheckpoint();
         }
+        if (czyZadanoZatrzymania())
+            break;
+    }
 
-           // std::cout << "Makespan tej próby: " << wynik << "\n";
+    // Zatrzymany przebieg zostawia stan do wznowienia; zakończony usuwa checkpoint
+    if (zapis && czyZadanoZatrzymania())
+        zapiszCheckpointRownolegly(prob, ziarno, sumaInstancji, *zapis);
+    else if (zapis)
+        zapis->porzuc();
 
+    if (!najlepszyGenotyp.empty())
+        przestrzenie[0].dekoder->dekoduj(najlepszyGenotyp, &schedule);
+}
 
-        // === KROK 5: Jeśli ten harmonogram jest najlepszy dotąd – zapamiętaj go ===
-        if (wynik < makespan)
-        {
-            makespan = wynik;
-            schedule = harmonogram;
-                   // std::cout << "=> Nowy najlepszy harmonogram (makespan = " << makespan << ")\n";
+void RandomSolver::zapiszCheckpointRownolegly(int prob, unsigned ziarno, uint64_t sumaInstancji, CheckpointWriter& zapis) const
+{
+    BuforZapisu b;
+    b.piszNaglowek("random-watki", sumaInstancji, trybDekodera, kodowanie);
+    b.piszU64(ziarno);
+    b.piszInt(prob);
+    b.piszInt(makespan);
+    b.piszWektor(najlepszyGenotyp);
+    b.piszWektor(kosztyProb);
+    b.zakoncz();
+
+    zapis.zlec(b.getDane());
+}
 
-        }
+bool RandomSolver::wczytajCheckpointRownolegly(uint64_t sumaInstancji, int& prob, unsigned& ziarno)
+{
+    std::vector<char> dane;
+    if (!wczytajPlikBinarny(plikWznowienia, dane))
+    {
+        LOG_OSTRZEZENIE(Random, "Brak checkpointu " << plikWznowienia << " – start od nowa");
+        return false;
+    }
 
-        // Zapisz wynik tej próby (dla statystyk)
-        kosztyProb.push_back(wynik);
+    BuforOdczytu b(dane);
+    if (!b.czytajNaglowek("random-watki", sumaInstancji, trybDekodera, kodowanie))
+        return false;
+
+    unsigned z = (unsigned)b.czytajU64();
+    int p = b.czytajInt();
+    int najlepszy = b.czytajInt();
+    std::vector<int> najlepszyG;
+    std::vector<double> koszty;
+    b.czytajWektor(najlepszyG);
+    b.czytajWektor(koszty);
+
+    if (!b.ok())
+    {
+        LOG_OSTRZEZENIE(Random, "Niepelny checkpoint " << plikWznowienia);
+        return false;
     }
+
+    ziarno = z;
+    prob = p;
+    makespan = najlepszy;
+    najlepszyGenotyp = najlepszyG;
+    kosztyProb = koszty;
+    LOG_INFO(Random, "Wznowiono z " << plikWznowienia << " od proby " << prob);
+    return true;
 }
 
 
@@ -175,7 +370,7 @@ void RandomSolver::printSchedule() const
     std::cout << "Job\tOpID\tMaszyna\tPriory\tStart\tEnd\n";
 
     // Iterujemy po wszystkich operacjach w zapisanym harmonogramie
-    for (int i = 0; i < schedule.size(); ++i)
+    for (int i = 0; i < (int)schedule.size(); ++i)
     {
         const OperationSchedule& op = schedule[i]; // jawnie deklarujemy typ
 
@@ -191,32 +386,16 @@ void RandomSolver::printSchedule() const
 
 void RandomSolver::zapiszDoCSV(const std::string& nazwaPliku) const
 {
-    // Tworzymy obiekt plikowy do zapisu
-    std::ofstream out(nazwaPliku);
-
-    // Sprawdzamy, czy plik otworzył się poprawnie
-    if (!out.is_open()) {
-        std::cerr << "Nie można otworzyć pliku do zapisu: " << nazwaPliku << "\n";
-        return; // kończymy funkcję, jeśli nie udało się otworzyć pliku
-    }
-
-    // Nagłówek pliku CSV
-    out << "job_id,operation_id,machine_id,start_time,end_time\n";
-
-    // Iterujemy po wszystkich operacjach i zapisujemy ich dane do pliku
-    for (int i = 0; i < schedule.size(); ++i)
+    TekstCSV t(',');
+    t.zarezerwuj(schedule.size() * 24);
+    t.tekst() = "job_id,operation_id,machine_id,start_time,end_time\n";
+    for (const OperationSchedule& op : schedule)
     {
-        const OperationSchedule& op = schedule[i];
-
-        // Wypisujemy dane w formacie CSV (czyli oddzielone przecinkami)
-        out << op.job_id << ","
-            << op.operation_id << ","
-            << op.machine_id << ","
-            << op.start_time << ","
-            << op.end_time << "\n";
+        t.pole(op.job_id).pole(op.operation_id).pole(op.machine_id).pole(op.start_time).pole(op.end_time);
+        t.koniecWiersza();
     }
 
-    // Plik zostanie zamknięty automatycznie po zakończeniu funkcji (RAII)
+    ResultWriter::instancja().zapisz(nazwaPliku, t.tekst());
 }
 
 void RandomSolver::zapiszStatystykiDoCSV(const std::string& nazwaPliku, int run) const
@@ -231,22 +410,9 @@ void RandomSolver::zapiszStatystykiDoCSV(const std::string& nazwaPliku, int run)
     double worst = *std::max_element(kosztyProb.begin(), kosztyProb.end());
     double avg = std::accumulate(kosztyProb.begin(), kosztyProb.end(), 0.0) / kosztyProb.size();
 
-    std::ofstream out;
-    bool istnieje = std::ifstream(nazwaPliku).good();
-    out.open(nazwaPliku, std::ios::app); // dopisujemy
-
-
-    if (!out.is_open()) {
-        std::cerr << "Nie można otworzyć pliku do zapisu: " << nazwaPliku << "\n";
-        return;
-    }
-
-
-    if (!istnieje) {
-        out << "run;best;average;worst\n"; // nagłówek tylko jeśli plik nie istniał
-    }
-
-    out << run << ";" << best << ";" << avg << ";" << worst << "\n";
-    out.close();
+    TekstCSV t;
+    t.pole(run).pole(best).pole(avg).pole(worst).pole(obliczGap(makespan, dolneOgraniczenie));
+    t.koniecWiersza();
+    ResultWriter::instancja().dopisz(nazwaPliku, "run;best;average;worst;gap\n", t.tekst());
 }
 
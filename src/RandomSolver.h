@@ -2,9 +2,12 @@
 #define RANDOM_SOLVER_H
 
 #include "OperationSchedule.h"
+#include "ScheduleDecoder.h"
 #include <vector>
 #include <string>
+#include <random>
 
+class CheckpointWriter;
 
 class RandomSolver {
 public:
@@ -16,15 +19,62 @@ public:
     void zapiszStatystykiDoCSV(const std::string& nazwaPliku, int run) const;
 
     int getMakespan() const { return makespan; }
+    const std::vector<OperationSchedule>& getSchedule() const { return schedule; }
+
+    // Wybór dekodera i kodowania genotypu (domyślnie półaktywny, priorytetowy)
+    void ustawTrybDekodera(TrybDekodera tryb) { trybDekodera = tryb; }
+    void ustawKodowanie(Kodowanie k) { kodowanie = k; }
+
+    // Zatrzymanie po osiągnięciu celu (np. znanego optimum) i dolne ograniczenie do liczenia gapu
+    void ustawCel(int cel) { this->cel = cel; }
+    void ustawDolneOgraniczenie(int lb) { dolneOgraniczenie = lb; }
+
+    // Checkpoint co `coIle` prób, na sygnał i przy zatrzymaniu (zakończony przebieg usuwa plik); pusta ścieżka = wyłączone
+    void ustawCheckpoint(const std::string& sciezka, int coIle) { plikCheckpointu = sciezka; coIleCheckpoint = coIle; }
+    // Następne solve() kontynuuje przebieg z checkpointu (dalej identycznie jak bez przerwy)
+    void wznowZ(const std::string& sciezka) { plikWznowienia = sciezka; }
+    void ustawZiarno(unsigned ziarno) { gen.seed(ziarno); }
+
+    // Podany genotyp (np. z archiwum) jest pierwszym kandydatem, potem losowe próby; pusty = same losowe
+    void ustawGenotypStartowy(const std::vector<int>& g) { genotypStartowy = g; }
+
+    // Próbkowanie równoległe: budżet dzielony na paczki po rozmiarPaczki prób, każda z własnym
+    // generatorem z (ziarno, numer paczki), więc wynik nie zależy od liczby wątków.
+    // 1 = dotychczasowy przebieg sekwencyjny, 0 = std::thread::hardware_concurrency()
+    void ustawWatki(int n) { watki = n; }
+
+    // Próba jest dekodowana tylko do chwili, w której nie może już pobić najlepszej (zob. dekodujDo).
+    // Odcięte próby nie mają makespanu, więc średnia i najgorszy w statystykach są liczone z pełnych ocen.
+    void ustawOdcinanie(bool o) { odcinanie = o; }
 
 
     void zapiszMakespanDoCSV(const std::string &nazwaPliku) const;
 
 private:
+    void solveRownolegle(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn);
+
+    void zapiszCheckpoint(int prob, const std::vector<int>& priorytety, uint64_t sumaInstancji, CheckpointWriter& zapis) const;
+    bool wczytajCheckpoint(uint64_t sumaInstancji, int& prob, std::vector<int>& priorytety);
+    void zapiszCheckpointRownolegly(int prob, unsigned ziarno, uint64_t sumaInstancji, CheckpointWriter& zapis) const;
+    bool wczytajCheckpointRownolegly(uint64_t sumaInstancji, int& prob, unsigned& ziarno);
+
     std::vector<OperationSchedule> schedule;
     int makespan;
     int liczbaProb;
     std::vector<double> kosztyProb;
+    TrybDekodera trybDekodera;
+    Kodowanie kodowanie;
+    int cel;
+    int dolneOgraniczenie;
+
+    std::vector<int> najlepszyGenotyp;
+    std::vector<int> genotypStartowy;
+    std::mt19937 gen;
+    int watki;
+    bool odcinanie;
+    std::string plikCheckpointu;
+    int coIleCheckpoint;
+    std::string plikWznowienia;
 };
 
 #endif 
@@ -0,0 +1,230 @@
+#include "Rescheduler.h"
+#include "Log.h"
+#include <algorithm>
+#include <iostream>
+#include <tuple>
+
+Rescheduler::Rescheduler(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                         Kodowanie kodowanie, TrybDekodera tryb)
+    : instancja(operacje), liczbaJobowInstancji(liczbaJobow), liczbaMaszyn(liczbaMaszyn), kodowanie(kodowanie), tryb(tryb),
+      anulowany(liczbaJobow, false), przestojeMaszyn(liczbaMaszyn), makespan(0)
+{}
+
+void Rescheduler::nanies(const ZdarzenieProdukcyjne& zdarzenie)
+{
+    for (int n = 0; n < (int)zdarzenie.noweJoby.size(); ++n)
+    {
+        const std::vector<std::pair<int, int>>& trasa = zdarzenie.noweJoby[n];
+        bool poprawny = !trasa.empty();
+        for (int k = 0; k < (int)trasa.size(); ++k)
+        {
+            if (trasa[k].first < 0 || trasa[k].first >= liczbaMaszyn || trasa[k].second < 0)
+                poprawny = false;
+        }
+        if (!poprawny)
+        {
+            LOG_OSTRZEZENIE(Rescheduler, "Pomijam nowy job nr " << n << " z bledna trasa");
+            continue;
+        }
+
+        OperationSchedule op = OperationSchedule();
+        op.job_id = liczbaJobowInstancji;
+        for (int k = 0; k < (int)trasa.size(); ++k)
+        {
+            op.operation_id = k;
+            op.machine_id = trasa[k].first;
+            op.processing_time = trasa[k].second;
+            instancja.push_back(op);
+        }
+        anulowany.push_back(false);
+        ++liczbaJobowInstancji;
+    }
+
+    for (int j : zdarzenie.anulowaneJoby)
+    {
+        if (j < 0 || j >= liczbaJobowInstancji)
+        {
+            LOG_OSTRZEZENIE(Rescheduler, "Nie ma joba " << j << " do anulowania");
+            continue;
+        }
+        anulowany[j] = true;
+    }
+
+    for (const PrzestojMaszyny& p : zdarzenie.przestoje)
+    {
+        if (p.maszyna < 0 || p.maszyna >= liczbaMaszyn || p.od >= p.doCzasu)
+        {
+            LOG_OSTRZEZENIE(Rescheduler, "Pomijam bledny przestoj maszyny " << p.maszyna);
+            continue;
+        }
+
+        // Wstawienie z łączeniem nachodzących okien, żeby lista została posortowana i rozłączna
+        std::vector<std::pair<int, int>>& okna = przestojeMaszyn[p.maszyna];
+        std::pair<int, int> nowe(p.od, p.doCzasu);
+        std::vector<std::pair<int, int>> wynik;
+        for (const std::pair<int, int>& o : okna)
+        {
+            if (o.second < nowe.first || o.first > nowe.second)
+                wynik.push_back(o);
+            else
+                nowe = std::make_pair(std::min(o.first, nowe.first), std::max(o.second, nowe.second));
+        }
+        wynik.push_back(nowe);
+        std::sort(wynik.begin(), wynik.end());
+        okna.swap(wynik);
+    }
+}
+
+int Rescheduler::przeplanuj(const std::vector<OperationSchedule>& aktualny, const ZdarzenieProdukcyjne& zdarzenie)
+{
+    nanies(zdarzenie);
+    const int czas = zdarzenie.czas;
+    const int N = instancja.size();
+
+    // Operacje instancji pogrupowane po jobach w kolejności technologicznej
+    std::vector<std::vector<int>> operacjeJoba(liczbaJobowInstancji);
+    for (int i = 0; i < N; ++i)
+        operacjeJoba[instancja[i].job_id].push_back(i);
+    for (int j = 0; j < liczbaJobowInstancji; ++j)
+    {
+        std::sort(operacjeJoba[j].begin(), operacjeJoba[j].end(),
+                  [this](int a, int b) { return instancja[a].operation_id < instancja[b].operation_id; });
+    }
+
+    // Dotychczasowe czasy startu (-1 = operacja nie była zaplanowana, np. z nowego joba)
+    std::vector<int> start(N, -1);
+    std::vector<int> koniec(N, -1);
+    for (const OperationSchedule& op : aktualny)
+    {
+        if (op.job_id < 0 || op.job_id >= liczbaJobowInstancji) continue;
+        const std::vector<int>& ops = operacjeJoba[op.job_id];
+        for (int i : ops)
+        {
+            if (instancja[i].operation_id == op.operation_id)
+            {
+                start[i] = op.start_time;
+                koniec[i] = op.end_time;
+                break;
+            }
+        }
+    }
+
+    // Zamrożone: rozpoczęte przed chwilą zdarzenia (także z anulowanych jobów – już zajmują maszynę)
+    zamrozone.clear();
+    std::vector<int> gotowoscMaszyny(liczbaMaszyn, czas);
+    std::vector<int> gotowoscJobaInstancji(liczbaJobowInstancji, czas);
+    std::vector<bool> zamrozona(N, false);
+    for (int i = 0; i < N; ++i)
+    {
+        if (start[i] < 0 || start[i] >= czas) continue;
+        zamrozona[i] = true;
+        OperationSchedule op = instancja[i];
+        op.start_time = start[i];
+        op.end_time = koniec[i];
+        zamrozone.push_back(op);
+        gotowoscMaszyny[op.machine_id] = std::max(gotowoscMaszyny[op.machine_id], op.end_time);
+        gotowoscJobaInstancji[op.job_id] = std::max(gotowoscJobaInstancji[op.job_id], op.end_time);
+    }
+    std::sort(zamrozone.begin(), zamrozone.end(),
+              [](const OperationSchedule& a, const OperationSchedule& b) { return a.start_time < b.start_time; });
+
+    // Podproblem z niezamrożonych operacji aktywnych jobów; klucz naprawy = dotychczasowy start
+    // albo (dla operacji bez startu) najwcześniejszy start wynikający z samego joba
+    podproblem.clear();
+    oryginalnyJob.clear();
+    pierwszaOperacja.clear();
+    ograniczenia.gotowoscJoba.clear();
+    std::vector<std::tuple<int, int, int>> klucze; // (klucz, job podproblemu, operacja) -> indeks po sortowaniu
+    for (int j = 0; j < liczbaJobowInstancji; ++j)
+    {
+        if (anulowany[j]) continue;
+
+        const std::vector<int>& ops = operacjeJoba[j];
+        int k0 = 0;
+        while (k0 < (int)ops.size() && zamrozona[ops[k0]]) ++k0;
+        if (k0 == (int)ops.size()) continue;
+
+        int jp = oryginalnyJob.size();
+        oryginalnyJob.push_back(j);
+        pierwszaOperacja.push_back(instancja[ops[k0]].operation_id);
+        ograniczenia.gotowoscJoba.push_back(gotowoscJobaInstancji[j]);
+
+        int glowa = gotowoscJobaInstancji[j];
+        for (int k = k0; k < (int)ops.size(); ++k)
+        {
+            OperationSchedule op = instancja[ops[k]];
+            op.job_id = jp;
+            op.operation_id = k - k0;
+            op.start_time = 0;
+            op.end_time = 0;
+            op.priority = 0;
+
+            int klucz = (start[ops[k]] >= 0) ? std::max(start[ops[k]], glowa) : glowa;
+            glowa = klucz + op.processing_time;
+            klucze.push_back(std::make_tuple(klucz, jp, (int)podproblem.size()));
+            podproblem.push_back(op);
+        }
+    }
+    ograniczenia.gotowoscMaszyny = gotowoscMaszyny;
+    ograniczenia.przestojeMaszyn = przestojeMaszyn;
+
+    // Klucze rosną w obrębie joba, więc kolejność po kluczu nie łamie kolejności technologicznej
+    // i dekoder planuje operacje dokładnie w tej kolejności
+    std::sort(klucze.begin(), klucze.end());
+    const int liczbaOperacji = podproblem.size();
+    genotypNaprawy.assign(liczbaOperacji, 0);
+    for (int r = 0; r < liczbaOperacji; ++r)
+    {
+        if (kodowanie == Kodowanie::PowtorzeniaJobow)
+            genotypNaprawy[r] = std::get<1>(klucze[r]);
+        else
+            genotypNaprawy[std::get<2>(klucze[r])] = r;
+    }
+
+    harmonogram.clear();
+    makespan = 0;
+    if (podproblem.empty())
+    {
+        harmonogram = zamrozone;
+        for (const OperationSchedule& op : harmonogram)
+            makespan = std::max(makespan, op.end_time);
+        return makespan;
+    }
+
+    ScheduleDecoder dekoder(podproblem, getLiczbaJobow(), liczbaMaszyn, tryb, kodowanie);
+    dekoder.ustawOgraniczenia(&ograniczenia);
+    std::vector<OperationSchedule> naprawa;
+    dekoder.dekoduj(genotypNaprawy, &naprawa);
+
+    makespan = -1; // scal() zawsze przyjmie naprawę
+    return scal(naprawa);
+}
+
+int Rescheduler::scal(const std::vector<OperationSchedule>& harmonogramPodproblemu)
+{
+    std::vector<OperationSchedule> pelny = zamrozone;
+    int wynik = 0;
+    for (const OperationSchedule& op : zamrozone)
+        wynik = std::max(wynik, op.end_time);
+
+    for (const OperationSchedule& op : harmonogramPodproblemu)
+    {
+        if (op.job_id < 0 || op.job_id >= getLiczbaJobow())
+        {
+            LOG_OSTRZEZENIE(Rescheduler, "Harmonogram nie pasuje do podproblemu");
+            return makespan;
+        }
+        OperationSchedule o = op;
+        o.job_id = oryginalnyJob[op.job_id];
+        o.operation_id = op.operation_id + pierwszaOperacja[op.job_id];
+        pelny.push_back(o);
+        wynik = std::max(wynik, o.end_time);
+    }
+
+    if (makespan < 0 || wynik < makespan)
+    {
+        harmonogram.swap(pelny);
+        makespan = wynik;
+    }
+    return wynik;
+}
@@ -0,0 +1,87 @@
+#ifndef RESCHEDULER_H
+#define RESCHEDULER_H
+
+#include "OperationSchedule.h"
+#include "ScheduleDecoder.h"
+#include "Encoding.h"
+#include <vector>
+#include <utility>
+
+// Okno niedostępności maszyny [od, doCzasu)
+struct PrzestojMaszyny
+{
+    int maszyna;
+    int od;
+    int doCzasu;
+};
+
+// Zmiana instancji w trakcie realizacji harmonogramu
+struct ZdarzenieProdukcyjne
+{
+    int czas; // operacje rozpoczęte przed tą chwilą są zamrożone
+    std::vector<PrzestojMaszyny> przestoje;
+    std::vector<std::vector<std::pair<int, int>>> noweJoby; // (maszyna, czas trwania) w kolejności technologicznej
+    std::vector<int> anulowaneJoby;                          // nierozpoczęte operacje tych jobów znikają
+};
+
+// Przyrostowe przeplanowanie po awarii maszyny albo zmianie zleceń.
+// Naprawa zachowuje kolejność z dotychczasowego harmonogramu (operacje nowych jobów wchodzą
+// według najwcześniejszego możliwego startu) i przesuwa operacje w prawo – O(N log N), bez przeszukiwania.
+// Potem można ją poprawiać TS/SA na podproblemie:
+//     solver.ustawKodowanie(/* to samo co w Rescheduler */);
+//     solver.ustawOgraniczenia(&r.getOgraniczenia());
+//     solver.ustawGenotypStartowy(r.getGenotypNaprawy());
+//     solver.solve(r.getOperacje(), r.getLiczbaJobow(), r.getLiczbaMaszyn());
+//     r.scal(solver.getSchedule());
+// Kolejne zdarzenia nakłada się na getHarmonogram() – przestoje i anulowania są pamiętane.
+class Rescheduler
+{
+public:
+    Rescheduler(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                Kodowanie kodowanie = Kodowanie::Priorytety,
+                TrybDekodera tryb = TrybDekodera::Polaktywny);
+
+    // harmonogram = bieżący plan z czasami (np. solver.getSchedule()); zwraca makespan naprawy
+    int przeplanuj(const std::vector<OperationSchedule>& harmonogram, const ZdarzenieProdukcyjne& zdarzenie);
+
+    // Podproblem: niezamrożone operacje, joby numerowane od 0, czasy bezwzględne
+    const std::vector<OperationSchedule>& getOperacje() const { return podproblem; }
+    int getLiczbaJobow() const { return (int)oryginalnyJob.size(); }
+    int getLiczbaMaszyn() const { return liczbaMaszyn; }
+    const OgraniczeniaCzasowe& getOgraniczenia() const { return ograniczenia; }
+    const std::vector<int>& getGenotypNaprawy() const { return genotypNaprawy; }
+
+    // Harmonogram podproblemu (np. z solvera) -> pełny harmonogram; jeśli jest lepszy, zastępuje bieżący.
+    // Zwraca jego makespan.
+    int scal(const std::vector<OperationSchedule>& harmonogramPodproblemu);
+
+    // Bieżący pełny harmonogram (zamrożone + zaplanowane operacje) i instancja z dodanymi jobami
+    const std::vector<OperationSchedule>& getHarmonogram() const { return harmonogram; }
+    int getMakespan() const { return makespan; }
+    const std::vector<OperationSchedule>& getInstancja() const { return instancja; }
+    int getLiczbaJobowInstancji() const { return liczbaJobowInstancji; }
+
+private:
+    void nanies(const ZdarzenieProdukcyjne& zdarzenie);
+
+    std::vector<OperationSchedule> instancja;
+    int liczbaJobowInstancji;
+    int liczbaMaszyn;
+    Kodowanie kodowanie;
+    TrybDekodera tryb;
+    std::vector<bool> anulowany;
+    std::vector<std::vector<std::pair<int, int>>> przestojeMaszyn; // [m]: posortowane, rozłączne
+
+    // Wynik ostatniego przeplanowania
+    std::vector<OperationSchedule> zamrozone;
+    std::vector<OperationSchedule> podproblem;
+    std::vector<int> oryginalnyJob;       // job podproblemu -> job instancji
+    std::vector<int> pierwszaOperacja;    // operation_id pierwszej niezamrożonej operacji joba
+    OgraniczeniaCzasowe ograniczenia;
+    std::vector<int> genotypNaprawy;
+
+    std::vector<OperationSchedule> harmonogram;
+    int makespan;
+};
+
+#endif
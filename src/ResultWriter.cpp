@@ -0,0 +1,220 @@
+#include "ResultWriter.h"
+#include "Log.h"
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+
+static const std::size_t MAKS_OCZEKUJACYCH = 64u << 20; // bajtów tekstu w kolejce
+static const std::size_t ROZMIAR_BUFORA = 1u << 20;
+
+// ===== TekstCSV =====
+
+void TekstCSV::separatorPola()
+{
+    if (!poczatekWiersza)
+        dane.push_back(separator);
+    poczatekWiersza = false;
+}
+
+TekstCSV& TekstCSV::pole(long long v)
+{
+    separatorPola();
+    char buf[24];
+    std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), v);
+    dane.append(buf, r.ptr);
+    return *this;
+}
+
+TekstCSV& TekstCSV::pole(double v)
+{
+    separatorPola();
+    char buf[32];
+    std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), v, std::chars_format::general, 6);
+    dane.append(buf, r.ptr);
+    return *this;
+}
+
+TekstCSV& TekstCSV::pole(const std::string& s)
+{
+    separatorPola();
+    dane += s;
+    return *this;
+}
+
+void TekstCSV::koniecWiersza()
+{
+    dane.push_back('\n');
+    poczatekWiersza = true;
+}
+
+// ===== ResultWriter =====
+
+// Plik z innym nagłówkiem niż bieżący (np. sprzed dodania kolumny gap): gdy stary nagłówek jest
+// początkiem nowego, wiersze dostają puste nowe kolumny i nowy nagłówek; w przeciwnym razie
+// stary plik jest przenoszony do <plik>.old. Zwraca true, gdy plik trzeba zacząć od nagłówka.
+static bool dopasujNaglowek(const std::string& plik, const std::string& naglowek)
+{
+    std::string nowy = naglowek.substr(0, naglowek.find('\n'));
+    std::ifstream in(plik);
+    std::string stary;
+    std::getline(in, stary);
+    if (!stary.empty() && stary.back() == '\r')
+        stary.pop_back();
+    if (!in || stary == nowy)
+        return false;
+
+    std::error_code ec;
+    if (nowy.size() > stary.size() && nowy.compare(0, stary.size(), stary) == 0)
+    {
+        const char separator = nowy[stary.size()];
+        const std::string dopelnienie(std::count(nowy.begin() + stary.size(), nowy.end(), separator), separator);
+        const std::string tymczasowy = plik + ".tmp";
+        {
+            std::ofstream out(tymczasowy, std::ios::trunc);
+            out << nowy << '\n';
+            std::string wiersz;
+            while (std::getline(in, wiersz))
+            {
+                if (!wiersz.empty() && wiersz.back() == '\r')
+                    wiersz.pop_back();
+                if (!wiersz.empty())
+                    out << wiersz << dopelnienie << '\n';
+            }
+            if (!out)
+                LOG_BLAD(Wyniki, "Nie można uzupełnić kolumn w " << plik);
+        }
+        in.close();
+        std::filesystem::rename(tymczasowy, plik, ec);
+        if (!ec)
+        {
+            LOG_INFO(Wyniki, "Uzupełniono nagłówek " << plik << ": " << nowy);
+            return false;
+        }
+    }
+
+    in.close();
+    std::filesystem::rename(plik, plik + ".old", ec);
+    if (ec)
+        return false; // zostaje dopisywanie jak dotąd
+    LOG_OSTRZEZENIE(Wyniki, "Inny nagłówek w " << plik << " – stary plik przeniesiony do " << plik << ".old");
+    return true;
+}
+
+ResultWriter& ResultWriter::instancja()
+{
+    static ResultWriter zapis;
+    return zapis;
+}
+
+ResultWriter::ResultWriter()
+    : oczekujaceBajty(0), zapisuje(false), koniec(false), watek(&ResultWriter::petla, this)
+{}
+
+ResultWriter::~ResultWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        koniec = true;
+    }
+    warunek.notify_all();
+    watek.join();
+}
+
+void ResultWriter::dopisz(const std::string& plik, const std::string& naglowek, std::string& tekst)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    // Pojedyncze zlecenie większe od limitu przechodzi, gdy kolejka jest pusta
+    warunek.wait(lock, [&] { return oczekujaceBajty == 0 || oczekujaceBajty + tekst.size() <= MAKS_OCZEKUJACYCH; });
+    oczekujaceBajty += tekst.size();
+    kolejka.push_back(Zlecenie{ plik, naglowek, std::string(), false });
+    kolejka.back().tekst.swap(tekst);
+    lock.unlock();
+    warunek.notify_all();
+}
+
+void ResultWriter::zapisz(const std::string& plik, std::string& tekst)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    warunek.wait(lock, [&] { return oczekujaceBajty == 0 || oczekujaceBajty + tekst.size() <= MAKS_OCZEKUJACYCH; });
+    oczekujaceBajty += tekst.size();
+    kolejka.push_back(Zlecenie{ plik, std::string(), std::string(), true });
+    kolejka.back().tekst.swap(tekst);
+    lock.unlock();
+    warunek.notify_all();
+}
+
+void ResultWriter::oproznij()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    warunek.wait(lock, [this] { return kolejka.empty() && !zapisuje; });
+}
+
+void ResultWriter::petla()
+{
+    Zlecenie z;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        if (kolejka.empty())
+        {
+            // Kolejka pusta – wszystko na dysk, żeby pliki dało się czytać w trakcie przebiegu
+            lock.unlock();
+            for (auto& p : pliki)
+                p.second->out.flush();
+            lock.lock();
+            zapisuje = false;
+            warunek.notify_all();
+
+            warunek.wait(lock, [this] { return !kolejka.empty() || koniec; });
+            if (kolejka.empty())
+                return; // koniec i nic do zapisania
+        }
+
+        z = std::move(kolejka.front());
+        kolejka.pop_front();
+        oczekujaceBajty -= z.tekst.size();
+        zapisuje = true;
+        warunek.notify_all(); // zwolniło się miejsce w kolejce
+
+        lock.unlock();
+        wykonaj(z);
+        lock.lock();
+    }
+}
+
+void ResultWriter::wykonaj(Zlecenie& z)
+{
+    std::unique_ptr<PlikWyjsciowy>& p = pliki[z.plik];
+    if (z.nadpisz && p)
+        p.reset(); // nadpisanie zawsze od nowa
+
+    if (!p)
+    {
+        bool pusty = true;
+        if (!z.nadpisz)
+        {
+            std::error_code ec;
+            pusty = !std::filesystem::exists(z.plik, ec) || std::filesystem::file_size(z.plik, ec) == 0 || ec;
+            if (!pusty && !z.naglowek.empty())
+                pusty = dopasujNaglowek(z.plik, z.naglowek);
+        }
+
+        p.reset(new PlikWyjsciowy());
+        p->bufor.reset(new char[ROZMIAR_BUFORA]);
+        p->out.rdbuf()->pubsetbuf(p->bufor.get(), ROZMIAR_BUFORA);
+        p->out.open(z.plik, z.nadpisz ? std::ios::trunc : std::ios::app);
+        if (!p->out.is_open())
+        {
+            LOG_BLAD(Wyniki, "Nie można otworzyć pliku do zapisu: " << z.plik);
+            pliki.erase(z.plik); // kolejne zlecenie spróbuje ponownie
+            return;
+        }
+        if (pusty)
+            p->out.write(z.naglowek.data(), z.naglowek.size());
+    }
+
+    p->out.write(z.tekst.data(), z.tekst.size());
+    if (z.nadpisz)
+        pliki.erase(z.plik); // harmonogram jest kompletny – zamykamy plik
+}
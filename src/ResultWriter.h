@@ -0,0 +1,91 @@
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+
+#include <string>
+#include <deque>
+#include <map>
+#include <memory>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+// Tekst CSV budowany w pamięci przez std::to_chars (bez strumieni i locale).
+// Liczby zmiennoprzecinkowe jak domyślny operator<< (%g, 6 cyfr znaczących).
+class TekstCSV
+{
+public:
+    explicit TekstCSV(char separator = ';') : separator(separator), poczatekWiersza(true) {}
+
+    // Kolejne pole wiersza (separator jest dodawany automatycznie)
+    TekstCSV& pole(long long v);
+    TekstCSV& pole(int v) { return pole(static_cast<long long>(v)); }
+    TekstCSV& pole(std::size_t v) { return pole(static_cast<long long>(v)); }
+    TekstCSV& pole(double v);
+    TekstCSV& pole(const std::string& s);
+    void koniecWiersza();
+
+    void zarezerwuj(std::size_t bajtow) { dane.reserve(bajtow); }
+    std::string& tekst() { return dane; }
+
+private:
+    void separatorPola();
+
+    std::string dane;
+    char separator;
+    bool poczatekWiersza;
+};
+
+// Wspólny zapis wyników (wyniki_*.csv, harmonogramy, koszty) w jednym wątku w tle.
+// Pliki zostają otwarte między zapisami (duże bufory), nagłówek pliku dopisywanego
+// jest sprawdzany raz na plik. Kolejka jest ograniczona rozmiarem tekstu – solver czeka
+// tylko wtedy, gdy dysk nie nadąża z MAKS_OCZEKUJACYCH bajtami. Zapisy z różnych wątków
+// trafiają do pliku w kolejności zleceń, każdy w całości.
+class ResultWriter
+{
+public:
+    static ResultWriter& instancja();
+
+    // Dopisuje tekst; nagłówek trafia na początek, jeśli plik nie istniał albo był pusty.
+    // Plik z innym nagłówkiem jest przy pierwszym zapisie uzupełniany o nowe kolumny albo odkładany (.old).
+    void dopisz(const std::string& plik, const std::string& naglowek, std::string& tekst);
+    // Zastępuje zawartość pliku
+    void zapisz(const std::string& plik, std::string& tekst);
+    // Czeka, aż wszystko zlecone trafi na dysk
+    void oproznij();
+
+    ~ResultWriter(); // zapisuje oczekujące zlecenia i zamyka pliki
+
+private:
+    ResultWriter();
+    void petla();
+
+    struct Zlecenie
+    {
+        std::string plik;
+        std::string naglowek;
+        std::string tekst;
+        bool nadpisz;
+    };
+    struct PlikWyjsciowy
+    {
+        std::unique_ptr<char[]> bufor; // przed strumieniem – musi go przeżyć
+        std::ofstream out;
+    };
+
+    void wykonaj(Zlecenie& z);
+
+    // Tylko wątek zapisu
+    std::map<std::string, std::unique_ptr<PlikWyjsciowy>> pliki;
+
+    std::mutex mutex;
+    std::condition_variable warunek;
+    std::deque<Zlecenie> kolejka;
+    std::size_t oczekujaceBajty;
+    bool zapisuje;
+    bool koniec;
+    std::thread watek;
+};
+
+#endif
@@ -0,0 +1,690 @@
+#include "ScheduleDecoder.h"
+#include "Metrics.h"
+#include <algorithm>
+#include <limits>
+
+ScheduleDecoder::ScheduleDecoder(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                                 TrybDekodera tryb, Kodowanie kodowanie)
+    : operacje(operacje), liczbaJobow(liczbaJobow), liczbaMaszyn(liczbaMaszyn), tryb(tryb), kodowanie(kodowanie),
+      maksOperacjiJoba(0), jadroStale(nullptr), jadroOdcinajace(nullptr), ograniczenia(nullptr), cache(nullptr), liczPodpis(false), podpis(0)
+{
+    const int N = operacje.size();
+
+    // Ile operacji ma każdy job (instancje z Known-Optima mają różne długości jobów)
+    std::vector<int> liczbaOperacjiNaJob(liczbaJobow, 0);
+    for (int i = 0; i < N; ++i)
+    {
+        const OperationSchedule& op = operacje[i];
+        if (op.operation_id + 1 > liczbaOperacjiNaJob[op.job_id])
+        {
+            liczbaOperacjiNaJob[op.job_id] = op.operation_id + 1;
+        }
+    }
+
+    poczatekJoba.assign(liczbaJobow + 1, 0);
+    std::vector<int> liczbaOperacjiNaMaszynie(liczbaMaszyn, 0);
+    maszynaOperacji.resize(N);
+    for (int i = 0; i < N; ++i)
+    {
+        maszynaOperacji[i] = operacje[i].machine_id;
+        liczbaOperacjiNaMaszynie[operacje[i].machine_id]++;
+    }
+    maksOperacjiMaszyny = 0;
+    for (int m = 0; m < liczbaMaszyn; ++m)
+        maksOperacjiMaszyny = std::max(maksOperacjiMaszyny, liczbaOperacjiNaMaszynie[m]);
+
+    for (int j = 0; j < liczbaJobow; ++j)
+    {
+        poczatekJoba[j + 1] = poczatekJoba[j] + liczbaOperacjiNaJob[j];
+        maksOperacjiJoba = std::max(maksOperacjiJoba, liczbaOperacjiNaJob[j]);
+    }
+
+    operacjeJobow.assign(N, -1);
+    for (int i = 0; i < N; ++i)
+    {
+        operacjeJobow[poczatekJoba[operacje[i].job_id] + operacje[i].operation_id] = i;
+    }
+
+    pracaJoba.assign(liczbaJobow, 0);
+    pracaMaszyny.assign(liczbaMaszyn, 0);
+    for (int i = 0; i < N; ++i)
+    {
+        pracaJoba[operacje[i].job_id] += operacje[i].processing_time;
+        pracaMaszyny[operacje[i].machine_id] += operacje[i].processing_time;
+    }
+
+    kubelek.resize(N);
+    przebieg.resize(N);
+    licznikPrzebiegu.resize(maksOperacjiJoba + 1);
+    kolejnosc.resize(N);
+    nastepnaOperacjaJoba.resize(liczbaJobow);
+    startOperacji.resize(N);
+    pozycjaNaMaszynie.resize(liczbaMaszyn);
+    maszyna_wolna_od.resize(liczbaMaszyn);
+    job_gotowy_od.resize(liczbaJobow);
+    dolnyKoniec.resize(std::max(liczbaJobow, liczbaMaszyn));
+    lukiMaszyn.resize(liczbaMaszyn);
+
+    // Jądro stałego rozmiaru tylko dla pełnych instancji (każdy job ma operację na każdej maszynie)
+    JadroStale jadro = (tryb == TrybDekodera::Polaktywny) ? wybierzJadro<false>(liczbaJobow, liczbaMaszyn) : nullptr;
+    bool pasuje = jadro != nullptr && N == liczbaJobow * liczbaMaszyn && maksOperacjiJoba == liczbaMaszyn;
+    for (int i = 0; pasuje && i < N; ++i)
+    {
+        if (operacjeJobow[i] < 0 || operacje[i].processing_time < 0 || operacje[i].processing_time > 0xFFFF)
+            pasuje = false;
+    }
+    if (pasuje)
+    {
+        zwarte.resize(N);
+        for (int i = 0; i < N; ++i)
+        {
+            zwarte[i].czas = uint16_t(operacje[i].processing_time);
+            zwarte[i].maszyna = uint8_t(operacje[i].machine_id);
+            zwarte[i].job = uint8_t(operacje[i].job_id);
+        }
+        zwarteJobow.resize(N);
+        operacjeJobowZwarte.resize(N);
+        for (int k = 0; k < N; ++k)
+        {
+            zwarteJobow[k] = zwarte[operacjeJobow[k]];
+            operacjeJobowZwarte[k] = uint16_t(operacjeJobow[k]);
+        }
+        jadroStale = jadro;
+        jadroOdcinajace = wybierzJadro<true>(liczbaJobow, liczbaMaszyn);
+    }
+}
+
+template <bool Odcinanie>
+ScheduleDecoder::JadroStale ScheduleDecoder::wybierzJadro(int liczbaJobow, int liczbaMaszyn)
+{
+    if (liczbaJobow == 15 && liczbaMaszyn == 15) return &ScheduleDecoder::dekodujStaly<15, 15, Odcinanie>;
+    if (liczbaJobow == 20 && liczbaMaszyn == 15) return &ScheduleDecoder::dekodujStaly<20, 15, Odcinanie>;
+    if (liczbaJobow == 20 && liczbaMaszyn == 20) return &ScheduleDecoder::dekodujStaly<20, 20, Odcinanie>;
+    if (liczbaJobow == 30 && liczbaMaszyn == 15) return &ScheduleDecoder::dekodujStaly<30, 15, Odcinanie>;
+    if (liczbaJobow == 50 && liczbaMaszyn == 15) return &ScheduleDecoder::dekodujStaly<50, 15, Odcinanie>;
+    if (liczbaJobow == 50 && liczbaMaszyn == 20) return &ScheduleDecoder::dekodujStaly<50, 20, Odcinanie>;
+    if (liczbaJobow == 100 && liczbaMaszyn == 20) return &ScheduleDecoder::dekodujStaly<100, 20, Odcinanie>;
+    return nullptr;
+}
+
+// To samo co wyznaczKolejnosc + zaplanuj (półaktywnie, bez harmonogramu), ale z wymiarami
+// jako stałymi: pętle po operacjach joba mają stałą długość, a czasy maszyn i jobów są na stosie.
+// Z odcinaniem na stosie są też dolne ograniczenia końców maszyn (zob. zaplanuj).
+template <int J, int M, bool Odcinanie>
+int ScheduleDecoder::dekodujStaly(const std::vector<int>& genotyp, int prog)
+{
+    static_assert(J <= 256 && M <= 256 && J * M <= 0xFFFF, "za duze wymiary dla zwartych indeksow");
+    const int N = J * M;
+    const int* g = genotyp.data();
+
+    int maszynaWolna[M] = {};
+    int jobGotowy[J] = {};
+    int maksEnd = 0;
+    int dolnyKoniecMaszyny[M];
+    if (Odcinanie)
+        std::copy(pracaMaszyny.begin(), pracaMaszyny.end(), dolnyKoniecMaszyny);
+
+    if (kodowanie == Kodowanie::PowtorzeniaJobow)
+    {
+        uint8_t nastepna[J] = {};
+        const OperacjaZwarta* ops = zwarteJobow.data();
+        for (int ii = 0; ii < N; ++ii)
+        {
+            int j = g[ii];
+            const OperacjaZwarta op = ops[j * M + nastepna[j]++];
+            int start = std::max(maszynaWolna[op.maszyna], jobGotowy[j]);
+            if (Odcinanie)
+            {
+                dolnyKoniecMaszyny[op.maszyna] += start - maszynaWolna[op.maszyna];
+                if (dolnyKoniecMaszyny[op.maszyna] >= prog)
+                    return ODCIETY;
+            }
+            int end = start + op.czas;
+            maszynaWolna[op.maszyna] = end;
+            jobGotowy[j] = end;
+            if (end > maksEnd) maksEnd = end;
+        }
+        return maksEnd;
+    }
+
+    uint16_t kub[N];
+    uint8_t prz[N];
+    int licznik[M + 1] = {};
+    uint16_t kol[N];
+
+    for (int i = 0; i < N; ++i)
+        kub[g[i]] = uint16_t(i);
+
+    const uint16_t* opsJobow = operacjeJobowZwarte.data();
+    for (int j = 0; j < J; ++j)
+    {
+        const uint16_t* job = opsJobow + j * M;
+        int p = 0;
+        int poprzedni = g[job[0]];
+        prz[job[0]] = 0;
+        for (int k = 1; k < M; ++k)
+        {
+            int pr = g[job[k]];
+            p += (pr < poprzedni);
+            poprzedni = pr;
+            prz[job[k]] = uint8_t(p);
+            licznik[p + 1]++;
+        }
+        licznik[1]++;
+    }
+    for (int p = 1; p <= M; ++p)
+        licznik[p] += licznik[p - 1];
+    for (int ii = 0; ii < N; ++ii)
+    {
+        int i = kub[ii];
+        kol[licznik[prz[i]]++] = uint16_t(i);
+    }
+
+    const OperacjaZwarta* ops = zwarte.data();
+    for (int ii = 0; ii < N; ++ii)
+    {
+        const OperacjaZwarta op = ops[kol[ii]];
+        int start = std::max(maszynaWolna[op.maszyna], jobGotowy[op.job]);
+        if (Odcinanie)
+        {
+            dolnyKoniecMaszyny[op.maszyna] += start - maszynaWolna[op.maszyna];
+            if (dolnyKoniecMaszyny[op.maszyna] >= prog)
+                return ODCIETY;
+        }
+        int end = start + op.czas;
+        maszynaWolna[op.maszyna] = end;
+        jobGotowy[op.job] = end;
+        if (end > maksEnd) maksEnd = end;
+    }
+    return maksEnd;
+}
+
+void ScheduleDecoder::IndeksLuk::wyczysc()
+{
+    wezly.clear();
+    korzen = -1;
+    skrajPrawy = -1;
+    koniecMaszyny = 0;
+}
+
+bool ScheduleDecoder::IndeksLuk::przelicz(int w)
+{
+    Wezel& n = wezly[w];
+    int maks = n.koniec - n.start;
+    if (n.lewy >= 0 && wezly[n.lewy].maks > maks) maks = wezly[n.lewy].maks;
+    if (n.prawy >= 0 && wezly[n.prawy].maks > maks) maks = wezly[n.prawy].maks;
+    bool zmiana = maks != n.maks;
+    n.maks = maks;
+    return zmiana;
+}
+
+void ScheduleDecoder::IndeksLuk::obrocWGore(int w)
+{
+    const int p = wezly[w].rodzic;
+    const int g = wezly[p].rodzic;
+    if (wezly[p].lewy == w)
+    {
+        wezly[p].lewy = wezly[w].prawy;
+        if (wezly[w].prawy >= 0) wezly[wezly[w].prawy].rodzic = p;
+        wezly[w].prawy = p;
+    }
+    else
+    {
+        wezly[p].prawy = wezly[w].lewy;
+        if (wezly[w].lewy >= 0) wezly[wezly[w].lewy].rodzic = p;
+        wezly[w].lewy = p;
+    }
+    wezly[p].rodzic = w;
+    wezly[w].rodzic = g;
+    if (g < 0) korzen = w;
+    else if (wezly[g].lewy == p) wezly[g].lewy = w;
+    else wezly[g].prawy = w;
+    przelicz(p);
+    przelicz(w);
+}
+
+void ScheduleDecoder::IndeksLuk::wstawZa(int w, int start, int koniec)
+{
+    losowy ^= losowy << 13;
+    losowy ^= losowy >> 17;
+    losowy ^= losowy << 5;
+
+    // Następnik w porządku: prawe dziecko w albo lewe dziecko najbardziej lewego węzła prawego poddrzewa
+    int rodzic = w;
+    if (w >= 0 && wezly[w].prawy >= 0)
+        for (rodzic = wezly[w].prawy; wezly[rodzic].lewy >= 0; rodzic = wezly[rodzic].lewy) {}
+    const int n = (int)wezly.size();
+    wezly.push_back(Wezel{ start, koniec, koniec - start, -1, -1, rodzic, losowy });
+    if (rodzic < 0) korzen = n;
+    else if (rodzic == w) wezly[rodzic].prawy = n;
+    else wezly[rodzic].lewy = n;
+    if (w == skrajPrawy) skrajPrawy = n;
+
+    while (wezly[n].rodzic >= 0 && wezly[n].priorytet > wezly[wezly[n].rodzic].priorytet)
+        obrocWGore(n);
+    for (int x = wezly[n].rodzic; x >= 0 && przelicz(x); x = wezly[x].rodzic) {}
+}
+
+void ScheduleDecoder::IndeksLuk::zastap(int w, int od, int doCzasu)
+{
+    const int lukaStart = wezly[w].start;
+    const int lukaKoniec = wezly[w].koniec;
+
+    // Lewa reszta (albo pusta luka) zostaje w węźle – klucz się nie zmienia albo rośnie w obrębie luki
+    if (lukaStart < od)
+        wezly[w].koniec = od;
+    else if (doCzasu < lukaKoniec)
+        wezly[w].start = doCzasu;
+    else
+        wezly[w].koniec = lukaStart;
+    for (int x = w; x >= 0 && przelicz(x); x = wezly[x].rodzic) {}
+
+    if (lukaStart < od && doCzasu < lukaKoniec)
+        wstawZa(w, doCzasu, lukaKoniec);
+}
+
+void ScheduleDecoder::IndeksLuk::zajmijKoniec(int od, int doCzasu)
+{
+    if (koniecMaszyny < od)
+        wstawZa(skrajPrawy, koniecMaszyny, od);
+    koniecMaszyny = doCzasu;
+}
+
+int ScheduleDecoder::IndeksLuk::pierwszaOd(int w, int gotowyOd, int czasTrwania) const
+{
+    // Poddrzewa bez dość długiej luki są pomijane, więc zejście ma głębokość drzewa
+    while (w >= 0 && wezly[w].maks >= czasTrwania)
+    {
+        const Wezel& n = wezly[w];
+        if (n.start <= gotowyOd)
+        {
+            w = n.prawy;
+            continue;
+        }
+        int l = pierwszaOd(n.lewy, gotowyOd, czasTrwania);
+        if (l >= 0) return l;
+        if (n.koniec - n.start >= czasTrwania) return w;
+        w = n.prawy;
+    }
+    return -1;
+}
+
+int ScheduleDecoder::IndeksLuk::wstaw(int gotowyOd, int czasTrwania)
+{
+    // Po końcu maszyny albo gdy żadna skończona luka nie jest dość długa – na koniec maszyny
+    if (gotowyOd >= koniecMaszyny || korzen < 0 || wezly[korzen].maks < czasTrwania)
+    {
+        const int start = std::max(gotowyOd, koniecMaszyny);
+        zajmijKoniec(start, start + czasTrwania);
+        return start;
+    }
+
+    // Luka zawierająca gotowyOd (ostatnia o początku <= gotowyOd) – w niej start = gotowyOd
+    int zawierajaca = -1;
+    for (int w = korzen; w >= 0;)
+    {
+        const bool naLewo = wezly[w].start <= gotowyOd;
+        if (naLewo) zawierajaca = w;
+        w = naLewo ? wezly[w].prawy : wezly[w].lewy;
+    }
+    if (zawierajaca >= 0 && wezly[zawierajaca].koniec - gotowyOd >= czasTrwania)
+    {
+        zastap(zawierajaca, gotowyOd, gotowyOd + czasTrwania);
+        return gotowyOd;
+    }
+
+    const int luka = pierwszaOd(korzen, gotowyOd, czasTrwania);
+    if (luka < 0)
+    {
+        const int start = koniecMaszyny;
+        koniecMaszyny = start + czasTrwania;
+        return start;
+    }
+    const int start = wezly[luka].start;
+    zastap(luka, start, start + czasTrwania);
+    return start;
+}
+
+void ScheduleDecoder::IndeksLuk::zajmij(int od, int doCzasu)
+{
+    if (od >= doCzasu)
+        return;
+    if (od >= koniecMaszyny)
+    {
+        zajmijKoniec(od, doCzasu);
+        return;
+    }
+
+    // Skończone luki nachodzące na [od, doCzasu): pierwsza kończąca się po od, potem kolejne
+    // (końce rosną razem z początkami)
+    for (int pozycja = od; pozycja < doCzasu;)
+    {
+        int luka = -1;
+        for (int w = korzen; w >= 0;)
+        {
+            if (wezly[w].koniec > pozycja)
+            {
+                luka = w;
+                w = wezly[w].lewy;
+            }
+            else
+            {
+                w = wezly[w].prawy;
+            }
+        }
+        if (luka < 0 || wezly[luka].start >= doCzasu)
+            break;
+        pozycja = wezly[luka].koniec;
+        zastap(luka, od, doCzasu);
+    }
+    if (doCzasu > koniecMaszyny)
+        koniecMaszyny = doCzasu;
+}
+
+int ScheduleDecoder::poPrzestojach(int maszyna, int start, int czasTrwania) const
+{
+    const std::vector<std::pair<int, int>>& przestoje = ograniczenia->przestojeMaszyn[maszyna];
+    for (int k = 0; k < (int)przestoje.size(); ++k)
+    {
+        // Przestoje są posortowane, więc przesunięcie za jeden nie cofa sprawdzenia poprzednich
+        if (start < przestoje[k].second && start + czasTrwania > przestoje[k].first)
+            start = przestoje[k].second;
+    }
+    return start;
+}
+
+void ScheduleDecoder::wyznaczKolejnosc(const std::vector<int>& genotyp)
+{
+    const int N = operacje.size();
+
+    if (kodowanie == Kodowanie::PowtorzeniaJobow)
+    {
+        // k-te wystąpienie joba j to jego k-ta operacja
+        std::fill(nastepnaOperacjaJoba.begin(), nastepnaOperacjaJoba.end(), 0);
+        for (int ii = 0; ii < N; ++ii)
+        {
+            int j = genotyp[ii];
+            kolejnosc[ii] = operacjeJobow[poczatekJoba[j] + nastepnaOperacjaJoba[j]++];
+        }
+        return;
+    }
+
+    const std::vector<int>& priorytety = genotyp;
+
+    // Bucket sort po priorytecie (priorytety to permutacja 0..N-1)
+    for (int i = 0; i < N; ++i)
+        kubelek[priorytety[i]] = i;
+
+    // Numer przebiegu, w którym stara pętla zaplanowałaby daną operację
+    std::fill(licznikPrzebiegu.begin(), licznikPrzebiegu.end(), 0);
+    for (int j = 0; j < liczbaJobow; ++j)
+    {
+        int p = 0;
+        for (int k = poczatekJoba[j]; k < poczatekJoba[j + 1]; ++k)
+        {
+            int i = operacjeJobow[k];
+            if (k > poczatekJoba[j] && priorytety[i] < priorytety[operacjeJobow[k - 1]])
+                ++p;
+            przebieg[i] = p;
+            licznikPrzebiegu[p + 1]++;
+        }
+    }
+
+    // Kolejność planowania = sortowanie po (przebieg, priorytet)
+    for (int p = 1; p <= maksOperacjiJoba; ++p)
+        licznikPrzebiegu[p] += licznikPrzebiegu[p - 1];
+    for (int ii = 0; ii < N; ++ii)
+    {
+        int i = kubelek[ii];
+        kolejnosc[licznikPrzebiegu[przebieg[i]]++] = i;
+    }
+}
+
+int ScheduleDecoder::dekoduj(const std::vector<int>& genotyp, std::vector<OperationSchedule>* harmonogram)
+{
+    METRYKA_FAZA(Dekodowanie);
+    METRYKA_DODAJ(Ewaluacje, 1);
+    if (jadroStale != nullptr && ograniczenia == nullptr && harmonogram == nullptr)
+        return (this->*jadroStale)(genotyp, ODCIETY);
+    wyznaczKolejnosc(genotyp);
+    return zaplanuj(genotyp, harmonogram);
+}
+
+int ScheduleDecoder::dekodujDo(const std::vector<int>& genotyp, int prog)
+{
+    if (prog == ODCIETY)
+        return dekoduj(genotyp);
+    METRYKA_FAZA(Dekodowanie);
+    METRYKA_DODAJ(Ewaluacje, 1);
+    int wynik;
+    if (jadroOdcinajace != nullptr && ograniczenia == nullptr)
+    {
+        wynik = (this->*jadroOdcinajace)(genotyp, prog);
+    }
+    else
+    {
+        wyznaczKolejnosc(genotyp);
+        wynik = zaplanuj(genotyp, nullptr, prog);
+    }
+    if (wynik == ODCIETY)
+        METRYKA_DODAJ(OdcieteEwaluacje, 1);
+    return wynik;
+}
+
+int ScheduleDecoder::zaplanuj(const std::vector<int>& genotyp, std::vector<OperationSchedule>* harmonogram, int prog)
+{
+    const int N = operacje.size();
+
+    std::fill(maszyna_wolna_od.begin(), maszyna_wolna_od.end(), 0);
+    std::fill(job_gotowy_od.begin(), job_gotowy_od.end(), 0);
+    bool przestoje = false;
+    if (ograniczenia != nullptr)
+    {
+        if (!ograniczenia->gotowoscMaszyny.empty())
+            maszyna_wolna_od = ograniczenia->gotowoscMaszyny;
+        if (!ograniczenia->gotowoscJoba.empty())
+            job_gotowy_od = ograniczenia->gotowoscJoba;
+        przestoje = !ograniczenia->przestojeMaszyn.empty();
+    }
+    if (tryb == TrybDekodera::WstawianieWLuki)
+    {
+        for (int m = 0; m < liczbaMaszyn; ++m)
+        {
+            lukiMaszyn[m].wyczysc();
+            lukiMaszyn[m].zajmij(0, maszyna_wolna_od[m]);
+            if (przestoje)
+            {
+                for (const std::pair<int, int>& p : ograniczenia->przestojeMaszyn[m])
+                    lukiMaszyn[m].zajmij(p.first, p.second);
+            }
+        }
+    }
+
+    if (harmonogram != nullptr)
+    {
+        harmonogram->clear();
+        harmonogram->reserve(N);
+    }
+
+    // Odcinanie: maszyna (półaktywnie) albo job (w lukach) skończy najwcześniej po całej swojej pracy
+    // i przestojach narosłych do tej pory. Przy wstawianiu w luki późniejsza operacja może trafić
+    // przed bieżącą na maszynie, więc tam ograniczeniem jest tylko job.
+    const bool odcinanie = prog != ODCIETY && harmonogram == nullptr;
+    if (odcinanie)
+    {
+        if (tryb == TrybDekodera::WstawianieWLuki)
+            for (int j = 0; j < liczbaJobow; ++j)
+                dolnyKoniec[j] = job_gotowy_od[j] + pracaJoba[j];
+        else
+            for (int m = 0; m < liczbaMaszyn; ++m)
+                dolnyKoniec[m] = maszyna_wolna_od[m] + pracaMaszyny[m];
+    }
+
+    int maksEnd = 0;
+    for (int ii = 0; ii < N; ++ii)
+    {
+        int i = kolejnosc[ii];
+        const OperationSchedule& op = operacje[i];
+
+        int start;
+        if (tryb == TrybDekodera::WstawianieWLuki)
+        {
+            start = lukiMaszyn[op.machine_id].wstaw(job_gotowy_od[op.job_id], op.processing_time);
+            startOperacji[i] = start;
+            if (odcinanie)
+            {
+                dolnyKoniec[op.job_id] += start - job_gotowy_od[op.job_id];
+                if (dolnyKoniec[op.job_id] >= prog)
+                    return ODCIETY;
+            }
+        }
+        else
+        {
+            start = std::max(maszyna_wolna_od[op.machine_id], job_gotowy_od[op.job_id]);
+            if (przestoje)
+                start = poPrzestojach(op.machine_id, start, op.processing_time);
+            if (odcinanie)
+            {
+                dolnyKoniec[op.machine_id] += start - maszyna_wolna_od[op.machine_id];
+                if (dolnyKoniec[op.machine_id] >= prog)
+                    return ODCIETY;
+            }
+            maszyna_wolna_od[op.machine_id] = start + op.processing_time;
+        }
+        int end = start + op.processing_time;
+
+        job_gotowy_od[op.job_id] = end;
+        if (end > maksEnd) maksEnd = end;
+
+        if (harmonogram != nullptr)
+        {
+            OperationSchedule zaplanowana = op;
+            zaplanowana.priority = (kodowanie == Kodowanie::PowtorzeniaJobow) ? ii : genotyp[i];
+            zaplanowana.start_time = start;
+            zaplanowana.end_time = end;
+            harmonogram->push_back(zaplanowana);
+        }
+    }
+
+    return maksEnd;
+}
+
+uint64_t ScheduleDecoder::hashSekwencji()
+{
+    const int N = operacje.size();
+    uint64_t h = SOL_SEKWENCJI;
+
+    if (tryb == TrybDekodera::WstawianieWLuki)
+    {
+        // Kolejność na maszynie wynika dopiero z czasów startu, które ją jednoznacznie wyznaczają
+        for (int i = 0; i < N; ++i)
+            h ^= EvaluationCache::zobrist(i, startOperacji[i]);
+        return h;
+    }
+
+    // Półaktywnie: k-ta operacja danej maszyny w kolejności planowania jest k-ta na maszynie
+    std::fill(pozycjaNaMaszynie.begin(), pozycjaNaMaszynie.end(), 0);
+
+    if ((long long)N * maksOperacjiMaszyny > MAKS_TABLICA_ZOBRISTA)
+    {
+        for (int ii = 0; ii < N; ++ii)
+        {
+            int i = kolejnosc[ii];
+            h ^= EvaluationCache::zobrist(i, pozycjaNaMaszynie[maszynaOperacji[i]]++);
+        }
+        return h;
+    }
+
+    if (tablicaZobrista.empty())
+    {
+        tablicaZobrista.resize(N * maksOperacjiMaszyny);
+        for (int i = 0; i < N; ++i)
+            for (int k = 0; k < maksOperacjiMaszyny; ++k)
+                tablicaZobrista[i * maksOperacjiMaszyny + k] = EvaluationCache::zobrist(i, k);
+    }
+
+    for (int ii = 0; ii < N; ++ii)
+    {
+        int i = kolejnosc[ii];
+        h ^= tablicaZobrista[i * maksOperacjiMaszyny + pozycjaNaMaszynie[maszynaOperacji[i]]++];
+    }
+    return h;
+}
+
+int ScheduleDecoder::ocen(const std::vector<int>& genotyp, uint64_t hashGenotypu)
+{
+    return ocenDo(genotyp, hashGenotypu, ODCIETY);
+}
+
+int ScheduleDecoder::ocenDo(const std::vector<int>& genotyp, uint64_t hashGenotypu, int prog)
+{
+    METRYKA_FAZA(Dekodowanie);
+    METRYKA_DODAJ(Ewaluacje, 1);
+    bool sekwencje = liczPodpis || (cache != nullptr && cache->czyKluczSekwencji());
+
+    // Wpis bez podpisu (zapisany bez liczenia sekwencji) nie wystarcza, gdy podpis jest potrzebny
+    uint64_t dane;
+    if (cache != nullptr && cache->szukaj(hashGenotypu, dane) && (!liczPodpis || (dane >> 32) != 0))
+    {
+        cache->policzTrafienieGenotypu();
+        podpis = uint32_t(dane >> 32);
+        int makespan = int(dane & 0xFFFFFFFFu);
+        return (makespan < prog) ? makespan : ODCIETY;
+    }
+
+    JadroStale jadro = (prog == ODCIETY) ? jadroStale : jadroOdcinajace;
+    if (!sekwencje && jadro != nullptr && ograniczenia == nullptr)
+    {
+        int makespan = (this->*jadro)(genotyp, prog);
+        podpis = 0;
+        if (cache != nullptr)
+            cache->policzChybienie();
+        if (makespan == ODCIETY)
+        {
+            METRYKA_DODAJ(OdcieteEwaluacje, 1);
+            return ODCIETY;
+        }
+        if (cache != nullptr)
+            cache->zapisz(hashGenotypu, uint32_t(makespan));
+        return makespan;
+    }
+
+    wyznaczKolejnosc(genotyp);
+
+    // Półaktywny harmonogram jest wyznaczony przez sekwencje maszyn, więc różne genotypy
+    // z tymi samymi sekwencjami nie potrzebują liczenia czasów
+    uint64_t hash = 0;
+    if (sekwencje && tryb == TrybDekodera::Polaktywny)
+    {
+        hash = hashSekwencji();
+        if (cache != nullptr && cache->szukaj(hash, dane))
+        {
+            cache->policzTrafienieSekwencji();
+            cache->zapisz(hashGenotypu, dane);
+            podpis = uint32_t(dane >> 32);
+            int makespan = int(dane & 0xFFFFFFFFu);
+            return (makespan < prog) ? makespan : ODCIETY;
+        }
+    }
+
+    int makespan = zaplanuj(genotyp, nullptr, prog);
+    if (cache != nullptr)
+        cache->policzChybienie();
+    if (makespan == ODCIETY)
+    {
+        podpis = 0;
+        METRYKA_DODAJ(OdcieteEwaluacje, 1);
+        return ODCIETY;
+    }
+    if (sekwencje && tryb == TrybDekodera::WstawianieWLuki)
+        hash = hashSekwencji();
+
+    podpis = uint32_t(hash >> 32);
+    if (cache != nullptr)
+    {
+        dane = (uint64_t(podpis) << 32) | uint32_t(makespan);
+        cache->zapisz(hashGenotypu, dane);
+        if (sekwencje) cache->zapisz(hash, dane);
+    }
+    return makespan;
+}
@@ -0,0 +1,190 @@
+#ifndef SCHEDULE_DECODER_H
+#define SCHEDULE_DECODER_H
+
+#include "OperationSchedule.h"
+#include "Encoding.h"
+#include "EvaluationCache.h"
+#include <vector>
+#include <cstdint>
+#include <limits>
+
+// Sposób wyznaczania czasu startu operacji podczas dekodowania genotypu
+enum class TrybDekodera
+{
+    Polaktywny,      // operacja startuje po ostatniej operacji na swojej maszynie (dotychczasowe zachowanie)
+    WstawianieWLuki  // operacja trafia do najwcześniejszej luki na maszynie, w której się mieści
+};
+
+// Warunki brzegowe przy przeplanowaniu (zob. Rescheduler): od kiedy joby i maszyny są wolne
+// (po operacjach zamrożonych) oraz okna niedostępności maszyn. Puste wektory = brak ograniczeń.
+struct OgraniczeniaCzasowe
+{
+    std::vector<int> gotowoscJoba;
+    std::vector<int> gotowoscMaszyny;
+    std::vector<std::vector<std::pair<int, int>>> przestojeMaszyn; // [m]: posortowane, rozłączne [od, do)
+};
+
+// Wspólny dekoder genotypu.
+// Kodowanie priorytetowe: kolejność planowania jest taka sama jak w wieloprzebiegowej
+// pętli z solverów, ale liczona w jednym przebiegu: operacja trafia do przebiegu poprzedniej
+// operacji swojego joba albo do następnego, jeśli ma od niej mniejszy priorytet.
+// Kodowanie z powtórzeniami: genotyp czytany jest od lewej do prawej bez żadnego sprawdzania gotowości.
+// Bufory robocze są trzymane w obiekcie, więc jeden dekoder wystarcza na cały solve().
+class ScheduleDecoder
+{
+public:
+    ScheduleDecoder(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                    TrybDekodera tryb = TrybDekodera::Polaktywny,
+                    Kodowanie kodowanie = Kodowanie::Priorytety);
+
+    // Zwraca makespan. Jeśli harmonogram != nullptr, wpisuje do niego operacje
+    // (z czasami) w kolejności planowania. Pole priority to wartość genu dla kodowania
+    // priorytetowego albo pozycja w genotypie dla kodowania z powtórzeniami.
+    int dekoduj(const std::vector<int>& genotyp, std::vector<OperationSchedule>* harmonogram = nullptr);
+
+    // Sama ocena z pamięcią podręczną: najpierw klucz genotypu, potem (półaktywnie, jeśli cache
+    // ma włączony klucz sekwencji) klucz sekwencji maszyn przed liczeniem czasów.
+    // hashGenotypu można aktualizować przyrostowo (EvaluationCache::hashPoZamianie),
+    // wtedy trafienie kosztuje O(1).
+    int ocen(const std::vector<int>& genotyp, uint64_t hashGenotypu);
+    int ocen(const std::vector<int>& genotyp) { return ocen(genotyp, EvaluationCache::hashGenotypu(genotyp)); }
+
+    // Wynik oceny przerwanej, bo kandydat nie może być lepszy od progu
+    static const int ODCIETY = std::numeric_limits<int>::max();
+
+    // Ocena z progiem odcięcia: wynik < prog jest dokładnym makespanem, każdy inny to ODCIETY.
+    // Dekodowanie kończy się, gdy czas zwolnienia maszyny (w lukach: joba) plus jej pozostała
+    // praca osiąga prog – wtedy ten harmonogram nie może być krótszy.
+    // Odcięte oceny nie trafiają do cache; prog == ODCIETY to zwykłe dekoduj()/ocen().
+    int dekodujDo(const std::vector<int>& genotyp, int prog);
+    int ocenDo(const std::vector<int>& genotyp, uint64_t hashGenotypu, int prog);
+
+    // Cache jest współdzielony (np. między runami) i nie należy do dekodera; nullptr = bez cache
+    void ustawCache(EvaluationCache* c) { cache = c; }
+
+    // 32-bitowy podpis harmonogramu z ostatniego ocen() – równe podpisy = ten sam harmonogram.
+    // Liczony tylko po włączeniu (np. do odrzucania duplikatów w EA) albo przy kluczu sekwencji.
+    void ustawLiczeniePodpisu(bool licz) { liczPodpis = licz; }
+    uint32_t getPodpis() const { return podpis; }
+
+    // Ograniczenia nie należą do dekodera i nie mogą się zmieniać w trakcie solve();
+    // cache używany z ograniczeniami nie może być współdzielony z dekoderem bez nich
+    void ustawOgraniczenia(const OgraniczeniaCzasowe* o) { ograniczenia = o; }
+
+    // Czy ocena idzie przez jądro skompilowane dla wymiarów tej instancji
+    bool czyJadroStale() const { return jadroStale != nullptr && ograniczenia == nullptr; }
+
+    TrybDekodera getTryb() const { return tryb; }
+    Kodowanie getKodowanie() const { return kodowanie; }
+    int getLiczbaOperacji() const { return (int)operacje.size(); }
+
+private:
+    // Luki (przedziały bezczynności) jednej maszyny. Skończone luki leżą w drzewie (treap) po początku
+    // luki z najdłuższą luką w poddrzewie, więc najwcześniejsza luka, w której mieści się operacja,
+    // jest znajdowana w O(log k), a gdy żadna nie jest dość długa – od razu po korzeniu. Otwarty koniec
+    // maszyny jest trzymany osobno. Zajęcie zmienia lukę w miejscu i co najwyżej dokłada jeden węzeł
+    // tuż za nią; wypełniona luka zostaje jako pusta (nigdy nie pasuje). Węzły leżą w płaskiej puli
+    // czyszczonej przy każdym dekodowaniu – po rozgrzaniu bez alokacji.
+    struct IndeksLuk
+    {
+        struct Wezel
+        {
+            int start;
+            int koniec;
+            int maks; // najdłuższa luka w poddrzewie
+            int lewy;
+            int prawy;
+            int rodzic;
+            uint32_t priorytet;
+        };
+        std::vector<Wezel> wezly;
+        int korzen = -1;
+        int skrajPrawy = -1;   // ostatnia skończona luka
+        int koniecMaszyny = 0; // od tego czasu maszyna jest wolna bez końca
+        uint32_t losowy = 0x9E3779B9u;
+
+        void wyczysc();
+        int wstaw(int gotowyOd, int czasTrwania); // zwraca czas startu i zajmuje przedział
+        void zajmij(int od, int doCzasu);          // usuwa [od, doCzasu) z luk
+
+    private:
+        bool przelicz(int w);                                        // true, gdy maks się zmienił
+        void obrocWGore(int w);
+        void wstawZa(int w, int start, int koniec);                  // nowa luka tuż za w (-1: pusty indeks)
+        int pierwszaOd(int w, int gotowyOd, int czasTrwania) const;  // start > gotowyOd, długość >= czasTrwania
+        void zastap(int w, int od, int doCzasu);                     // luka w bez [od, doCzasu)
+        void zajmijKoniec(int od, int doCzasu);                      // [od, doCzasu) z od >= koniecMaszyny
+    };
+
+    std::vector<OperationSchedule> operacje;
+    int liczbaJobow;
+    int liczbaMaszyn;
+    TrybDekodera tryb;
+    Kodowanie kodowanie;
+
+    // Wypełnia "kolejnosc" indeksami operacji w kolejności planowania
+    void wyznaczKolejnosc(const std::vector<int>& genotyp);
+    // Najwcześniejszy start >= start, przy którym operacja nie nachodzi na przestój maszyny
+    int poPrzestojach(int maszyna, int start, int czasTrwania) const;
+    // Liczy czasy dla bieżącej "kolejnosc", zwraca makespan (albo ODCIETY, gdy osiągnie prog)
+    int zaplanuj(const std::vector<int>& genotyp, std::vector<OperationSchedule>* harmonogram, int prog = ODCIETY);
+    // Hash Zobrista sekwencji maszyn bieżącego harmonogramu (oddzielony solą od kluczy genotypów)
+    uint64_t hashSekwencji();
+    static const uint64_t SOL_SEKWENCJI = 0x5EC0E1CE5EC0E1CEULL;
+
+    // Tablica Zobrista (operacja, pozycja na maszynie) – budowana leniwie i tylko dla
+    // instancji, dla których jest mała; inaczej składniki liczone są w locie
+    std::vector<uint64_t> tablicaZobrista;
+    int maksOperacjiMaszyny;
+    static const int MAKS_TABLICA_ZOBRISTA = 1 << 18;
+
+    // Operacje każdego joba w kolejności technologicznej (CSR: poczatekJoba[j]..poczatekJoba[j+1])
+    std::vector<int> poczatekJoba;
+    std::vector<int> operacjeJobow;
+    int maksOperacjiJoba;
+    std::vector<int> maszynaOperacji; // kopia machine_id w zwartej tablicy dla pętli hashujących
+
+    // Suma czasów operacji joba i maszyny – dolne ograniczenia do odcinania
+    std::vector<int> pracaJoba;
+    std::vector<int> pracaMaszyny;
+
+    // Jądra dla typowych wymiarów benchmarków (15x15 ... 100x20): liczba jobów i maszyn
+    // znana w czasie kompilacji, bufory na stosie, operacje upakowane w 4 bajty.
+    // Używane półaktywnie, gdy nie trzeba harmonogramu ani sekwencji; nullptr = ogólna ścieżka.
+    // Wariant z odcinaniem jest osobną instancją, żeby zwykła ocena nie płaciła za sprawdzanie progu.
+    typedef int (ScheduleDecoder::*JadroStale)(const std::vector<int>& genotyp, int prog);
+    JadroStale jadroStale;
+    JadroStale jadroOdcinajace;
+    template <bool Odcinanie> static JadroStale wybierzJadro(int liczbaJobow, int liczbaMaszyn);
+    template <int J, int M, bool Odcinanie> int dekodujStaly(const std::vector<int>& genotyp, int prog);
+
+    struct OperacjaZwarta
+    {
+        uint16_t czas;
+        uint8_t maszyna;
+        uint8_t job;
+    };
+    std::vector<OperacjaZwarta> zwarte;         // po indeksie operacji
+    std::vector<OperacjaZwarta> zwarteJobow;    // j*M + k = k-ta operacja joba j
+    std::vector<uint16_t> operacjeJobowZwarte;  // j*M + k -> indeks operacji
+
+    // Bufory robocze
+    std::vector<int> kubelek;
+    std::vector<int> przebieg;
+    std::vector<int> licznikPrzebiegu;
+    std::vector<int> kolejnosc;
+    std::vector<int> nastepnaOperacjaJoba;
+    std::vector<int> startOperacji;
+    std::vector<int> pozycjaNaMaszynie;
+    std::vector<int> maszyna_wolna_od;
+    std::vector<int> job_gotowy_od;
+    std::vector<int> dolnyKoniec;
+    std::vector<IndeksLuk> lukiMaszyn;
+
+    const OgraniczeniaCzasowe* ograniczenia;
+    EvaluationCache* cache;
+    bool liczPodpis;
+    uint32_t podpis;
+};
+
+#endif
@@ -0,0 +1,332 @@
+#include "ShiftingBottleneck.h"
+#include "SolutionArchive.h"
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <limits>
+
+ShiftingBottleneck::ShiftingBottleneck()
+{
+    this->operacje = nullptr;
+    this->liczbaMaszyn = 0;
+    this->limitWezlow = 200;
+    this->rundyReoptymalizacji = 5;
+    this->wezly = 0;
+    this->makespan = 0;
+}
+
+void ShiftingBottleneck::solve(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn)
+{
+    this->operacje = &operacje;
+    this->liczbaMaszyn = liczbaMaszyn;
+    const int N = operacje.size();
+
+    std::vector<std::vector<int>> indeks(liczbaJobow);
+    operacjeMaszyny.assign(liczbaMaszyn, std::vector<int>());
+    for (int i = 0; i < N; ++i)
+    {
+        const OperationSchedule& op = operacje[i];
+        if (op.operation_id >= (int)indeks[op.job_id].size())
+            indeks[op.job_id].resize(op.operation_id + 1, -1);
+        indeks[op.job_id][op.operation_id] = i;
+        operacjeMaszyny[op.machine_id].push_back(i);
+    }
+    poprzednikJoba.assign(N, -1);
+    nastepnikJoba.assign(N, -1);
+    for (int i = 0; i < N; ++i)
+        if (operacje[i].operation_id > 0)
+        {
+            int p = indeks[operacje[i].job_id][operacje[i].operation_id - 1];
+            poprzednikJoba[i] = p;
+            nastepnikJoba[p] = i;
+        }
+    poprzednikMaszyny.assign(N, -1);
+    nastepnikMaszyny.assign(N, -1);
+    sekwencje.assign(liczbaMaszyn, std::vector<int>());
+    glowa.assign(N, 0);
+    ogon.assign(N, 0);
+    pozycjaTopologiczna.assign(N, 0);
+    przeliczGraf();
+
+    std::vector<bool> uszeregowana(liczbaMaszyn, false);
+    std::vector<int> uszeregowane;
+    for (int krok = 0; krok < liczbaMaszyn; ++krok)
+    {
+        // Wąskie gardło: maszyna o największym Cmax podproblemu
+        int waskieGardlo = -1;
+        int najwiekszyCmax = -1;
+        std::vector<int> sekwencjaGardla, sekwencja;
+        for (int m = 0; m < liczbaMaszyn; ++m)
+        {
+            if (uszeregowana[m])
+                continue;
+            int cmax = szereguj(m, sekwencja);
+            if (cmax > najwiekszyCmax)
+            {
+                najwiekszyCmax = cmax;
+                waskieGardlo = m;
+                sekwencjaGardla.swap(sekwencja);
+            }
+        }
+        if (waskieGardlo < 0)
+            break;
+
+        ustawSekwencje(waskieGardlo, sekwencjaGardla);
+        if (!przeliczGraf())
+        {
+            // Zmienione przez Carliera głowy/ogony mogą zamknąć cykl przez inne maszyny;
+            // kolejność topologiczna grafu bez tej maszyny zawsze jest dopuszczalna
+            usunSekwencje(waskieGardlo);
+            przeliczGraf();
+            sekwencjaGardla = operacjeMaszyny[waskieGardlo];
+            std::sort(sekwencjaGardla.begin(), sekwencjaGardla.end(),
+                      [&](int a, int b) { return pozycjaTopologiczna[a] < pozycjaTopologiczna[b]; });
+            ustawSekwencje(waskieGardlo, sekwencjaGardla);
+            przeliczGraf();
+        }
+        uszeregowana[waskieGardlo] = true;
+        uszeregowane.push_back(waskieGardlo);
+
+        // Reoptymalizacja: każda wcześniejsza maszyna jest zdejmowana i szeregowana od nowa
+        for (int runda = 0; runda < rundyReoptymalizacji; ++runda)
+        {
+            bool zmiana = false;
+            for (int m : uszeregowane)
+            {
+                if (m == waskieGardlo && runda == 0)
+                    continue;
+                std::vector<int> stara = sekwencje[m];
+                usunSekwencje(m);
+                przeliczGraf();
+
+                int staryCmax = ocenSekwencje(stara);
+                int nowyCmax = szereguj(m, sekwencja);
+                if (nowyCmax < staryCmax)
+                {
+                    ustawSekwencje(m, sekwencja);
+                    if (przeliczGraf())
+                    {
+                        zmiana = true;
+                        continue;
+                    }
+                    usunSekwencje(m);
+                }
+                ustawSekwencje(m, stara);
+                przeliczGraf();
+            }
+            if (!zmiana)
+                break;
+        }
+    }
+
+    // Głowy w pełnym grafie to starty harmonogramu półaktywnego
+    przeliczGraf();
+    makespan = 0;
+    schedule = operacje;
+    for (int i = 0; i < N; ++i)
+    {
+        schedule[i].start_time = glowa[i];
+        schedule[i].end_time = glowa[i] + operacje[i].processing_time;
+        makespan = std::max(makespan, schedule[i].end_time);
+    }
+    kolejnosc = porzadek;
+    std::stable_sort(kolejnosc.begin(), kolejnosc.end(), [&](int a, int b) { return glowa[a] < glowa[b]; });
+}
+
+std::vector<int> ShiftingBottleneck::getGenotyp(Kodowanie kodowanie) const
+{
+    return genotypZKolejnosci(schedule, kolejnosc, kodowanie);
+}
+
+bool ShiftingBottleneck::przeliczGraf()
+{
+    const std::vector<OperationSchedule>& ops = *operacje;
+    const int N = ops.size();
+
+    std::vector<int> stopien(N);
+    porzadek.clear();
+    for (int i = 0; i < N; ++i)
+    {
+        stopien[i] = (poprzednikJoba[i] >= 0) + (poprzednikMaszyny[i] >= 0);
+        if (stopien[i] == 0)
+            porzadek.push_back(i);
+        glowa[i] = 0;
+        ogon[i] = 0;
+    }
+    for (int k = 0; k < (int)porzadek.size(); ++k)
+    {
+        int i = porzadek[k];
+        pozycjaTopologiczna[i] = k;
+        int koniec = glowa[i] + ops[i].processing_time;
+        for (int n : { nastepnikJoba[i], nastepnikMaszyny[i] })
+        {
+            if (n < 0)
+                continue;
+            glowa[n] = std::max(glowa[n], koniec);
+            if (--stopien[n] == 0)
+                porzadek.push_back(n);
+        }
+    }
+    if ((int)porzadek.size() < N)
+        return false;
+
+    for (int k = N - 1; k >= 0; --k)
+    {
+        int i = porzadek[k];
+        for (int n : { nastepnikJoba[i], nastepnikMaszyny[i] })
+            if (n >= 0)
+                ogon[i] = std::max(ogon[i], ops[n].processing_time + ogon[n]);
+    }
+    return true;
+}
+
+void ShiftingBottleneck::ustawSekwencje(int maszyna, const std::vector<int>& sekwencja)
+{
+    sekwencje[maszyna] = sekwencja;
+    for (int k = 0; k < (int)sekwencja.size(); ++k)
+    {
+        poprzednikMaszyny[sekwencja[k]] = (k > 0) ? sekwencja[k - 1] : -1;
+        nastepnikMaszyny[sekwencja[k]] = (k + 1 < (int)sekwencja.size()) ? sekwencja[k + 1] : -1;
+    }
+}
+
+void ShiftingBottleneck::usunSekwencje(int maszyna)
+{
+    for (int i : sekwencje[maszyna])
+    {
+        poprzednikMaszyny[i] = -1;
+        nastepnikMaszyny[i] = -1;
+    }
+    sekwencje[maszyna].clear();
+}
+
+int ShiftingBottleneck::ocenSekwencje(const std::vector<int>& sekwencja) const
+{
+    int t = 0;
+    int cmax = 0;
+    for (int i : sekwencja)
+    {
+        t = std::max(t, glowa[i]) + (*operacje)[i].processing_time;
+        cmax = std::max(cmax, t + ogon[i]);
+    }
+    return cmax;
+}
+
+int ShiftingBottleneck::szereguj(int maszyna, std::vector<int>& sekwencja)
+{
+    const std::vector<int>& ops = operacjeMaszyny[maszyna];
+    std::vector<ZadanieJednomaszynowe> zadania(ops.size());
+    for (int k = 0; k < (int)ops.size(); ++k)
+    {
+        zadania[k].r = glowa[ops[k]];
+        zadania[k].p = (*operacje)[ops[k]].processing_time;
+        zadania[k].q = ogon[ops[k]];
+    }
+
+    int cmax = std::numeric_limits<int>::max();
+    std::vector<int> najlepsza;
+    wezly = 0;
+    carlier(zadania, cmax, najlepsza);
+
+    sekwencja.resize(najlepsza.size());
+    for (int k = 0; k < (int)najlepsza.size(); ++k)
+        sekwencja[k] = ops[najlepsza[k]];
+    return ops.empty() ? 0 : cmax;
+}
+
+// Schrage: spośród dostępnych zadań zawsze to z największym ogonem (remis: mniejszy indeks)
+int ShiftingBottleneck::schrage(const std::vector<ZadanieJednomaszynowe>& zadania, std::vector<int>& kolejnoscZadan) const
+{
+    const int n = zadania.size();
+    std::vector<int> wgGlowy(n);
+    std::iota(wgGlowy.begin(), wgGlowy.end(), 0);
+    std::stable_sort(wgGlowy.begin(), wgGlowy.end(), [&](int a, int b) { return zadania[a].r < zadania[b].r; });
+
+    std::priority_queue<std::pair<int, int>> dostepne; // (ogon, -indeks)
+    kolejnoscZadan.clear();
+    int t = 0;
+    int cmax = 0;
+    int k = 0;
+    while (k < n || !dostepne.empty())
+    {
+        if (dostepne.empty() && zadania[wgGlowy[k]].r > t)
+            t = zadania[wgGlowy[k]].r;
+        while (k < n && zadania[wgGlowy[k]].r <= t)
+        {
+            dostepne.push(std::make_pair(zadania[wgGlowy[k]].q, -wgGlowy[k]));
+            ++k;
+        }
+        int i = -dostepne.top().second;
+        dostepne.pop();
+        kolejnoscZadan.push_back(i);
+        t += zadania[i].p;
+        cmax = std::max(cmax, t + zadania[i].q);
+    }
+    return cmax;
+}
+
+void ShiftingBottleneck::carlier(std::vector<ZadanieJednomaszynowe>& zadania, int& najlepszyCmax, std::vector<int>& najlepsza)
+{
+    if (++wezly > limitWezlow)
+        return;
+
+    std::vector<int> sek;
+    int u = schrage(zadania, sek);
+    if (u < najlepszyCmax)
+    {
+        najlepszyCmax = u;
+        najlepsza = sek;
+    }
+
+    // Ścieżka krytyczna Schrage: blok bez przestojów od a do b, b kończy się w Cmax
+    const int n = sek.size();
+    std::vector<int> start(n);
+    int t = 0;
+    int b = -1;
+    for (int k = 0; k < n; ++k)
+    {
+        const ZadanieJednomaszynowe& z = zadania[sek[k]];
+        start[k] = std::max(t, z.r);
+        t = start[k] + z.p;
+        if (t + z.q == u)
+            b = k;
+    }
+    if (b < 0)
+        return;
+    int a = b;
+    while (a > 0 && start[a - 1] + zadania[sek[a - 1]].p == start[a])
+        --a;
+
+    // Zadanie interferencyjne c: ostatnie w bloku z ogonem mniejszym niż ogon b
+    int c = -1;
+    for (int k = a; k < b; ++k)
+        if (zadania[sek[k]].q < zadania[sek[b]].q)
+            c = k;
+    if (c < 0)
+        return; // Schrage jest optymalny dla tego węzła
+
+    int rK = std::numeric_limits<int>::max(), qK = std::numeric_limits<int>::max(), pK = 0;
+    for (int k = c + 1; k <= b; ++k)
+    {
+        rK = std::min(rK, zadania[sek[k]].r);
+        qK = std::min(qK, zadania[sek[k]].q);
+        pK += zadania[sek[k]].p;
+    }
+    ZadanieJednomaszynowe& zc = zadania[sek[c]];
+
+    // Gałąź 1: c po bloku K
+    int stare = zc.r;
+    zc.r = std::max(zc.r, rK + pK);
+    std::vector<ZadanieJednomaszynowe> kopia = zadania;
+    if (std::max(rK + pK + qK, preemptywnyJackson(kopia)) < najlepszyCmax)
+        carlier(zadania, najlepszyCmax, najlepsza);
+    zc.r = stare;
+
+    // Gałąź 2: c przed blokiem K
+    stare = zc.q;
+    zc.q = std::max(zc.q, qK + pK);
+    kopia = zadania;
+    if (std::max(rK + pK + qK, preemptywnyJackson(kopia)) < najlepszyCmax)
+        carlier(zadania, najlepszyCmax, najlepsza);
+    zc.q = stare;
+}
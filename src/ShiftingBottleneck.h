@@ -0,0 +1,62 @@
+#ifndef SHIFTING_BOTTLENECK_H
+#define SHIFTING_BOTTLENECK_H
+
+#include "OperationSchedule.h"
+#include "Encoding.h"
+#include "LowerBounds.h"
+#include <vector>
+
+// Shifting Bottleneck (Adams, Balas, Zawack): maszyny są szeregowane po jednej. W każdym kroku
+// dla każdej jeszcze nieuszeregowanej maszyny rozwiązywany jest problem 1|r_j,q_j|Cmax z głowami
+// i ogonami z grafu dysjunkcyjnego (Carlier z limitem węzłów, start od Schrage), maszyna o największym
+// Cmax (wąskie gardło) dostaje swoją sekwencję, a wcześniej uszeregowane maszyny są po kolei
+// przeoptymalizowywane. Wynik służy jako dobre rozwiązanie startowe solverów.
+class ShiftingBottleneck
+{
+public:
+    ShiftingBottleneck();
+
+    void solve(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn);
+
+    // Limit węzłów Carliera na podproblem (po nim zostaje najlepsza znaleziona sekwencja)
+    void ustawLimitWezlow(int n) { limitWezlow = n; }
+    // Ile razy po dodaniu maszyny przechodzimy po wcześniejszych (kończy się wcześniej bez zmian)
+    void ustawRundyReoptymalizacji(int n) { rundyReoptymalizacji = n; }
+
+    int getMakespan() const { return makespan; }
+    const std::vector<OperationSchedule>& getSchedule() const { return schedule; }
+    // Kolejność operacji (indeksy instancji posortowane po starcie) i genotyp, który ją odtwarza
+    const std::vector<int>& getKolejnosc() const { return kolejnosc; }
+    std::vector<int> getGenotyp(Kodowanie kodowanie) const;
+
+private:
+    // Głowy, ogony i kolejność topologiczna dla uszeregowanych maszyn; false przy cyklu
+    bool przeliczGraf();
+    // Sekwencja maszyny minimalizująca Cmax podproblemu przy bieżących głowach i ogonach
+    int szereguj(int maszyna, std::vector<int>& sekwencja);
+    // Cmax podproblemu dla zadanej sekwencji
+    int ocenSekwencje(const std::vector<int>& sekwencja) const;
+    void ustawSekwencje(int maszyna, const std::vector<int>& sekwencja);
+    void usunSekwencje(int maszyna);
+
+    int schrage(const std::vector<ZadanieJednomaszynowe>& zadania, std::vector<int>& kolejnoscZadan) const;
+    void carlier(std::vector<ZadanieJednomaszynowe>& zadania, int& najlepszyCmax, std::vector<int>& najlepsza);
+
+    const std::vector<OperationSchedule>* operacje;
+    int liczbaMaszyn;
+    int limitWezlow;
+    int rundyReoptymalizacji;
+    int wezly;
+
+    std::vector<std::vector<int>> operacjeMaszyny;
+    std::vector<std::vector<int>> sekwencje;    // puste = maszyna jeszcze nieuszeregowana
+    std::vector<int> poprzednikJoba, nastepnikJoba;
+    std::vector<int> poprzednikMaszyny, nastepnikMaszyny;
+    std::vector<int> glowa, ogon, porzadek, pozycjaTopologiczna;
+
+    std::vector<OperationSchedule> schedule;
+    std::vector<int> kolejnosc;
+    int makespan;
+};
+
+#endif
@@ -2,8 +2,20 @@
 #include <fstream>
 #include <iostream>
 
+std::string sciezkaSystemowa(const std::string& sciezka) {
+#ifdef _WIN32
+    return sciezka; // Windows przyjmuje oba separatory
+#else
+    std::string wynik = sciezka;
+    for (char& c : wynik)
+        if (c == '\\')
+            c = '/';
+    return wynik;
+#endif
+}
+
 bool SimpleLoader::load(const std::string& filename) {
-    std::ifstream file(filename);
+    std::ifstream file(sciezkaSystemowa(filename));
     if (!file.is_open()) {
         std::cerr << "Nie mogę otworzyć pliku: " << filename << std::endl;
         return false;
@@ -14,4 +14,7 @@ public:
     void wypisz() const;
 };
 
+// Ścieżka z separatorami systemu: "ta\\ta01.txt" i "ta/ta01.txt" działają i na Windows, i na POSIX
+std::string sciezkaSystemowa(const std::string& sciezka);
+
 #endif // SIMPLE_LOADER_H
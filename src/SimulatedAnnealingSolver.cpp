@@ -1,9 +1,20 @@
 #include "SimulatedAnnealingSolver.h"
+#include "LowerBounds.h"
+#include "Checkpoint.h"
+#include "Metrics.h"
+#include "Log.h"
+#include "SolverEvents.h"
+#include "ResultWriter.h"
+#include "Moves.h"
+#include "CriticalPath.h"
+#include "SolutionArchive.h"
 #include <iostream>
 #include <fstream>
 #include <random>
 #include <algorithm>
 #include <numeric>
+#include <memory>
+#include <chrono>
 #include <cmath> // dla exp()
 
 // Konstruktor: ustawiamy wszystkie parametry
@@ -11,267 +22,457 @@ SimulatedAnnealingSolver::SimulatedAnnealingSolver(double startTemp, double endT
 {
     temperaturaStartowa = startTemp; temperaturaKoncowa = endTemp; wspolczynnikChlodzenia = coolingRate; maksLiczbaIteracji = maxIter;
     makespan = 0;
+    trybDekodera = TrybDekodera::Polaktywny;
+    kodowanie = Kodowanie::Priorytety;
+    cel = 0;
+    dolneOgraniczenie = 0;
+    cache = nullptr;
+    ograniczenia = nullptr;
+    gen.seed(std::random_device{}());
+    coIleCheckpoint = 0;
+    rodzajRuchu = RodzajRuchu::Zamiana;
+    sasiedztwo = SasiedztwoSA::Losowe;
+    adaptacyjny = false;
+    akceptacjaStartowa = 0.5;
+    akceptacjaKoncowa = 1e-6;
+    limitCzasu = 0.0;
 }
 
-std::vector<OperationSchedule> SimulatedAnnealingSolver::zbudujHarmonogramZPriorytetami(
-    const std::vector<int>& priorytety,
-    const std::vector<OperationSchedule>& operacje,
-    int liczbaJobow,
-    int liczbaMaszyn)
+void SimulatedAnnealingSolver::solve(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn)
 {
-    std::vector<OperationSchedule> kandydaci = operacje;
-    for (int i = 0; i < kandydaci.size(); ++i)
+    int liczbaOperacji = operacje.size();
+    ScheduleDecoder dekoder(operacje, liczbaJobow, liczbaMaszyn, trybDekodera, kodowanie);
+    dekoder.ustawCache(cache);
+    dekoder.ustawOgraniczenia(ograniczenia);
+    auto startSolve = std::chrono::steady_clock::now();
+
+    Stan stan;
+    std::vector<int>& aktualnyGenotyp = stan.aktualnyGenotyp;
+    int& aktualnyKoszt = stan.aktualnyKoszt;
+    std::vector<int>& najlepszyGenotyp = stan.najlepszyGenotyp;
+    int& najlepszyKoszt = stan.najlepszyKoszt;
+    double& T = stan.T;
+    int& iteracja = stan.iteracja;
+    Adaptacja& ad = stan.adaptacja;
+
+    uint64_t sumaInstancji = sumaKontrolnaInstancji(operacje, liczbaJobow, liczbaMaszyn);
+    bool wznowiony = !plikWznowienia.empty() && wczytajCheckpoint(sumaInstancji, stan);
+    if (!wznowiony)
     {
-        kandydaci[i].priority = priorytety[i];
+        // === Krok 1: Rozwiązanie początkowe (podane z zewnątrz albo losowe) ===
+        aktualnyGenotyp = genotypBazowy(operacje, kodowanie);
+        if (genotypStartowy.size() == aktualnyGenotyp.size())
+            aktualnyGenotyp = genotypStartowy;
+        else
+            std::shuffle(aktualnyGenotyp.begin(), aktualnyGenotyp.end(), gen);
+        aktualnyKoszt = dekoder.dekoduj(aktualnyGenotyp);
+
+        najlepszyGenotyp = aktualnyGenotyp;
+        najlepszyKoszt = aktualnyKoszt;
+
+        // === Krok 2: Parametry SA ===
+        T = temperaturaStartowa;
+        iteracja = 0;
+        ad = Adaptacja();
     }
+    uint64_t hashAktualny = (cache != nullptr) ? EvaluationCache::hashGenotypu(aktualnyGenotyp) : 0;
+
+    std::uniform_int_distribution<> dist(0, liczbaOperacji - 1);
+    std::uniform_real_distribution<double> los(0.0, 1.0);
+
+    std::unique_ptr<CheckpointWriter> zapis;
+    if (!plikCheckpointu.empty())
+        zapis.reset(new CheckpointWriter(plikCheckpointu));
+
+    // Ruch losowy to zamiana genów w miejscu, cofana przy odrzuceniu. Ruch krytyczny zmienia kolejność
+    // operacji bloku na maszynie i buduje z niej nowy genotyp (kolejność topologiczna jak w PathRelinking),
+    // bo zamiana genów nie musi zamienić operacji miejscami w harmonogramie.
+    std::vector<Ruch> ruchy;
+    const bool krytyczne = sasiedztwo == SasiedztwoSA::Krytyczne;
+    SciezkaKrytyczna sciezka(operacje, liczbaJobow, liczbaMaszyn, kodowanie);
+    std::vector<OperationSchedule> harmonogram, harmonogramRuchu;
+    std::vector<int> genotypRuchu, nowyBlok, porzadek;
+    bool sciezkaAktualna = false;
+    // W kodowaniu z powtórzeniami zamiana genów tego samego joba nic nie zmienia – losujemy ponownie
+    bool pomijajPuste = kodowanie == Kodowanie::PowtorzeniaJobow && liczbaJobow > 1;
+
+    // Losuje ruch danego rodzaju (do `ruchy` albo `genotypRuchu`); false = ścieżka krytyczna bez bloków
+    auto losujRuch = [&](RodzajRuchu rodzaj) -> bool {
+        ruchy.clear();
+        if (!krytyczne)
+        {
+            Ruch ruch{ rodzaj, dist(gen), dist(gen) };
+            while (ruch.i == ruch.j || (pomijajPuste && rodzaj == RodzajRuchu::Zamiana && aktualnyGenotyp[ruch.i] == aktualnyGenotyp[ruch.j]))
+                ruch.j = dist(gen);
+            ruchy.push_back(ruch);
+            return true;
+        }
+
+        if (!sciezkaAktualna)
+        {
+            dekoder.dekoduj(aktualnyGenotyp, &harmonogram);
+            sciezka.wczytaj(harmonogram);
+            sciezkaAktualna = true;
+        }
+        // Bez bloków ścieżka to jeden job – żaden ruch na maszynach nie skróci harmonogramu
+        if (sciezka.getBloki().empty())
+            return false;
+
+        int b = std::uniform_int_distribution<>(0, (int)sciezka.getBloki().size() - 1)(gen);
+        const std::pair<int, int>& blok = sciezka.getBloki()[b];
+        const int* op = sciezka.getOperacjeBlokow().data() + blok.first;
+        int rozmiar = blok.second - blok.first;
+        int a = std::uniform_int_distribution<>(0, rozmiar - 1)(gen);
+        int c;
+        if (rodzaj == RodzajRuchu::Zamiana)
+            c = (a == 0 || (a < rozmiar - 1 && los(gen) < 0.5)) ? a + 1 : a - 1;
+        else
+        {
+            c = std::uniform_int_distribution<>(0, rozmiar - 2)(gen);
+            if (c >= a) ++c;
+        }
 
-    std::sort(kandydaci.begin(), kandydaci.end(), porownajPoPriorytecie);
+        nowyBlok.assign(op, op + rozmiar);
+        if (rodzaj == RodzajRuchu::Zamiana)
+            std::swap(nowyBlok[a], nowyBlok[c]);
+        else if (rodzaj == RodzajRuchu::Odwrocenie)
+            std::reverse(nowyBlok.begin() + std::min(a, c), nowyBlok.begin() + std::max(a, c) + 1);
+        else if (c > a) // operacja a przechodzi na miejsce c, operacje pomiędzy przesuwają się o jedno
+            std::rotate(nowyBlok.begin() + a, nowyBlok.begin() + a + 1, nowyBlok.begin() + c + 1);
+        else
+            std::rotate(nowyBlok.begin() + c, nowyBlok.begin() + a, nowyBlok.begin() + a + 1);
+
+        if (!sciezka.kolejnoscPoZmianie(b, nowyBlok, porzadek))
+        {
+            // Dalsze przestawienie dało cykl; zamiana sąsiednich operacji bloku krytycznego go nie tworzy
+            int d = (c > a) ? a + 1 : a - 1;
+            nowyBlok.assign(op, op + rozmiar);
+            std::swap(nowyBlok[a], nowyBlok[d]);
+            sciezka.kolejnoscPoZmianie(b, nowyBlok, porzadek);
+        }
+        genotypRuchu = genotypZKolejnosci(operacje, porzadek, kodowanie);
+        return true;
+    };
+
+    // Koszt wylosowanego ruchu. Ruch losowy jest stosowany w miejscu (hash dla cache aktualizowany
+    // przyrostowo); ruch krytyczny dekoduje kandydata z harmonogramem, z którego po akceptacji
+    // od razu powstaje nowa ścieżka – bez cache i bez ponownego dekodowania.
+    auto ocenRuch = [&](uint64_t& hash) -> int {
+        if (krytyczne)
+            return dekoder.dekoduj(genotypRuchu, &harmonogramRuchu);
+        for (const Ruch& ruch : ruchy)
+            zastosujRuch(aktualnyGenotyp, ruch, (cache != nullptr) ? &hash : nullptr);
+        return (cache != nullptr) ? dekoder.ocen(aktualnyGenotyp, hash) : dekoder.dekoduj(aktualnyGenotyp);
+    };
+    auto przyjmijRuch = [&]() {
+        if (!krytyczne)
+            return;
+        aktualnyGenotyp.swap(genotypRuchu);
+        harmonogram.swap(harmonogramRuchu);
+        sciezka.wczytaj(harmonogram);
+    };
+    auto odrzucRuch = [&]() {
+        for (int k = (int)ruchy.size() - 1; k >= 0; --k)
+            cofnijRuch(aktualnyGenotyp, ruchy[k]);
+    };
+
+    // Postęp budżetu (czas albo iteracje) w [0, 1] – tylko w trybie adaptacyjnym
+    auto postep = [&]() -> double {
+        if (limitCzasu > 0.0)
+        {
+            ad.czas = ad.czasPrzedWznowieniem + std::chrono::duration<double>(std::chrono::steady_clock::now() - startSolve).count();
+            return ad.czas / limitCzasu;
+        }
+        return maksLiczbaIteracji > 0 ? static_cast<double>(iteracja) / maksLiczbaIteracji : 1.0;
+    };
 
-    // Wylicz ile operacji ma każdy job
-    std::vector<int> liczbaOperacjiNaJob(liczbaJobow, 0);
-    for (int i = 0; i < kandydaci.size(); ++i)
+    if (adaptacyjny && !wznowiony)
     {
-        const OperationSchedule& op = kandydaci[i];
-        if (op.operation_id + 1 > liczbaOperacjiNaJob[op.job_id])
+        // T0 i T końcowa z próbki ruchów pod górę: średni wzrost przyjmowany na starcie z
+        // prawdopodobieństwem akceptacjaStartowa, na końcu z prawdopodobieństwem akceptacjaKoncowa
+        METRYKA_FAZA(Sasiedztwo);
+        const int probki = 100;
+        double sumaWzrostow = 0.0;
+        int liczbaWzrostow = 0;
+        for (int k = 0; k < probki; ++k)
         {
-            liczbaOperacjiNaJob[op.job_id] = op.operation_id + 1;
+            RodzajRuchu rodzaj = static_cast<RodzajRuchu>(k % LICZBA_RODZAJOW_RUCHU);
+            if (!losujRuch(rodzaj))
+                break;
+            uint64_t h = hashAktualny;
+            int delta = ocenRuch(h) - aktualnyKoszt;
+            odrzucRuch();
+            if (delta > 0)
+            {
+                sumaWzrostow += delta;
+                ++liczbaWzrostow;
+            }
         }
+        double sredniWzrost = (liczbaWzrostow > 0) ? sumaWzrostow / liczbaWzrostow : 1.0;
+        ad.T0 = -sredniWzrost / std::log(akceptacjaStartowa);
+        ad.Tk = -sredniWzrost / std::log(akceptacjaKoncowa);
+        ad.TEpizodu = ad.T0;
+        ad.TPoprawy = ad.T0;
+        T = ad.T0;
     }
-
-    std::vector<std::vector<bool> > czy_zrobione(liczbaJobow);
-    for (int i = 0; i < liczbaJobow; ++i)
+    const double oknoStagnacji = 0.1;  // część budżetu bez poprawy najlepszego, po której następuje podgrzanie
+    const double minUdzialOperatora = 0.1;
+    const double wygladzanie = 0.01;   // waga nowej obserwacji w średniej kroczącej skuteczności
+
+    // Średnia i najgorszy koszt dotychczasowych iteracji liczone przyrostowo
+    long long sumaKosztow = 0;
+    int najgorszyKoszt = aktualnyKoszt;
+    for (int k : kosztyIteracji)
     {
-        czy_zrobione[i].resize(liczbaOperacjiNaJob[i], false);
+        sumaKosztow += k;
+        najgorszyKoszt = std::max(najgorszyKoszt, k);
     }
 
-    std::vector<int> maszyna_wolna_od(liczbaMaszyn, 0);
-    std::vector<int> job_gotowy_od(liczbaJobow, 0);
-    std::vector<OperationSchedule> harmonogram;
-
-    int liczbaZaplanowanych = 0;
-    int N = kandydaci.size();
-
-    while (liczbaZaplanowanych < N)
+    while (najlepszyKoszt > cel)
     {
-        bool dodano = false;
-
-        for (int i = 0; i < N; ++i)
+        double p = 0.0;
+        if (adaptacyjny)
         {
-            OperationSchedule& op = kandydaci[i];
-
-            if (czy_zrobione[op.job_id][op.operation_id]) continue;
+            p = postep();
+            if (p >= 1.0)
+                break;
+            // Geometryczne chłodzenie od TEpizodu do Tk w pozostałej części budżetu
+            double x = (p - ad.postepEpizodu) / std::max(1e-9, 1.0 - ad.postepEpizodu);
+            T = ad.TEpizodu * std::pow(ad.Tk / ad.TEpizodu, std::min(1.0, x));
+        }
+        else if (!(T > temperaturaKoncowa && iteracja < maksLiczbaIteracji))
+            break;
 
-            bool poprzedniaOK = (op.operation_id == 0) || czy_zrobione[op.job_id][op.operation_id - 1];
+        METRYKA_FAZA(Sasiedztwo);
 
-            if (poprzedniaOK)
+        // === Krok 3: Ruch na aktualnym genotypie (w miejscu, cofany przy odrzuceniu) ===
+        int wybranyRuch = static_cast<int>(rodzajRuchu);
+        if (adaptacyjny)
+        {
+            // Rodzaj ruchu proporcjonalnie do ostatniej skuteczności, z minimalnym udziałem każdego
+            double suma = ad.skutecznosc[0] + ad.skutecznosc[1] + ad.skutecznosc[2];
+            double r = los(gen);
+            for (wybranyRuch = 0; wybranyRuch < LICZBA_RODZAJOW_RUCHU - 1; ++wybranyRuch)
             {
-                int start = (maszyna_wolna_od[op.machine_id] > job_gotowy_od[op.job_id])
-                          ? maszyna_wolna_od[op.machine_id]
-                          : job_gotowy_od[op.job_id];
-
-                int end = start + op.processing_time;
-
-                op.start_time = start;
-                op.end_time = end;
-
-                maszyna_wolna_od[op.machine_id] = end;
-                job_gotowy_od[op.job_id] = end;
-                czy_zrobione[op.job_id][op.operation_id] = true;
-
-                harmonogram.push_back(op);
-                liczbaZaplanowanych++;
-                dodano = true;
+                r -= minUdzialOperatora + (1.0 - LICZBA_RODZAJOW_RUCHU * minUdzialOperatora) * ad.skutecznosc[wybranyRuch] / suma;
+                if (r < 0.0)
+                    break;
             }
         }
+        else if (krytyczne)
+            wybranyRuch = static_cast<int>(RodzajRuchu::Wstawienie); // zamiany sąsiednie i wstawienia w bloku
 
-        if (!dodano)
-        {
-            std::cerr << "[SA] Błąd: Deadlock – nie da się zaplanować żadnej operacji\n";
+        if (!losujRuch(static_cast<RodzajRuchu>(wybranyRuch)))
             break;
-        }
-    }
 
-    return harmonogram;
-}
-
-
-
-void SimulatedAnnealingSolver::solve(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn)
-{
-    std::mt19937 gen(std::random_device{}());
-    int liczbaOperacji = operacje.size();
-
-    // === Krok 1: Losowe rozwiązanie początkowe ===
-    std::vector<int> aktualnyGenotyp(liczbaOperacji);
-    for (int i = 0; i < liczbaOperacji; ++i)
-        aktualnyGenotyp[i] = i;
-
-    std::shuffle(aktualnyGenotyp.begin(), aktualnyGenotyp.end(), gen);
-    std::vector<OperationSchedule> aktualnyHarmonogram = zbudujHarmonogramZPriorytetami(aktualnyGenotyp, operacje, liczbaJobow, liczbaMaszyn);
-    int aktualnyKoszt = obliczMakespan(aktualnyHarmonogram, aktualnyGenotyp, liczbaJobow, liczbaMaszyn);
-
-    std::vector<int> najlepszyGenotyp = aktualnyGenotyp;
-    std::vector<OperationSchedule> najlepszyHarmonogram = aktualnyHarmonogram;
-    int najlepszyKoszt = aktualnyKoszt;
-
-    // === Krok 2: Parametry SA ===
-    double T = temperaturaStartowa;
-    int iteracja = 0;
-
-    std::uniform_int_distribution<> dist(0, liczbaOperacji - 1);
+        // === Krok 4: Obliczamy koszt sąsiada ===
+        uint64_t nowyHash = hashAktualny;
+        int nowyKoszt = ocenRuch(nowyHash);
 
-    while (T > temperaturaKoncowa && iteracja < maksLiczbaIteracji)
-    {
-        // === Krok 3: Tworzymy sąsiada przez zamianę dwóch operacji ===
-        std::vector<int> nowyGenotyp = aktualnyGenotyp;
-        int i = dist(gen);
-        int j = dist(gen);
-        while (i == j) j = dist(gen); // upewnij się, że różne indeksy
+        {
+            METRYKA_FAZA(Selekcja);
 
-        std::swap(nowyGenotyp[i], nowyGenotyp[j]);
+            // === Krok 5: Różnica kosztów ===
+            int delta = nowyKoszt - aktualnyKoszt;
 
-        // === Krok 4: Obliczamy koszt sąsiada ===
-        std::vector<OperationSchedule> nowyHarmonogram = zbudujHarmonogramZPriorytetami(nowyGenotyp, operacje, liczbaJobow, liczbaMaszyn);
-        int nowyKoszt = obliczMakespan(nowyHarmonogram, nowyGenotyp, liczbaJobow, liczbaMaszyn);
+            // === Krok 6: Czy zaakceptować nowego? ===
+            if (delta < 0 || (std::exp(-delta / T) > los(gen)))
+            {
+                aktualnyKoszt = nowyKoszt;
+                hashAktualny = nowyHash;
+                przyjmijRuch();
+                METRYKA_DODAJ(ZaakceptowaneRuchy, 1);
+            }
+            else
+            {
+                odrzucRuch();
+            }
 
-        // === Krok 5: Różnica kosztów ===
-        int delta = nowyKoszt - aktualnyKoszt;
+            if (adaptacyjny)
+            {
+                ad.skutecznosc[wybranyRuch] += wygladzanie * ((delta < 0 ? 1.0 : 0.0) - ad.skutecznosc[wybranyRuch]);
+                ad.uzycia[wybranyRuch]++;
+            }
 
-        // === Krok 6: Czy zaakceptować nowego? ===
-        if (delta < 0 || (std::exp(-delta / T) > ((double)rand() / RAND_MAX)))
-        {
-            aktualnyGenotyp = nowyGenotyp;
-            aktualnyHarmonogram = nowyHarmonogram;
-            aktualnyKoszt = nowyKoszt;
+            // === Krok 7: Aktualizacja najlepszego (kopia tylko przy poprawie) ===
+            if (aktualnyKoszt < najlepszyKoszt)
+            {
+                najlepszyKoszt = aktualnyKoszt;
+                najlepszyGenotyp = aktualnyGenotyp;
+                ad.postepPoprawy = p;
+                ad.TPoprawy = T;
+                METRYKA_DODAJ(Poprawy, 1);
+                zglosPoprawe(najlepszyKoszt);
+                LOG_DEBUG(SA, "Iteracja " << iteracja << ": nowy najlepszy makespan = " << najlepszyKoszt << " (T = " << T << ")");
+            }
+            else if (adaptacyjny && p - ad.postepPoprawy > oknoStagnacji && p - ad.postepEpizodu > oknoStagnacji)
+            {
+                // Podgrzanie: nowy epizod chłodzenia od dwukrotności temperatury ostatniej poprawy
+                ad.TEpizodu = std::max(T, std::min(ad.T0, 2.0 * ad.TPoprawy));
+                ad.postepEpizodu = p;
+                ad.postepPoprawy = p;
+                ad.podgrzania++;
+                METRYKA_DODAJ(Restarty, 1);
+                LOG_DEBUG(SA, "Iteracja " << iteracja << ": podgrzanie z T = " << T << " do " << ad.TEpizodu);
+            }
         }
 
-        // === Krok 7: Aktualizacja najlepszego ===
-        if (aktualnyKoszt < najlepszyKoszt)
         {
-            najlepszyKoszt = aktualnyKoszt;
-            najlepszyGenotyp = aktualnyGenotyp;
-            najlepszyHarmonogram = aktualnyHarmonogram;
-        }
+            METRYKA_FAZA(Logowanie);
 
-        // === Krok 8: Chłodzenie ===
-        kosztyIteracji.push_back(aktualnyKoszt);
+            kosztyIteracji.push_back(aktualnyKoszt);
 
-// Oblicz AVG i WORST z dotychczasowych iteracji
-int suma = 0;
-int najgorszy = aktualnyKoszt;
-for (int k = 0; k < kosztyIteracji.size(); ++k) 
-{
-    suma += kosztyIteracji[k];
-    if (kosztyIteracji[k] > najgorszy)
-        najgorszy = kosztyIteracji[k];
-}
-double avg = static_cast<double>(suma) / kosztyIteracji.size();
+            // AVG i WORST z dotychczasowych iteracji
+            sumaKosztow += aktualnyKoszt;
+            najgorszyKoszt = std::max(najgorszyKoszt, aktualnyKoszt);
+            avgIteracji.push_back(static_cast<double>(sumaKosztow) / kosztyIteracji.size());
+            worstIteracji.push_back(najgorszyKoszt);
 
-avgIteracji.push_back(avg);
-worstIteracji.push_back(najgorszy);
+            // Zapisz current i best_so_far do wykresu
+            historiaCurrent.push_back(aktualnyKoszt);
+            historiaBestSoFar.push_back(najlepszyKoszt);
+        }
 
-        T *= wspolczynnikChlodzenia;
+        // === Krok 8: Chłodzenie (w trybie adaptacyjnym T wynika z postępu budżetu) ===
+        if (!adaptacyjny)
+            T *= wspolczynnikChlodzenia;
         iteracja++;
 
-        // Zapisz current i best_so_far do wykresu
-historiaCurrent.push_back(aktualnyKoszt);
-historiaBestSoFar.push_back(najlepszyKoszt);
-
+        if (zapis && ((coIleCheckpoint > 0 && iteracja % coIleCheckpoint == 0) || czyZadanoCheckpointu()))
+        {
+            METRYKA_FAZA(Logowanie);
+            zapiszCheckpoint(stan, sumaInstancji, *zapis);
+            potwierdzCheckpoint();
+        }
+        if (czyZadanoZatrzymania())
+            break;
     }
 
-    // Zapisz najlepsze rozwiązanie
-    schedule = najlepszyHarmonogram;
+    // Zatrzymany przebieg zostawia stan do wznowienia; zakończony usuwa checkpoint
+    if (zapis && czyZadanoZatrzymania())
+        zapiszCheckpoint(stan, sumaInstancji, *zapis);
+    else if (zapis)
+        zapis->porzuc();
+
+    // Zapisz najlepsze rozwiązanie (harmonogram budujemy raz, na końcu)
+    dekoder.dekoduj(najlepszyGenotyp, &schedule);
     makespan = najlepszyKoszt;
+    ostatniaAdaptacja = ad;
+    ostatniaAdaptacja.iteracje = iteracja;
+}
+
+void SimulatedAnnealingSolver::wypiszAdaptacje() const
+{
+    if (!adaptacyjny)
+        return;
+    const Adaptacja& ad = ostatniaAdaptacja;
+    std::cout << "[SA] T0 = " << ad.T0 << ", Tk = " << ad.Tk << ", iteracje = " << ad.iteracje
+              << ", podgrzania = " << ad.podgrzania << ", ruchy zamiana/wstawienie/odwrocenie = "
+              << ad.uzycia[0] << "/" << ad.uzycia[1] << "/" << ad.uzycia[2] << "\n";
 }
 
 
-int SimulatedAnnealingSolver::obliczMakespan(
-    std::vector<OperationSchedule>& kandydaci,
-    const std::vector<int>& priorytety,
-    int liczbaJobow,
-    int liczbaMaszyn)
+void SimulatedAnnealingSolver::zapiszCheckpoint(const Stan& stan, uint64_t sumaInstancji, CheckpointWriter& zapis) const
 {
-    for (int i = 0; i < kandydaci.size(); ++i)
+    BuforZapisu b;
+    b.piszNaglowek("sa", sumaInstancji, trybDekodera, kodowanie);
+    b.piszGenerator(gen);
+    b.piszInt(stan.iteracja);
+    b.piszDouble(stan.T);
+    b.piszInt(stan.aktualnyKoszt);
+    b.piszInt(stan.najlepszyKoszt);
+    b.piszWektor(stan.aktualnyGenotyp);
+    b.piszWektor(stan.najlepszyGenotyp);
+
+    b.piszWektor(kosztyIteracji);
+    b.piszWektor(historiaCurrent);
+    b.piszWektor(historiaBestSoFar);
+    b.piszWektor(avgIteracji);
+    b.piszWektor(worstIteracji);
+
+    const Adaptacja& ad = stan.adaptacja;
+    b.piszDouble(ad.T0);
+    b.piszDouble(ad.Tk);
+    b.piszDouble(ad.TEpizodu);
+    b.piszDouble(ad.TPoprawy);
+    b.piszDouble(ad.postepEpizodu);
+    b.piszDouble(ad.postepPoprawy);
+    b.piszDouble(ad.czas);
+    b.piszInt(ad.podgrzania);
+    for (int k = 0; k < LICZBA_RODZAJOW_RUCHU; ++k)
     {
-        kandydaci[i].priority = priorytety[i];
+        b.piszDouble(ad.skutecznosc[k]);
+        b.piszInt(ad.uzycia[k]);
     }
+    b.zakoncz();
 
-    std::sort(kandydaci.begin(), kandydaci.end(), porownajPoPriorytecie);
+    zapis.zlec(b.getDane());
+}
 
-    std::vector<int> liczbaOperacjiNaJob(liczbaJobow, 0);
-    for (int i = 0; i < kandydaci.size(); ++i)
+bool SimulatedAnnealingSolver::wczytajCheckpoint(uint64_t sumaInstancji, Stan& stan)
+{
+    std::vector<char> dane;
+    if (!wczytajPlikBinarny(plikWznowienia, dane))
     {
-        const OperationSchedule& op = kandydaci[i];
-        if (op.operation_id + 1 > liczbaOperacjiNaJob[op.job_id])
-        {
-            liczbaOperacjiNaJob[op.job_id] = op.operation_id + 1;
-        }
+        LOG_OSTRZEZENIE(SA, "Brak checkpointu " << plikWznowienia << " – start od nowa");
+        return false;
     }
 
-    std::vector<std::vector<bool> > czy_zrobione(liczbaJobow);
-    for (int i = 0; i < liczbaJobow; ++i)
+    BuforOdczytu b(dane);
+    if (!b.czytajNaglowek("sa", sumaInstancji, trybDekodera, kodowanie))
+        return false;
+
+    std::mt19937 g;
+    b.czytajGenerator(g);
+    Stan s;
+    s.iteracja = b.czytajInt();
+    s.T = b.czytajDouble();
+    s.aktualnyKoszt = b.czytajInt();
+    s.najlepszyKoszt = b.czytajInt();
+    b.czytajWektor(s.aktualnyGenotyp);
+    b.czytajWektor(s.najlepszyGenotyp);
+
+    std::vector<int> koszty, current, bestSoFar, worst;
+    std::vector<double> avg;
+    b.czytajWektor(koszty);
+    b.czytajWektor(current);
+    b.czytajWektor(bestSoFar);
+    b.czytajWektor(avg);
+    b.czytajWektor(worst);
+
+    Adaptacja& ad = s.adaptacja;
+    ad.T0 = b.czytajDouble();
+    ad.Tk = b.czytajDouble();
+    ad.TEpizodu = b.czytajDouble();
+    ad.TPoprawy = b.czytajDouble();
+    ad.postepEpizodu = b.czytajDouble();
+    ad.postepPoprawy = b.czytajDouble();
+    ad.czasPrzedWznowieniem = b.czytajDouble();
+    ad.czas = ad.czasPrzedWznowieniem;
+    ad.podgrzania = b.czytajInt();
+    for (int k = 0; k < LICZBA_RODZAJOW_RUCHU; ++k)
     {
-        czy_zrobione[i].resize(liczbaOperacjiNaJob[i], false);
+        ad.skutecznosc[k] = b.czytajDouble();
+        ad.uzycia[k] = b.czytajInt();
     }
 
-    std::vector<int> maszyna_wolna_od(liczbaMaszyn, 0);
-    std::vector<int> job_gotowy_od(liczbaJobow, 0);
-
-    int maksCzas = 0;
-    int zaplanowane = 0;
-    int N = kandydaci.size();
-
-    while (zaplanowane < N)
+    if (!b.ok())
     {
-        bool cosDodano = false;
-
-        for (int i = 0; i < N; ++i)
-        {
-            OperationSchedule& op = kandydaci[i];
-
-            if (czy_zrobione[op.job_id][op.operation_id]) continue;
-
-            bool poprzedniaOK = (op.operation_id == 0) || czy_zrobione[op.job_id][op.operation_id - 1];
-
-            if (poprzedniaOK)
-            {
-                int start = (maszyna_wolna_od[op.machine_id] > job_gotowy_od[op.job_id])
-                          ? maszyna_wolna_od[op.machine_id]
-                          : job_gotowy_od[op.job_id];
-
-                int end = start + op.processing_time;
-
-                op.start_time = start;
-                op.end_time = end;
-
-                maszyna_wolna_od[op.machine_id] = end;
-                job_gotowy_od[op.job_id] = end;
-                czy_zrobione[op.job_id][op.operation_id] = true;
-
-                if (end > maksCzas)
-                {
-                    maksCzas = end;
-                }
-
-                zaplanowane++;
-                cosDodano = true;
-            }
-        }
-
-        if (!cosDodano)
-        {
-            std::cerr << "[SA] Błąd: Deadlock – nie da się zaplanować żadnej operacji\n";
-            return std::numeric_limits<int>::max();
-        }
+        LOG_OSTRZEZENIE(SA, "Niepelny checkpoint " << plikWznowienia);
+        return false;
     }
 
-    return maksCzas;
+    gen = g;
+    stan = s;
+    kosztyIteracji = koszty;
+    historiaCurrent = current;
+    historiaBestSoFar = bestSoFar;
+    avgIteracji = avg;
+    worstIteracji = worst;
+    LOG_INFO(SA, "Wznowiono z " << plikWznowienia << " od iteracji " << stan.iteracja);
+    return true;
 }
 
-
-
-
-
 // Wypisuje harmonogram (tak jak w innych solverach)
 void SimulatedAnnealingSolver::printSchedule() const
 {
@@ -294,23 +495,16 @@ void SimulatedAnnealingSolver::printSchedule() const
 // Zapis do CSV
 void SimulatedAnnealingSolver::zapiszDoCSV(const std::string& nazwaPliku) const
 {
-    std::ofstream out(nazwaPliku);
-    if (!out.is_open())
+    TekstCSV t(',');
+    t.zarezerwuj(schedule.size() * 24);
+    t.tekst() = "job_id,operation_id,machine_id,start_time,end_time,priority\n";
+    for (const OperationSchedule& op : schedule)
     {
-        std::cerr << "Nie można otworzyć pliku do zapisu: " << nazwaPliku << "\n";
-        return;
+        t.pole(op.job_id).pole(op.operation_id).pole(op.machine_id).pole(op.start_time).pole(op.end_time).pole(op.priority);
+        t.koniecWiersza();
     }
 
-    out << "job_id,operation_id,machine_id,start_time,end_time,priority\n";
-    for (const auto& op : schedule)
-    {
-        out << op.job_id << ","
-            << op.operation_id << ","
-            << op.machine_id << ","
-            << op.start_time << ","
-            << op.end_time << ","
-            << op.priority << "\n";
-    }
+    ResultWriter::instancja().zapisz(nazwaPliku, t.tekst());
 }
 
 void SimulatedAnnealingSolver::zapiszStatystykiDoCSV(const std::string& nazwaPliku, int run) const
@@ -333,80 +527,42 @@ void SimulatedAnnealingSolver::zapiszStatystykiDoCSV(const std::string& nazwaPli
     }
     double stddev = std::sqrt(sumKw / kosztyIteracji.size());
 
-    std::ofstream out;
-    bool istnieje = std::ifstream(nazwaPliku).good();
-    out.open(nazwaPliku, std::ios::app);
-
-    if (!out.is_open())
-    {
-        std::cerr << "Nie można otworzyć pliku do zapisu: " << nazwaPliku << "\n";
-        return;
-    }
-
-    if (!istnieje)
-    {
-        out << "run;best;average;worst;std\n";
-    }
-
-    out << run << ";" << best << ";" << avg << ";" << worst << ";" << stddev << "\n";
-    out.close();
+    TekstCSV t;
+    t.pole(run).pole(best).pole(avg).pole(worst).pole(stddev).pole(obliczGap(makespan, dolneOgraniczenie));
+    t.koniecWiersza();
+    ResultWriter::instancja().dopisz(nazwaPliku, "run;best;average;worst;std;gap\n", t.tekst());
 }
 
 
 void SimulatedAnnealingSolver::zapiszKosztyNajlepszegoRunCSV(const std::string& nazwaPliku) const
 {
     if (kosztyIteracji.empty() || avgIteracji.empty() || worstIteracji.empty()) {
-        std::cerr << "[SA] Brak danych do zapisania kosztów najlepszego runa.\n";
-        return;
-    }
-
-    std::ofstream out;
-    bool istnieje = std::ifstream(nazwaPliku).good();
-    out.open(nazwaPliku, std::ios::app);
-
-    if (!out.is_open()) {
-        std::cerr << "[SA] Nie można otworzyć pliku: " << nazwaPliku << "\n";
+        LOG_OSTRZEZENIE(SA, "Brak danych do zapisania kosztów najlepszego runa.");
         return;
     }
 
-    if (!istnieje) {
-        out << "iter;best;avg;worst\n";
-    }
-
-    for (int i = 0; i < kosztyIteracji.size(); ++i) {
-        out << i << ";" 
-            << kosztyIteracji[i] << ";" 
-            << avgIteracji[i] << ";" 
-            << worstIteracji[i] << "\n";
+    TekstCSV t;
+    t.zarezerwuj(kosztyIteracji.size() * 24);
+    for (int i = 0; i < (int)kosztyIteracji.size(); ++i) {
+        t.pole(i).pole(kosztyIteracji[i]).pole(avgIteracji[i]).pole(worstIteracji[i]);
+        t.koniecWiersza();
     }
-
-    out.close();
+    ResultWriter::instancja().dopisz(nazwaPliku, "iter;best;avg;worst\n", t.tekst());
 }
 
 
 void SimulatedAnnealingSolver::zapiszBestVsCurrentCSV(const std::string& nazwaPliku) const
 {
     if (historiaCurrent.empty() || historiaBestSoFar.empty()) {
-        std::cerr << "[SA] Brak danych do zapisania best vs current.\n";
+        LOG_OSTRZEZENIE(SA, "Brak danych do zapisania best vs current.");
         return;
     }
 
-    std::ofstream out;
-    bool istnieje = std::ifstream(nazwaPliku).good();
-    out.open(nazwaPliku, std::ios::app);
-
-    if (!out.is_open()) {
-        std::cerr << "[SA] Nie można otworzyć pliku: " << nazwaPliku << "\n";
-        return;
-    }
-
-    if (!istnieje) {
-        out << "iter;current;best_so_far\n";
+    TekstCSV t;
+    t.zarezerwuj(historiaCurrent.size() * 16);
+    for (int i = 0; i < (int)historiaCurrent.size(); ++i) {
+        t.pole(i).pole(historiaCurrent[i]).pole(historiaBestSoFar[i]);
+        t.koniecWiersza();
     }
-
-    for (int i = 0; i < historiaCurrent.size(); ++i) {
-        out << i << ";" << historiaCurrent[i] << ";" << historiaBestSoFar[i] << "\n";
-    }
-
-    out.close();
+    ResultWriter::instancja().dopisz(nazwaPliku, "iter;current;best_so_far\n", t.tekst());
 }
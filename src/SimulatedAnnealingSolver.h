@@ -2,8 +2,20 @@
 #define SIMULATED_ANNEALING_SOLVER_H
 
 #include "OperationSchedule.h"
+#include "ScheduleDecoder.h"
+#include "Moves.h"
 #include <vector>
 #include <string>
+#include <random>
+
+class CheckpointWriter;
+
+// Skąd SA losuje ruchy
+enum class SasiedztwoSA
+{
+    Losowe,   // dowolne dwie pozycje genotypu (ustawRodzajRuchu)
+    Krytyczne // tylko operacje bloków ścieżki krytycznej: zamiana sąsiednich albo wstawienie w bloku
+};
 
 class SimulatedAnnealingSolver
 {
@@ -26,12 +38,87 @@ public:
 
     int getMakespan() const { return makespan; }
     const std::vector<OperationSchedule>& getSchedule() const { return schedule; }
-    
+
+    // Wybór dekodera i kodowania genotypu (domyślnie półaktywny, priorytetowy)
+    void ustawTrybDekodera(TrybDekodera tryb) { trybDekodera = tryb; }
+    void ustawKodowanie(Kodowanie k) { kodowanie = k; }
+
+    // Zatrzymanie po osiągnięciu celu (np. znanego optimum) i dolne ograniczenie do liczenia gapu
+    void ustawCel(int cel) { this->cel = cel; }
+    void ustawDolneOgraniczenie(int lb) { dolneOgraniczenie = lb; }
+
+    // Wspólna pamięć podręczna ocen (jedna na instancję i tryb dekodera); nullptr = bez cache
+    void ustawCache(EvaluationCache* c) { cache = c; }
+
+    // Start od podanego genotypu zamiast losowego (np. naprawa z Rescheduler); pusty = losowo
+    void ustawGenotypStartowy(const std::vector<int>& g) { genotypStartowy = g; }
+    // Warunki brzegowe dekodera przy przeplanowaniu; nullptr = zwykła instancja od chwili 0
+    void ustawOgraniczenia(const OgraniczeniaCzasowe* o) { ograniczenia = o; }
+
+    // Checkpoint co `coIle` iteracji, na sygnał i przy zatrzymaniu (zakończony przebieg usuwa plik); pusta ścieżka = wyłączone
+    void ustawCheckpoint(const std::string& sciezka, int coIle) { plikCheckpointu = sciezka; coIleCheckpoint = coIle; }
+    // Następne solve() kontynuuje przebieg z checkpointu (dalej identycznie jak bez przerwy)
+    void wznowZ(const std::string& sciezka) { plikWznowienia = sciezka; }
+    void ustawZiarno(unsigned ziarno) { gen.seed(ziarno); }
+
+    // Rodzaj losowego ruchu (domyślnie zamiana dwóch genów)
+    void ustawRodzajRuchu(RodzajRuchu r) { rodzajRuchu = r; }
+    // Sąsiedztwo krytyczne: ścieżka jest liczona od nowa tylko po przyjętym ruchu
+    void ustawSasiedztwo(SasiedztwoSA s) { sasiedztwo = s; }
+
+    // Tryb adaptacyjny – parametry temperatury z konstruktora są pomijane:
+    // T0 z próbki ruchów pod górę (średni wzrost przyjmowany z prawdopodobieństwem akceptacjaStartowa z (0, 1)),
+    // chłodzenie geometryczne rozłożone na budżet (limitCzasu sekund, a przy 0 – maxIter iteracji),
+    // podgrzanie po 10% budżetu bez poprawy i wybór zamiana/wstawienie/odwrócenie wg ostatniej skuteczności
+    void ustawAdaptacje(double akceptacjaStartowa = 0.5, double limitCzasu = 0.0)
+    {
+        // T0 = -wzrost / log(akceptacjaStartowa): poza (0, 1) temperatura byłaby ujemna albo nieskończona,
+        // więc wartość jest przycinana do [0.01, 0.99] (NaN -> 0.01)
+        if (!(akceptacjaStartowa >= 0.01))
+            akceptacjaStartowa = 0.01;
+        else if (akceptacjaStartowa > 0.99)
+            akceptacjaStartowa = 0.99;
+        adaptacyjny = true;
+        this->akceptacjaStartowa = akceptacjaStartowa;
+        this->limitCzasu = limitCzasu;
+    }
+    // Skalibrowane temperatury, podgrzania i użycia ruchów ostatniego solve() na std::cout
+    void wypiszAdaptacje() const;
 
 
 
 
 private:
+    // Stan trybu adaptacyjnego; postęp to zużyta część budżetu w [0, 1]
+    struct Adaptacja
+    {
+        double T0 = 0.0, Tk = 0.0;
+        double TEpizodu = 0.0;       // temperatura na początku bieżącego epizodu chłodzenia
+        double TPoprawy = 0.0;       // temperatura przy ostatniej poprawie najlepszego
+        double postepEpizodu = 0.0;
+        double postepPoprawy = 0.0;
+        double czas = 0.0, czasPrzedWznowieniem = 0.0;
+        int podgrzania = 0;
+        int iteracje = 0;
+        double skutecznosc[LICZBA_RODZAJOW_RUCHU] = { 0.1, 0.1, 0.1 }; // średnia krocząca odsetka popraw
+        int uzycia[LICZBA_RODZAJOW_RUCHU] = { 0, 0, 0 };
+    };
+
+    // Stan przeszukiwania – wszystko poza statystykami, co trzeba odtworzyć przy wznowieniu
+    struct Stan
+    {
+        std::vector<int> aktualnyGenotyp;
+        int aktualnyKoszt;
+        std::vector<int> najlepszyGenotyp;
+        int najlepszyKoszt;
+        double T;
+        int iteracja;
+        Adaptacja adaptacja;
+    };
+
+    void zapiszCheckpoint(const Stan& stan, uint64_t sumaInstancji, CheckpointWriter& zapis) const;
+    bool wczytajCheckpoint(uint64_t sumaInstancji, Stan& stan);
+
     // Najlepszy znaleziony harmonogram i jego koszt (makespan)
     std::vector<OperationSchedule> schedule;
     int makespan;
@@ -51,9 +138,25 @@ std::vector<int> historiaBestSoFar;   // najlepszy koszt do tej pory
 
 
 
-    // Pomocnicze do obliczeń
-    int obliczMakespan(std::vector<OperationSchedule>& kandydaci, const std::vector<int>& priorytety, int liczbaJobow, int liczbaMaszyn);
-    std::vector<OperationSchedule> zbudujHarmonogramZPriorytetami(const std::vector<int>& priorytety, const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn);
+    TrybDekodera trybDekodera;
+    Kodowanie kodowanie;
+    int cel;
+    int dolneOgraniczenie;
+    EvaluationCache* cache;
+    std::vector<int> genotypStartowy;
+    const OgraniczeniaCzasowe* ograniczenia;
+    RodzajRuchu rodzajRuchu;
+    SasiedztwoSA sasiedztwo;
+    bool adaptacyjny;
+    double akceptacjaStartowa;
+    double akceptacjaKoncowa;
+    double limitCzasu;
+    Adaptacja ostatniaAdaptacja;
+
+    std::mt19937 gen;
+    std::string plikCheckpointu;
+    int coIleCheckpoint;
+    std::string plikWznowienia;
 };
 
 #endif
@@ -0,0 +1,242 @@
+#include "SolutionArchive.h"
+#include "Log.h"
+#include "Checkpoint.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+static const char* NAGLOWEK_ROZWIAZANIA = "JSSPSOL";
+static const int WERSJA_ROZWIAZANIA = 1;
+
+bool wczytajHarmonogramCSV(const std::string& nazwaPliku, std::vector<OperationSchedule>& harmonogram)
+{
+    std::ifstream file(nazwaPliku);
+    if (!file.is_open())
+    {
+        LOG_BLAD(Archiwum, "Nie mozna otworzyc pliku: " << nazwaPliku);
+        return false;
+    }
+
+    harmonogram.clear();
+    std::string line;
+    std::getline(file, line); // nagłówek
+
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line == "\r")
+            continue;
+
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream iss(line);
+        OperationSchedule op;
+        if (!(iss >> op.job_id >> op.operation_id >> op.machine_id >> op.start_time >> op.end_time))
+        {
+            LOG_OSTRZEZENIE(Archiwum, "Bledny wiersz harmonogramu w " << nazwaPliku << ": " << line);
+            return false;
+        }
+        // priority jest opcjonalne (RandomSolver, GRASP i AE zapisują 5 kolumn) – genotyp i tak
+        // powstaje z czasów startu w kolejnoscZHarmonogramu
+        if (!(iss >> op.priority))
+            op.priority = 0;
+        op.processing_time = op.end_time - op.start_time;
+        harmonogram.push_back(op);
+    }
+    return true;
+}
+
+std::vector<int> kolejnoscZHarmonogramu(const std::vector<OperationSchedule>& operacje,
+                                        const std::vector<OperationSchedule>& harmonogram)
+{
+    const int N = operacje.size();
+
+    // (job, operacja) -> indeks w instancji
+    std::vector<std::vector<int>> indeks;
+    for (int i = 0; i < N; ++i)
+    {
+        const OperationSchedule& op = operacje[i];
+        if (op.job_id >= (int)indeks.size()) indeks.resize(op.job_id + 1);
+        if (op.operation_id >= (int)indeks[op.job_id].size()) indeks[op.job_id].resize(op.operation_id + 1, -1);
+        indeks[op.job_id][op.operation_id] = i;
+    }
+
+    std::vector<int> start(N, -1);
+    int znalezione = 0;
+    for (const OperationSchedule& op : harmonogram)
+    {
+        int i = -1;
+        if (op.job_id >= 0 && op.job_id < (int)indeks.size() &&
+            op.operation_id >= 0 && op.operation_id < (int)indeks[op.job_id].size())
+            i = indeks[op.job_id][op.operation_id];
+
+        if (i < 0 || start[i] >= 0 || operacje[i].machine_id != op.machine_id)
+        {
+            LOG_BLAD(Archiwum, "Harmonogram nie pasuje do instancji (job " << op.job_id << ", operacja " << op.operation_id << ")");
+            return std::vector<int>();
+        }
+        start[i] = op.start_time;
+        ++znalezione;
+    }
+    if (znalezione != N)
+    {
+        LOG_BLAD(Archiwum, "Harmonogram nie zawiera wszystkich operacji instancji");
+        return std::vector<int>();
+    }
+
+    std::vector<int> kolejnosc(N);
+    for (int i = 0; i < N; ++i)
+        kolejnosc[i] = i;
+    std::sort(kolejnosc.begin(), kolejnosc.end(), [&](int a, int b) {
+        if (start[a] != start[b]) return start[a] < start[b];
+        if (operacje[a].job_id != operacje[b].job_id) return operacje[a].job_id < operacje[b].job_id;
+        return operacje[a].operation_id < operacje[b].operation_id;
+    });
+    return kolejnosc;
+}
+
+std::vector<int> genotypZKolejnosci(const std::vector<OperationSchedule>& operacje,
+                                    const std::vector<int>& kolejnosc, Kodowanie kodowanie)
+{
+    std::vector<int> genotyp(kolejnosc.size());
+    for (int r = 0; r < (int)kolejnosc.size(); ++r)
+    {
+        if (kodowanie == Kodowanie::PowtorzeniaJobow)
+            genotyp[r] = operacje[kolejnosc[r]].job_id;
+        else
+            genotyp[kolejnosc[r]] = r;
+    }
+    return genotyp;
+}
+
+int makespanKolejnosci(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                       const std::vector<int>& kolejnosc)
+{
+    const int N = operacje.size();
+    if ((int)kolejnosc.size() != N)
+        return -1;
+
+    std::vector<int> nastepnaOperacja(liczbaJobow, 0);
+    std::vector<int> jobGotowy(liczbaJobow, 0);
+    std::vector<int> maszynaWolna(liczbaMaszyn, 0);
+    std::vector<bool> uzyta(N, false);
+    int makespan = 0;
+    for (int i : kolejnosc)
+    {
+        if (i < 0 || i >= N || uzyta[i])
+            return -1;
+        const OperationSchedule& op = operacje[i];
+        if (op.operation_id != nastepnaOperacja[op.job_id]++)
+            return -1;
+        uzyta[i] = true;
+
+        int start = std::max(jobGotowy[op.job_id], maszynaWolna[op.machine_id]);
+        int koniec = start + op.processing_time;
+        jobGotowy[op.job_id] = koniec;
+        maszynaWolna[op.machine_id] = koniec;
+        makespan = std::max(makespan, koniec);
+    }
+    return makespan;
+}
+
+// ===== SolutionArchive =====
+
+SolutionArchive::SolutionArchive(const std::string& katalog)
+    : katalog(katalog)
+{}
+
+std::string SolutionArchive::sciezkaPliku(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn) const
+{
+    std::ostringstream nazwa;
+    nazwa << std::hex << std::setw(16) << std::setfill('0') << sumaKontrolnaInstancji(operacje, liczbaJobow, liczbaMaszyn) << ".sol";
+    return (std::filesystem::path(katalog) / nazwa.str()).string();
+}
+
+bool SolutionArchive::wczytaj(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                              std::vector<int>& kolejnosc, int& makespan) const
+{
+    std::string sciezka = sciezkaPliku(operacje, liczbaJobow, liczbaMaszyn);
+    std::ifstream file(sciezka);
+    if (!file.is_open())
+        return false; // brak wpisu to normalna sytuacja
+
+    std::string naglowek, klucz, suma, opis;
+    int wersja = 0, J = 0, M = 0, n = 0;
+    file >> naglowek >> wersja;
+    file >> klucz >> suma;
+    file >> klucz >> J >> M;
+    file >> klucz >> makespan;
+    file >> klucz;
+    std::getline(file, opis);
+    file >> klucz >> n;
+
+    std::ostringstream oczekiwanaSuma;
+    oczekiwanaSuma << std::hex << std::setw(16) << std::setfill('0') << sumaKontrolnaInstancji(operacje, liczbaJobow, liczbaMaszyn);
+    if (!file || naglowek != NAGLOWEK_ROZWIAZANIA || wersja != WERSJA_ROZWIAZANIA || suma != oczekiwanaSuma.str() ||
+        J != liczbaJobow || M != liczbaMaszyn || n != (int)operacje.size())
+    {
+        LOG_OSTRZEZENIE(Archiwum, "Plik " << sciezka << " nie pasuje do instancji – pomijam");
+        return false;
+    }
+
+    kolejnosc.assign(n, 0);
+    for (int k = 0; k < n && file; ++k)
+        file >> kolejnosc[k];
+
+    if (!file || makespanKolejnosci(operacje, liczbaJobow, liczbaMaszyn, kolejnosc) != makespan)
+    {
+        LOG_OSTRZEZENIE(Archiwum, "Plik " << sciezka << " jest uszkodzony – pomijam");
+        kolejnosc.clear();
+        return false;
+    }
+    return true;
+}
+
+std::vector<int> SolutionArchive::genotypStartowy(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                                                  Kodowanie kodowanie) const
+{
+    std::vector<int> kolejnosc;
+    int makespan;
+    if (!wczytaj(operacje, liczbaJobow, liczbaMaszyn, kolejnosc, makespan))
+        return std::vector<int>();
+    return genotypZKolejnosci(operacje, kolejnosc, kodowanie);
+}
+
+bool SolutionArchive::zaproponuj(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                                 const std::vector<OperationSchedule>& harmonogram, const std::string& opis)
+{
+    std::vector<int> kolejnosc = kolejnoscZHarmonogramu(operacje, harmonogram);
+    int makespan = makespanKolejnosci(operacje, liczbaJobow, liczbaMaszyn, kolejnosc);
+    if (makespan < 0)
+        return false;
+
+    std::vector<int> zapisana;
+    int zapisanyMakespan;
+    if (wczytaj(operacje, liczbaJobow, liczbaMaszyn, zapisana, zapisanyMakespan) && zapisanyMakespan <= makespan)
+        return false;
+
+    std::error_code ec;
+    std::filesystem::create_directories(katalog, ec);
+    if (ec)
+    {
+        LOG_BLAD(Archiwum, "Nie mozna utworzyc katalogu archiwum " << katalog << ": " << ec.message());
+        return false;
+    }
+
+    std::string opisWiersz = opis;
+    std::replace(opisWiersz.begin(), opisWiersz.end(), '\n', ' ');
+
+    std::ostringstream out;
+    out << NAGLOWEK_ROZWIAZANIA << " " << WERSJA_ROZWIAZANIA << "\n";
+    out << "instancja " << std::hex << std::setw(16) << std::setfill('0')
+        << sumaKontrolnaInstancji(operacje, liczbaJobow, liczbaMaszyn) << std::dec << "\n";
+    out << "wymiary " << liczbaJobow << " " << liczbaMaszyn << "\n";
+    out << "makespan " << makespan << "\n";
+    out << "opis " << opisWiersz << "\n";
+    out << "kolejnosc " << kolejnosc.size() << "\n";
+    for (int k = 0; k < (int)kolejnosc.size(); ++k)
+        out << kolejnosc[k] << ((k + 1) % liczbaMaszyn == 0 || k + 1 == (int)kolejnosc.size() ? "\n" : " ");
+
+    std::string tekst = out.str();
+    return zapiszPlikAtomowo(sciezkaPliku(operacje, liczbaJobow, liczbaMaszyn), std::vector<char>(tekst.begin(), tekst.end()));
+}
@@ -0,0 +1,55 @@
+#ifndef SOLUTION_ARCHIVE_H
+#define SOLUTION_ARCHIVE_H
+
+#include "OperationSchedule.h"
+#include "Encoding.h"
+#include <vector>
+#include <string>
+
+// Rozwiązanie zapisywane jest jako kolejność operacji (indeksy z instancji posortowane po czasie
+// startu). Półaktywne zdekodowanie tej kolejności daje harmonogram nie gorszy od źródłowego,
+// a kolejność przekłada się na genotyp w każdym kodowaniu.
+
+// Wczytuje harmonogram w formacie harmonogram_*.csv (job_id,operation_id,machine_id,start_time,end_time[,priority])
+bool wczytajHarmonogramCSV(const std::string& nazwaPliku, std::vector<OperationSchedule>& harmonogram);
+
+// Kolejność operacji instancji według czasów startu z harmonogramu; pusta, gdy harmonogram nie pasuje do instancji
+std::vector<int> kolejnoscZHarmonogramu(const std::vector<OperationSchedule>& operacje,
+                                        const std::vector<OperationSchedule>& harmonogram);
+
+// Genotyp odtwarzający daną kolejność (dla priorytetów: genotyp[i] = pozycja operacji i)
+std::vector<int> genotypZKolejnosci(const std::vector<OperationSchedule>& operacje,
+                                    const std::vector<int>& kolejnosc, Kodowanie kodowanie);
+
+// Makespan półaktywnego harmonogramu dla kolejności; -1, gdy kolejność łamie kolejność technologiczną
+int makespanKolejnosci(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                       const std::vector<int>& kolejnosc);
+
+// Archiwum najlepszych rozwiązań: katalog z jednym plikiem tekstowym na instancję
+// (<suma kontrolna instancji>.sol). Plik jest podmieniany atomowo i tylko na lepszy,
+// więc nocne przebiegi mogą z niego startować i go poprawiać. Dwa procesy zapisujące tę samą
+// instancję w tej samej chwili nie uszkodzą pliku, ale wygrywa ostatni zapis.
+class SolutionArchive
+{
+public:
+    explicit SolutionArchive(const std::string& katalog = "archiwum");
+
+    // Najlepsza zapisana kolejność dla instancji (sprawdzona: pasuje do instancji i ma zapisany makespan)
+    bool wczytaj(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                 std::vector<int>& kolejnosc, int& makespan) const;
+
+    // Genotyp startowy z archiwum w danym kodowaniu; pusty, gdy archiwum nie ma tej instancji
+    std::vector<int> genotypStartowy(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                                     Kodowanie kodowanie) const;
+
+    // Zapisuje harmonogram, jeśli jest lepszy od zapisanego; zwraca true, gdy archiwum zostało poprawione
+    bool zaproponuj(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn,
+                    const std::vector<OperationSchedule>& harmonogram, const std::string& opis = "");
+
+    std::string sciezkaPliku(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn) const;
+
+private:
+    std::string katalog;
+};
+
+#endif
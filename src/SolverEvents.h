@@ -0,0 +1,27 @@
+#ifndef SOLVEREVENTS_H
+#define SOLVEREVENTS_H
+
+#include <atomic>
+#include <functional>
+
+// Nowe najlepsze rozwiązanie w trakcie solve() dla zewnętrznego odbiorcy (np. SolverServer).
+// Solvery zgłaszają je tam, gdzie liczą METRYKA_DODAJ(Poprawy); bez słuchacza to jeden odczyt atomowy.
+// Słuchacz może być wołany z wątków roboczych solvera i może dostać wartość nie lepszą od poprzedniej.
+typedef std::function<void(int makespan)> SluchaczPopraw;
+
+inline std::atomic<const SluchaczPopraw*> sluchaczPopraw(nullptr);
+
+// nullptr = bez słuchacza; wskazywany obiekt musi żyć do czasu odłączenia
+inline void ustawSluchaczaPopraw(const SluchaczPopraw* sluchacz)
+{
+    sluchaczPopraw.store(sluchacz, std::memory_order_release);
+}
+
+inline void zglosPoprawe(int makespan)
+{
+    const SluchaczPopraw* sluchacz = sluchaczPopraw.load(std::memory_order_acquire);
+    if (sluchacz != nullptr)
+        (*sluchacz)(makespan);
+}
+
+#endif // SOLVEREVENTS_H
@@ -0,0 +1,595 @@
+#include "SolverServer.h"
+#include "SimpleLoader.h"
+#include "Checkpoint.h"
+#include "Log.h"
+#include "SolverEvents.h"
+#include "RandomSolver.h"
+#include "GraspSolver.h"
+#include "TabuSearchSolver.h"
+#include "SimulatedAnnealingSolver.h"
+#include "EvolutionarySolver.h"
+#include "EvolutionSolver.h"
+#include <sstream>
+#include <iomanip>
+#include <atomic>
+#include <limits>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+// ===== Minimalny JSON: płaski obiekt, wartości napisowe, liczbowe, true/false/null =====
+
+struct WartoscJSON
+{
+    std::string tekst; // napis bez cudzysłowów albo surowy zapis liczby / literału
+    bool napis;
+};
+
+typedef std::map<std::string, WartoscJSON> PolaJSON;
+
+static void pominBiale(const std::string& s, size_t& i)
+{
+    while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\r' || s[i] == '\n'))
+        ++i;
+}
+
+static bool czytajNapis(const std::string& s, size_t& i, std::string& wynik)
+{
+    if (i >= s.size() || s[i] != '"')
+        return false;
+    for (++i; i < s.size(); ++i)
+    {
+        char c = s[i];
+        if (c == '"')
+        {
+            ++i;
+            return true;
+        }
+        if (c != '\\')
+        {
+            wynik += c;
+            continue;
+        }
+        if (++i >= s.size())
+            return false;
+        switch (s[i])
+        {
+        case 'n': wynik += '\n'; break;
+        case 't': wynik += '\t'; break;
+        case 'r': wynik += '\r'; break;
+        case 'b': wynik += '\b'; break;
+        case 'f': wynik += '\f'; break;
+        case 'u': // ścieżki i nazwy solverów są ASCII – reszta zastępowana znakiem zapytania
+            if (i + 4 >= s.size())
+                return false;
+            i += 4;
+            wynik += '?';
+            break;
+        default: wynik += s[i]; break; // \" \\ \/
+        }
+    }
+    return false;
+}
+
+static bool parsujObiekt(const std::string& s, PolaJSON& pola, std::string& blad)
+{
+    size_t i = 0;
+    pominBiale(s, i);
+    if (i >= s.size() || s[i] != '{')
+    {
+        blad = "oczekiwano obiektu JSON";
+        return false;
+    }
+    ++i;
+    pominBiale(s, i);
+    if (i < s.size() && s[i] == '}')
+        return true;
+
+    while (true)
+    {
+        std::string klucz;
+        pominBiale(s, i);
+        if (!czytajNapis(s, i, klucz))
+        {
+            blad = "oczekiwano klucza";
+            return false;
+        }
+        pominBiale(s, i);
+        if (i >= s.size() || s[i] != ':')
+        {
+            blad = "oczekiwano ':' po \"" + klucz + "\"";
+            return false;
+        }
+        ++i;
+        pominBiale(s, i);
+
+        WartoscJSON w;
+        w.napis = i < s.size() && s[i] == '"';
+        if (w.napis)
+        {
+            if (!czytajNapis(s, i, w.tekst))
+            {
+                blad = "niezakonczony napis";
+                return false;
+            }
+        }
+        else
+        {
+            size_t poczatek = i;
+            while (i < s.size() && s[i] != ',' && s[i] != '}' && s[i] != ' ' && s[i] != '\t')
+                ++i;
+            w.tekst = s.substr(poczatek, i - poczatek);
+            if (w.tekst.empty() || w.tekst[0] == '{' || w.tekst[0] == '[')
+            {
+                blad = "niepoprawna wartosc \"" + klucz + "\" (zagniezdzone obiekty nie sa obslugiwane)";
+                return false;
+            }
+        }
+        pola[klucz] = w;
+
+        pominBiale(s, i);
+        if (i < s.size() && s[i] == ',')
+        {
+            ++i;
+            continue;
+        }
+        if (i < s.size() && s[i] == '}')
+            return true;
+        blad = "oczekiwano ',' albo '}'";
+        return false;
+    }
+}
+
+static std::string tekstJSON(const std::string& s)
+{
+    std::string wynik;
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+            wynik += '\\';
+        if (c == '\n')
+            wynik += "\\n";
+        else if ((unsigned char)c < 0x20)
+            wynik += ' ';
+        else
+            wynik += c;
+    }
+    return wynik;
+}
+
+static std::string pole(const PolaJSON& pola, const std::string& klucz, const std::string& domyslne = "")
+{
+    PolaJSON::const_iterator it = pola.find(klucz);
+    return it == pola.end() ? domyslne : it->second.tekst;
+}
+
+// Składnia liczby JSON: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)? – bez nan, inf, hex i spacji
+static bool liczbaJSON(const std::string& s)
+{
+    size_t i = 0;
+    auto cyfry = [&]() {
+        size_t p = i;
+        while (i < s.size() && s[i] >= '0' && s[i] <= '9')
+            ++i;
+        return i > p;
+    };
+    if (i < s.size() && s[i] == '-')
+        ++i;
+    if (i < s.size() && s[i] == '0')
+        ++i;
+    else if (!cyfry())
+        return false;
+    if (i < s.size() && s[i] == '.')
+    {
+        ++i;
+        if (!cyfry())
+            return false;
+    }
+    if (i < s.size() && (s[i] == 'e' || s[i] == 'E'))
+    {
+        ++i;
+        if (i < s.size() && (s[i] == '+' || s[i] == '-'))
+            ++i;
+        if (!cyfry())
+            return false;
+    }
+    return i == s.size();
+}
+
+// Brak pola zostawia domyślną wartość; false dla pola, które nie jest skończoną liczbą
+// z zakresu [min, max] – dopiero wtedy rzutowanie na int/unsigned jest bezpieczne
+static bool liczba(const PolaJSON& pola, const std::string& klucz, double& wynik,
+                   double min = std::numeric_limits<int>::min(), double max = std::numeric_limits<int>::max())
+{
+    PolaJSON::const_iterator it = pola.find(klucz);
+    if (it == pola.end())
+        return true;
+    if (it->second.napis || !liczbaJSON(it->second.tekst))
+        return false;
+    double w = std::strtod(it->second.tekst.c_str(), nullptr);
+    if (!std::isfinite(w) || w < min || w > max)
+        return false;
+    wynik = w;
+    return true;
+}
+
+// ===== Serwer =====
+
+SerwerSolverow::SerwerSolverow(const std::string& plikOptimow)
+    : wyjscie(nullptr), plikOptimow(plikOptimow), trwa(false), koniec(false), zamknij(false)
+{
+    if (!plikOptimow.empty())
+        wczytajZnaneOptima(sciezkaSystemowa(plikOptimow), optima);
+}
+
+SerwerSolverow::~SerwerSolverow()
+{
+    if (watek.joinable())
+        watek.join();
+}
+
+int SerwerSolverow::uruchom(std::istream& wejscie, std::ostream& wyjsciePoczatkowe)
+{
+    // Protokół ma wyłączność na wyjście; komunikaty solverów z std::cout idą na std::cerr
+    std::ostream protokol(wyjsciePoczatkowe.rdbuf());
+    wyjscie = &protokol;
+    std::streambuf* stdoutSolverow = std::cout.rdbuf(std::cerr.rdbuf());
+
+    watek = std::thread(&SerwerSolverow::petlaRobocza, this);
+    LOG_INFO(Ogolne, "Serwer solverow gotowy – zadania JSON po jednym w wierszu");
+
+    std::string wiersz;
+    while (std::getline(wejscie, wiersz))
+    {
+        obsluzWiersz(wiersz);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (zamknij)
+            break;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        koniec = true;
+    }
+    warunek.notify_all();
+    watek.join();
+
+    std::cout.rdbuf(stdoutSolverow);
+    wyjscie = nullptr;
+    return 0;
+}
+
+void SerwerSolverow::obsluzWiersz(const std::string& wiersz)
+{
+    if (wiersz.find_first_not_of(" \t\r") == std::string::npos)
+        return;
+
+    PolaJSON pola;
+    std::string blad;
+    if (!parsujObiekt(wiersz, pola, blad))
+    {
+        wyslijBlad("null", blad);
+        return;
+    }
+
+    // id wraca w zdarzeniach w tej samej postaci (liczba albo napis)
+    std::string id = "null";
+    PolaJSON::const_iterator itId = pola.find("id");
+    if (itId != pola.end())
+    {
+        if (!itId->second.napis && !liczbaJSON(itId->second.tekst))
+        {
+            wyslijBlad("null", "id musi byc liczba albo napisem");
+            return;
+        }
+        id = itId->second.napis ? "\"" + tekstJSON(itId->second.tekst) + "\"" : itId->second.tekst;
+    }
+
+    std::string polecenie = pole(pola, "cmd");
+    if (polecenie == "cancel")
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::deque<Zadanie>::iterator it = kolejka.begin(); it != kolejka.end(); ++it)
+        {
+            if (it->id == id && !it->solver.empty())
+            {
+                kolejka.erase(it);
+                wyslij("{\"id\": " + id + ", \"event\": \"cancelled\"}");
+                return;
+            }
+        }
+        if (trwa && biezaceId == id)
+            zadajZatrzymania(true); // odpowiedzią jest "done" z "cancelled": true
+        else
+            wyslijBlad(id, "brak zadania o tym id");
+        return;
+    }
+    if (polecenie == "shutdown")
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const Zadanie& z : kolejka)
+            if (!z.solver.empty())
+                wyslij("{\"id\": " + z.id + ", \"event\": \"cancelled\"}");
+        kolejka.clear();
+        if (trwa)
+            zadajZatrzymania(true);
+        zamknij = true;
+        warunek.notify_all();
+        return;
+    }
+    if (polecenie != "solve" && polecenie != "load")
+    {
+        wyslijBlad(id, "nieznane polecenie \"" + polecenie + "\"");
+        return;
+    }
+
+    Zadanie z;
+    z.id = id;
+    z.sciezka = pole(pola, "instance");
+    z.solver = polecenie == "load" ? "" : pole(pola, "solver", "tabu");
+    z.tryb = TrybDekodera::Polaktywny;
+    z.kodowanie = Kodowanie::Priorytety;
+    double budzet = 1000, ziarno = 0, cel = -1, watki = 0, dlugoscTabu = 100, populacja = 50, limitCzasu = 0.0;
+    if (!liczba(pola, "budget", budzet) || !liczba(pola, "seed", ziarno, 0, std::numeric_limits<unsigned>::max()) ||
+        !liczba(pola, "target", cel) || !liczba(pola, "threads", watki) || !liczba(pola, "tenure", dlugoscTabu) ||
+        !liczba(pola, "population", populacja) || !liczba(pola, "time_limit", limitCzasu, 0, 1e9))
+    {
+        wyslijBlad(id, "pola liczbowe musza byc liczbami w zakresie");
+        return;
+    }
+    z.budzet = (int)budzet;
+    z.ziarno = (unsigned)ziarno;
+    z.cel = (int)cel;
+    z.watki = (int)watki;
+    z.dlugoscTabu = (int)dlugoscTabu;
+    z.populacja = (int)populacja;
+    z.limitCzasu = limitCzasu;
+
+    std::string kodowanie = pole(pola, "encoding", "priorities");
+    std::string dekoder = pole(pola, "decoder", "semiactive");
+    if (kodowanie == "job_repetition")
+        z.kodowanie = Kodowanie::PowtorzeniaJobow;
+    if (dekoder == "gap_insertion")
+        z.tryb = TrybDekodera::WstawianieWLuki;
+
+    static const char* SOLVERY[] = { "", "random", "grasp", "tabu", "sa", "ea", "ewolucja" };
+    if (std::find(std::begin(SOLVERY), std::end(SOLVERY), z.solver) == std::end(SOLVERY))
+        blad = "nieznany solver \"" + z.solver + "\"";
+    else if (z.sciezka.empty())
+        blad = "brak pola \"instance\"";
+    else if (kodowanie != "priorities" && kodowanie != "job_repetition")
+        blad = "nieznane kodowanie \"" + kodowanie + "\"";
+    else if (dekoder != "semiactive" && dekoder != "gap_insertion")
+        blad = "nieznany dekoder \"" + dekoder + "\"";
+    else if (z.budzet <= 0 || z.populacja < 2 || z.dlugoscTabu < 0 || z.watki < 0)
+        blad = "budget, population, tenure albo threads poza zakresem";
+    else if (pola.count("time_limit") && z.solver != "sa")
+        blad = "time_limit jest obslugiwany tylko przez solver \"sa\"";
+    if (!blad.empty())
+    {
+        wyslijBlad(id, blad);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        kolejka.push_back(z);
+        if (!z.solver.empty())
+            wyslij("{\"id\": " + id + ", \"event\": \"queued\", \"position\": " + std::to_string(kolejka.size() - 1 + (trwa ? 1 : 0)) + "}");
+    }
+    warunek.notify_all();
+}
+
+void SerwerSolverow::petlaRobocza()
+{
+    while (true)
+    {
+        Zadanie z;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            warunek.wait(lock, [this] { return zamknij || koniec || !kolejka.empty(); });
+            if (zamknij || kolejka.empty())
+                return;
+            z = kolejka.front();
+            kolejka.pop_front();
+            // Pod blokadą: cancel, który przyjdzie od teraz, nie zostanie skasowany
+            zadajZatrzymania(false);
+            biezaceId = z.id;
+            trwa = true;
+        }
+
+        wykonaj(z);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        trwa = false;
+        biezaceId.clear();
+    }
+}
+
+void SerwerSolverow::wykonaj(const Zadanie& z)
+{
+    std::string blad;
+    Instancja* inst = instancja(z.sciezka, blad);
+    if (inst == nullptr)
+    {
+        wyslijBlad(z.id, blad);
+        return;
+    }
+    if (z.solver.empty())
+    {
+        wyslij("{\"id\": " + z.id + ", \"event\": \"loaded\", \"instance\": \"" + tekstJSON(z.sciezka) +
+               "\", \"jobs\": " + std::to_string(inst->liczbaJobow) + ", \"machines\": " + std::to_string(inst->liczbaMaszyn) +
+               ", \"lower_bound\": " + std::to_string(inst->dolneOgraniczenie) + ", \"target\": " + std::to_string(inst->cel) + "}");
+        return;
+    }
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    auto sekundy = [&start]() {
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(3)
+           << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return ss.str();
+    };
+    wyslij("{\"id\": " + z.id + ", \"event\": \"started\"}");
+
+    // Solvery mogą zgłaszać z kilku wątków i nie tylko ściśle lepsze wyniki – przepuszczamy tylko poprawy
+    std::atomic<int> najlepszy(std::numeric_limits<int>::max());
+    SluchaczPopraw sluchacz = [&](int makespan) {
+        int biezacy = najlepszy.load(std::memory_order_relaxed);
+        while (makespan < biezacy && !najlepszy.compare_exchange_weak(biezacy, makespan))
+            ;
+        if (makespan < biezacy)
+            wyslij("{\"id\": " + z.id + ", \"event\": \"improvement\", \"makespan\": " + std::to_string(makespan) +
+                   ", \"t\": " + sekundy() + "}");
+    };
+
+    ustawSluchaczaPopraw(&sluchacz);
+    std::vector<OperationSchedule> harmonogram;
+    int makespan = uruchomSolver(z, *inst, harmonogram);
+    ustawSluchaczaPopraw(nullptr);
+    if (makespan < 0)
+        return; // błąd już wysłany
+
+    std::ostringstream zdarzenie;
+    zdarzenie << "{\"id\": " << z.id << ", \"event\": \"done\", \"makespan\": " << makespan
+              << ", \"cancelled\": " << (czyZadanoZatrzymania() ? "true" : "false") << ", \"t\": " << sekundy()
+              << ", \"schedule\": [";
+    for (size_t i = 0; i < harmonogram.size(); ++i)
+    {
+        const OperationSchedule& op = harmonogram[i];
+        zdarzenie << (i ? ", [" : "[") << op.job_id << ", " << op.operation_id << ", " << op.machine_id << ", "
+                  << op.start_time << ", " << op.end_time << "]";
+    }
+    zdarzenie << "]}";
+    wyslij(zdarzenie.str());
+}
+
+template <typename Solver>
+static void ustawWspolne(Solver& solver, TrybDekodera tryb, Kodowanie kodowanie, int cel, unsigned ziarno)
+{
+    solver.ustawTrybDekodera(tryb);
+    solver.ustawKodowanie(kodowanie);
+    solver.ustawCel(cel);
+    solver.ustawZiarno(ziarno);
+}
+
+int SerwerSolverow::uruchomSolver(const Zadanie& z, Instancja& inst, std::vector<OperationSchedule>& harmonogram)
+{
+    const int cel = z.cel >= 0 ? z.cel : inst.cel;
+    std::unique_ptr<EvaluationCache>& cache = inst.cache[static_cast<int>(z.tryb) * 2 + static_cast<int>(z.kodowanie)];
+    if (!cache)
+        cache.reset(new EvaluationCache(16, true)); // klucz sekwencji maszyn (jak cacheSA w main)
+
+    if (z.solver == "random")
+    {
+        RandomSolver solver(z.budzet);
+        ustawWspolne(solver, z.tryb, z.kodowanie, cel, z.ziarno);
+        solver.ustawDolneOgraniczenie(inst.dolneOgraniczenie);
+        solver.ustawWatki(z.watki);
+        solver.solve(inst.operacje, inst.liczbaJobow, inst.liczbaMaszyn);
+        harmonogram = solver.getSchedule();
+        return solver.getMakespan();
+    }
+    if (z.solver == "grasp")
+    {
+        GraspSolver solver(z.budzet);
+        ustawWspolne(solver, z.tryb, z.kodowanie, cel, z.ziarno);
+        solver.ustawDolneOgraniczenie(inst.dolneOgraniczenie);
+        solver.ustawWatki(z.watki);
+        solver.solve(inst.operacje, inst.liczbaJobow, inst.liczbaMaszyn);
+        harmonogram = solver.getSchedule();
+        return solver.getMakespan();
+    }
+    if (z.solver == "tabu")
+    {
+        TabuSearchSolver solver(z.budzet, z.dlugoscTabu);
+        ustawWspolne(solver, z.tryb, z.kodowanie, cel, z.ziarno);
+        solver.ustawDolneOgraniczenie(inst.dolneOgraniczenie);
+        solver.ustawDywersyfikacje(Dywersyfikacja::PathRelinking, 10, 4, z.watki);
+        solver.solve(inst.operacje, inst.liczbaJobow, inst.liczbaMaszyn);
+        harmonogram = solver.getSchedule();
+        return solver.getMakespan();
+    }
+    if (z.solver == "sa")
+    {
+        SimulatedAnnealingSolver solver(1000.0, 0.01, 0.8, z.budzet);
+        ustawWspolne(solver, z.tryb, z.kodowanie, cel, z.ziarno);
+        solver.ustawDolneOgraniczenie(inst.dolneOgraniczenie);
+        solver.ustawCache(cache.get());
+        solver.ustawSasiedztwo(SasiedztwoSA::Krytyczne);
+        solver.ustawAdaptacje(0.5, z.limitCzasu);
+        solver.solve(inst.operacje, inst.liczbaJobow, inst.liczbaMaszyn);
+        harmonogram = solver.getSchedule();
+        return solver.getMakespan();
+    }
+    if (z.solver == "ea")
+    {
+        EvolutionarySolver solver(z.populacja, z.budzet, 0.8, 0.2);
+        ustawWspolne(solver, z.tryb, z.kodowanie, cel, z.ziarno);
+        solver.ustawCache(cache.get());
+        solver.ustawStanUstalony(2, Zastepowanie::Najgorszy);
+        solver.solve(inst.operacje, inst.liczbaJobow, inst.liczbaMaszyn);
+        harmonogram = solver.getSchedule();
+        return solver.getMakespan();
+    }
+    if (z.solver == "ewolucja")
+    {
+        EvolutionSolver solver(z.populacja, z.budzet, 0.01, 0.7, 3);
+        ustawWspolne(solver, z.tryb, z.kodowanie, cel, z.ziarno);
+        solver.ustawCache(cache.get());
+        solver.ustawSladPopulacji("");
+        solver.solve(inst.operacje, inst.liczbaJobow, inst.liczbaMaszyn);
+        harmonogram = solver.getSchedule();
+        return solver.getMakespan();
+    }
+
+    wyslijBlad(z.id, "nieznany solver \"" + z.solver + "\"");
+    return -1;
+}
+
+SerwerSolverow::Instancja* SerwerSolverow::instancja(const std::string& sciezka, std::string& blad)
+{
+    const std::string klucz = sciezkaSystemowa(sciezka);
+    std::map<std::string, std::unique_ptr<Instancja>>::iterator it = instancje.find(klucz);
+    if (it != instancje.end())
+        return it->second.get();
+
+    SimpleLoader loader;
+    if (!loader.load(klucz) || loader.liczbaJobow <= 0 || loader.liczbaMaszyn <= 0 ||
+        (int)loader.operacje.size() != loader.liczbaJobow * loader.liczbaMaszyn)
+    {
+        blad = "nie mozna wczytac instancji \"" + sciezka + "\"";
+        return nullptr;
+    }
+
+    std::unique_ptr<Instancja> inst(new Instancja());
+    inst->operacje.swap(loader.operacje);
+    inst->liczbaJobow = loader.liczbaJobow;
+    inst->liczbaMaszyn = loader.liczbaMaszyn;
+    inst->dolneOgraniczenie = obliczDolneOgraniczenia(inst->operacje, inst->liczbaJobow, inst->liczbaMaszyn).wartosc();
+    inst->cel = inst->dolneOgraniczenie;
+
+    std::map<std::string, ZnaneOptimum>::const_iterator opt = optima.find(nazwaInstancji(klucz));
+    if (opt != optima.end())
+    {
+        inst->dolneOgraniczenie = std::max(inst->dolneOgraniczenie, opt->second.lb);
+        inst->cel = opt->second.ub;
+    }
+    LOG_INFO(Ogolne, "Wczytano " << sciezka << " (" << inst->liczbaJobow << "x" << inst->liczbaMaszyn
+                                 << ", LB " << inst->dolneOgraniczenie << ")");
+
+    Instancja* wynik = inst.get();
+    instancje[klucz] = std::move(inst);
+    return wynik;
+}
+
+void SerwerSolverow::wyslij(const std::string& wiersz)
+{
+    std::lock_guard<std::mutex> lock(mutexWyjscia);
+    *wyjscie << wiersz << "\n" << std::flush;
+}
+
+void SerwerSolverow::wyslijBlad(const std::string& id, const std::string& komunikat)
+{
+    wyslij("{\"id\": " + id + ", \"event\": \"error\", \"msg\": \"" + tekstJSON(komunikat) + "\"}");
+}
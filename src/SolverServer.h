@@ -0,0 +1,99 @@
+#ifndef SOLVERSERVER_H
+#define SOLVERSERVER_H
+
+#include "OperationSchedule.h"
+#include "ScheduleDecoder.h"
+#include "EvaluationCache.h"
+#include "LowerBounds.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+
+// Tryb serwera: jeden długo żyjący proces obsługuje wiele krótkich przeplanowań bez startu programu.
+// Żądania i zdarzenia to obiekty JSON, po jednym w wierszu (stdin -> stdout):
+//   {"cmd": "load", "instance": "ta/ta01.txt"}
+//   {"cmd": "solve", "id": 7, "instance": "ta/ta01.txt", "solver": "tabu", "budget": 2000, "seed": 1,
+//    "encoding": "priorities", "decoder": "semiactive", "target": 1231, "threads": 0, "tenure": 100,
+//    "population": 50, "time_limit": 0.5}
+//   {"cmd": "cancel", "id": 7}
+//   {"cmd": "shutdown"}
+// Solvery: random, grasp, tabu, sa, ea (EvolutionarySolver, stan ustalony), ewolucja (EvolutionSolver).
+// budget = próby / iteracje / pokolenia solvera; pozostałe pola są opcjonalne, time_limit (sekundy) tylko dla sa.
+// id to liczba albo napis; liczby spoza zakresu (int, seed: unsigned) są odrzucane.
+// Zdarzenia: loaded, queued, started, improvement (nowy najlepszy makespan), done (z harmonogramem
+// [job, operacja, maszyna, start, koniec]), cancelled (usunięte z kolejki), error.
+// Wczytane instancje, dolne ograniczenia i cache ocen z kluczem sekwencji (na dekoder i kodowanie, dla sa,
+// ea i ewolucja – TS liczy szybciej bez cache) zostają w pamięci.
+// Żądania solve są liczone po kolei w jednym wątku roboczym; cancel przerywa bieżące przez
+// zadajZatrzymania(), więc solver kończy się jak po SIGINT i zwraca najlepsze dotąd rozwiązanie.
+class SerwerSolverow
+{
+public:
+    // plikOptimow: znane optima (wczytajZnaneOptima) – domyślny cel zamiast samego dolnego ograniczenia
+    explicit SerwerSolverow(const std::string& plikOptimow = "");
+    ~SerwerSolverow();
+
+    // Czyta żądania do końca wejścia albo "shutdown"; zwraca kod wyjścia programu.
+    // Wszystko, co solvery piszą na std::cout, trafia w tym czasie na std::cerr.
+    int uruchom(std::istream& wejscie, std::ostream& wyjscie);
+
+private:
+    struct Instancja
+    {
+        std::vector<OperationSchedule> operacje;
+        int liczbaJobow;
+        int liczbaMaszyn;
+        int dolneOgraniczenie;
+        int cel;
+        std::map<int, std::unique_ptr<EvaluationCache>> cache; // klucz: tryb dekodera * 2 + kodowanie
+    };
+
+    struct Zadanie
+    {
+        std::string id; // surowy JSON (liczba albo napis) – odsyłany bez zmian
+        std::string sciezka;
+        std::string solver;
+        int budzet;
+        unsigned ziarno;
+        TrybDekodera tryb;
+        Kodowanie kodowanie;
+        int cel;        // -1 = cel instancji
+        int watki;
+        int dlugoscTabu;
+        int populacja;
+        double limitCzasu;
+    };
+
+    void obsluzWiersz(const std::string& wiersz);
+    void petlaRobocza();
+    void wykonaj(const Zadanie& z);
+    int uruchomSolver(const Zadanie& z, Instancja& inst, std::vector<OperationSchedule>& harmonogram);
+
+    Instancja* instancja(const std::string& sciezka, std::string& blad);
+    void wyslij(const std::string& wiersz);
+    void wyslijBlad(const std::string& id, const std::string& komunikat);
+
+    std::ostream* wyjscie;
+    std::string plikOptimow;
+    std::map<std::string, ZnaneOptimum> optima;
+    std::map<std::string, std::unique_ptr<Instancja>> instancje; // tylko wątek roboczy
+
+    std::mutex mutexWyjscia;
+    std::mutex mutex;
+    std::condition_variable warunek;
+    std::deque<Zadanie> kolejka;
+    std::string biezaceId;
+    bool trwa;      // wątek roboczy liczy biezaceId
+    bool koniec;    // koniec wejścia: dokończ kolejkę i wyjdź
+    bool zamknij;   // shutdown: porzuć kolejkę
+    std::thread watek;
+};
+
+#endif // SOLVERSERVER_H
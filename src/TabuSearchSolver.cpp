@@ -1,9 +1,17 @@
 #include "TabuSearchSolver.h"
+#include "LowerBounds.h"
+#include "Checkpoint.h"
+#include "Metrics.h"
+#include "Log.h"
+#include "SolverEvents.h"
+#include "ResultWriter.h"
+#include "Moves.h"
 #include <iostream>
 #include <fstream>
 #include <random>
 #include <numeric>
 #include <algorithm>
+#include <memory>
 
 
 // Funkcja sprawdzająca, czy zamiana dwóch operacji w genotypie jest legalna
@@ -30,72 +38,96 @@ TabuSearchSolver::TabuSearchSolver(int liczbaIteracji, int dlugoscTabu)
     this->liczbaIteracji = liczbaIteracji;
     this->dlugoscTabu = dlugoscTabu;
     this->makespan = 0;
-}
-
-// Funkcja pomocnicza: buduje harmonogram na podstawie priorytetów
-std::vector<OperationSchedule> TabuSearchSolver::zbudujHarmonogramZPriorytetami(
-    const std::vector<int>& priorytety,
-    const std::vector<OperationSchedule>& operacje,
-    int liczbaJobow,
-    int liczbaMaszyn)
-{
-    std::vector<OperationSchedule> kopia = operacje;
-
-    // Przypisz priorytety i wyzeruj start/end_time
-    for (int i = 0; i < priorytety.size(); ++i)
-    {
-        kopia[i].priority = priorytety[i];
-        kopia[i].start_time = 0;
-        kopia[i].end_time = 0;
-    }
-
-    // Zbuduj harmonogram na podstawie aktualnych priorytetów
-    obliczMakespanOgolny(kopia, &priorytety, true, liczbaJobow, liczbaMaszyn);
-
-    return kopia;
+    this->trybDekodera = TrybDekodera::Polaktywny;
+    this->kodowanie = Kodowanie::Priorytety;
+    this->cel = 0;
+    this->dolneOgraniczenie = 0;
+    this->cache = nullptr;
+    this->ograniczenia = nullptr;
+    this->gen.seed(std::random_device{}());
+    this->coIleCheckpoint = 0;
+    this->liczbaRestartow = 0;
+    this->dywersyfikacja = Dywersyfikacja::PathRelinking;
+    this->rozmiarPuliElitarnej = 10;
+    this->parRelinkingu = 4;
+    this->watkiRelinkingu = 0;
 }
 
 
 // Główna funkcja algorytmu Tabu Search
 void TabuSearchSolver::solve(const std::vector<OperationSchedule>& operacje, int liczbaJobow, int liczbaMaszyn)
 {
-    std::mt19937 gen(std::random_device{}());
     int liczbaOperacji = operacje.size();
+    ScheduleDecoder dekoder(operacje, liczbaJobow, liczbaMaszyn, trybDekodera, kodowanie);
+    dekoder.ustawCache(cache);
+    dekoder.ustawOgraniczenia(ograniczenia);
 
 
     const int liczbaLosowychSasiadow = 600;
 
-    // Inicjalizacja losowych priorytetów
-    std::vector<int> priorytety(liczbaOperacji);
-    for (int i = 0; i < liczbaOperacji; ++i)
-        priorytety[i] = i;
-    std::shuffle(priorytety.begin(), priorytety.end(), gen);
-
-    // Tworzymy harmonogram startowy
-    std::vector<OperationSchedule> aktualny = zbudujHarmonogramZPriorytetami(priorytety, operacje, liczbaJobow, liczbaMaszyn);
-    
-    int najlepszyMakespan = obliczMakespanOgolny(aktualny, nullptr, false, liczbaJobow, liczbaMaszyn);
-    std::vector<OperationSchedule> najlepszy = aktualny;
-
-    // Inicjalizacja listy tabu
-    std::vector<std::pair<int, int>> tabuLista;
-    int bezPoprawy = 0;
+    Stan stan;
+    std::vector<int>& priorytety = stan.priorytety;
+    int& najlepszyMakespan = stan.najlepszyMakespan;
+    std::vector<std::pair<int, int>>& tabuLista = stan.tabuLista;
+    int& bezPoprawy = stan.bezPoprawy;
+    int& liczbaRestartow = stan.liczbaRestartow;
+    std::vector<OperationSchedule> najlepszy;
+
+    uint64_t sumaInstancji = sumaKontrolnaInstancji(operacje, liczbaJobow, liczbaMaszyn);
+    if (!plikWznowienia.empty() && wczytajCheckpoint(sumaInstancji, stan))
+    {
+        dekoder.dekoduj(stan.najlepszyGenotyp, &najlepszy);
+    }
+    else
+    {
+        // Inicjalizacja genotypu: podany z zewnątrz albo losowy
+        priorytety = genotypBazowy(operacje, kodowanie);
+        if (genotypStartowy.size() == priorytety.size())
+            priorytety = genotypStartowy;
+        else
+            std::shuffle(priorytety.begin(), priorytety.end(), gen);
+
+        // Tworzymy harmonogram startowy
+        najlepszyMakespan = dekoder.dekoduj(priorytety, &najlepszy);
+        stan.najlepszyGenotyp = priorytety;
+
+        // Inicjalizacja listy tabu
+        tabuLista.clear();
+        bezPoprawy = 0;
+        liczbaRestartow = 0;
+        stan.iter = 0;
+        stan.najlepszyEpizodu = priorytety;
+        stan.kosztEpizodu = najlepszyMakespan;
+        stan.elita = ElitePool(rozmiarPuliElitarnej);
+    }
     const int limitBezPoprawy = 100;
-    int liczbaRestartow = 0;
     std::uniform_int_distribution<> dist(0, liczbaOperacji - 1);
 
-    // Główna pętla iteracji
-    for (int iter = 0; iter < liczbaIteracji; ++iter)
+    std::unique_ptr<CheckpointWriter> zapis;
+    if (!plikCheckpointu.empty())
+        zapis.reset(new CheckpointWriter(plikCheckpointu));
+
+    // Relinking ocenia sekwencje maszyn bez warunków brzegowych przeplanowania – wtedy restart losowy
+    std::unique_ptr<PathRelinkingPool> relinking;
+    if (dywersyfikacja == Dywersyfikacja::PathRelinking && ograniczenia == nullptr)
+        relinking.reset(new PathRelinkingPool(operacje, liczbaJobow, liczbaMaszyn, trybDekodera, kodowanie, watkiRelinkingu));
+
+    // Główna pętla iteracji (kończy się też po osiągnięciu celu)
+    while (stan.iter < liczbaIteracji && najlepszyMakespan > cel)
     {
-        //std::cout << "\n[DEBUG] Iteracja " << iter << " | bez poprawy: " << bezPoprawy
-                //  << " | obecny makespan: " << najlepszyMakespan << "\n";
+        LOG_SLAD(Tabu, "Iteracja " << stan.iter << " | bez poprawy: " << bezPoprawy
+                           << " | najlepszy makespan: " << najlepszyMakespan);
+        METRYKA_FAZA(Sasiedztwo);
 
-        std::vector<int> najlepszySasiadGenotyp;
         int najlepszySasiadKoszt = std::numeric_limits<int>::max();
         int najlepszyI = -1;
         int najlepszyJ = -1;
 
-        // Szukamy najlepszego sąsiada (spośród losowych zamian)
+        // Hash bieżącego genotypu – hash sąsiada to jego aktualizacja w O(1)
+        uint64_t hashAktualny = (cache != nullptr) ? EvaluationCache::hashGenotypu(priorytety) : 0;
+
+        // Szukamy najlepszego sąsiada (spośród losowych zamian); każda zamiana jest wykonywana
+        // na bieżącym genotypie i cofana po ocenie, zapamiętujemy tylko jej pozycje
         for (int s = 0; s < liczbaLosowychSasiadow; ++s)
         {
             int i = dist(gen);
@@ -103,21 +135,31 @@ void TabuSearchSolver::solve(const std::vector<OperationSchedule>& operacje, int
             if (i == j) continue;
             if (i > j) std::swap(i, j);
 
+            // W kodowaniu z powtórzeniami zamiana dwóch genów tego samego joba nic nie zmienia
+            if (kodowanie == Kodowanie::PowtorzeniaJobow && priorytety[i] == priorytety[j])
+                continue;
+
             std::pair<int, int> ruch = std::make_pair(i, j);
-            std::vector<int> sasiadGenotyp = priorytety;
-            std::swap(sasiadGenotyp[i], sasiadGenotyp[j]);
+            Ruch zamiana{ RodzajRuchu::Zamiana, i, j };
+            uint64_t hashSasiada = hashAktualny;
+            zastosujRuch(priorytety, zamiana, (cache != nullptr) ? &hashSasiada : nullptr);
 
-            if (!czySwapLegalny(sasiadGenotyp, operacje, i, j))
+            // Każdy ciąg z powtórzeniami jest poprawny, sprawdzamy tylko genotyp priorytetowy
+            if (kodowanie == Kodowanie::Priorytety && !czySwapLegalny(priorytety, operacje, i, j))
+            {
+                cofnijRuch(priorytety, zamiana);
                 continue;
+            }
 
-            std::vector<OperationSchedule> kopia = operacje;
-            int koszt = obliczMakespanOgolny(kopia, &sasiadGenotyp, true, liczbaJobow, liczbaMaszyn);
+            // Liczy się tylko sąsiad lepszy od dotychczas najlepszego – gorsze dekodowanie jest przerywane
+            int koszt = (cache != nullptr) ? dekoder.ocenDo(priorytety, hashSasiada, najlepszySasiadKoszt)
+                                           : dekoder.dekodujDo(priorytety, najlepszySasiadKoszt);
+            cofnijRuch(priorytety, zamiana);
 
             bool jestNaTabu = (std::find(tabuLista.begin(), tabuLista.end(), ruch) != tabuLista.end());
 
             if (koszt < najlepszySasiadKoszt)
             {
-                najlepszySasiadGenotyp = sasiadGenotyp;
                 najlepszySasiadKoszt = koszt;
                 najlepszyI = i;
                 najlepszyJ = j;
@@ -125,13 +167,18 @@ void TabuSearchSolver::solve(const std::vector<OperationSchedule>& operacje, int
         }
 
         // Jeśli znaleziono sąsiada – sprawdzamy, czy warto go zaakceptować
-            if (!najlepszySasiadGenotyp.empty())
-   {priorytety = najlepszySasiadGenotyp;
-aktualny = zbudujHarmonogramZPriorytetami(priorytety, operacje, liczbaJobow, liczbaMaszyn);
-
-// TO TU WŁAŚCIWE OBLICZAMY koszt aktualnego rozwiązania
-int aktualnyKoszt = obliczMakespanOgolny(aktualny, nullptr, false, liczbaJobow, liczbaMaszyn);
-
+            if (najlepszyI >= 0)
+   {METRYKA_FAZA(Selekcja);
+    METRYKA_DODAJ(ZaakceptowaneRuchy, 1);
+    zastosujRuch(priorytety, Ruch{ RodzajRuchu::Zamiana, najlepszyI, najlepszyJ });
+
+// Koszt aktualnego rozwiązania to koszt wybranego sąsiada
+int aktualnyKoszt = najlepszySasiadKoszt;
+if (aktualnyKoszt < stan.kosztEpizodu)
+{
+    stan.najlepszyEpizodu = priorytety;
+    stan.kosztEpizodu = aktualnyKoszt;
+}
 
 
     // Dodaj ruch do listy tabu
@@ -140,6 +187,8 @@ int aktualnyKoszt = obliczMakespanOgolny(aktualny, nullptr, false, liczbaJobow,
         tabuLista.erase(tabuLista.begin());
 
         // Zawsze zapisz aktualny koszt
+{
+METRYKA_FAZA(Logowanie);
 kosztyIteracji.push_back(aktualnyKoszt);
 
 // Oblicz avg i worst na podstawie dotychczasowych kosztów
@@ -154,13 +203,18 @@ for (int k = 0; k < kosztyIteracji.size(); ++k)
 double avg = static_cast<double>(suma) / kosztyIteracji.size();
 avgIteracji.push_back(avg);
 worstIteracji.push_back(najgorszy);
+}
 
-// Jeśli rozwiązanie jest lepsze – zapisz je jako nowe najlepsze
+// Jeśli rozwiązanie jest lepsze – zbuduj i zapisz je jako nowe najlepsze
 if (najlepszySasiadKoszt < najlepszyMakespan)
 {
-    najlepszy = aktualny;
+    LOG_DEBUG(Tabu, "Iteracja " << stan.iter << ": nowy najlepszy makespan = " << najlepszySasiadKoszt);
+    dekoder.dekoduj(priorytety, &najlepszy);
+    stan.najlepszyGenotyp = priorytety;
     najlepszyMakespan = najlepszySasiadKoszt;
     bezPoprawy = 0;
+    METRYKA_DODAJ(Poprawy, 1);
+    zglosPoprawe(najlepszyMakespan);
 }
 else
 {
@@ -169,16 +223,46 @@ else
 
 
     // Zapisz do historii: current i best_so_far
-    historiaCurrent.push_back(aktualnyKoszt);
-    historiaBestSoFar.push_back(najlepszyMakespan);
+    {
+        METRYKA_FAZA(Logowanie);
+        historiaCurrent.push_back(aktualnyKoszt);
+        historiaBestSoFar.push_back(najlepszyMakespan);
+    }
 
     // Restart, jeśli za długo nie ma poprawy
     if (bezPoprawy >= limitBezPoprawy)
     {
         liczbaRestartow++;
+        METRYKA_DODAJ(Restarty, 1);
+
+        // Koniec epizodu trafia do puli elitarnej; start z najlepszego punktu pośredniego między elitarnymi
+        std::vector<int> start;
+        int kosztStartu = -1;
+        if (relinking)
+        {
+            stan.elita.dodaj(stan.najlepszyEpizodu, stan.kosztEpizodu, relinking->podpis(stan.najlepszyEpizodu));
+            if (stan.elita.rozmiar() >= 2)
+                kosztStartu = restartZElity(stan, *relinking, start);
+        }
 
-        std::shuffle(priorytety.begin(), priorytety.end(), gen);
-        aktualny = zbudujHarmonogramZPriorytetami(priorytety, operacje, liczbaJobow, liczbaMaszyn);
+        if (kosztStartu >= 0)
+        {
+            priorytety = start;
+            if (kosztStartu < najlepszyMakespan)
+            {
+                dekoder.dekoduj(priorytety, &najlepszy);
+                stan.najlepszyGenotyp = priorytety;
+                najlepszyMakespan = kosztStartu;
+                METRYKA_DODAJ(Poprawy, 1);
+                zglosPoprawe(najlepszyMakespan);
+            }
+        }
+        else
+        {
+            std::shuffle(priorytety.begin(), priorytety.end(), gen);
+        }
+        stan.najlepszyEpizodu = priorytety;
+        stan.kosztEpizodu = (kosztStartu >= 0) ? kosztStartu : std::numeric_limits<int>::max();
         bezPoprawy = 0;
         tabuLista.clear();
     }
@@ -186,135 +270,144 @@ else
 
         else
         {
-            std::cerr << "[DEBUG] Brak dostępnych sąsiadów (lub wszystko na tabu).\n";
+            LOG_LIMIT(Debug, Tabu, 10, "Brak dostępnych sąsiadów w iteracji " << stan.iter);
             break;
         }
+
+        ++stan.iter;
+        if (zapis && ((coIleCheckpoint > 0 && stan.iter % coIleCheckpoint == 0) || czyZadanoCheckpointu()))
+        {
+            METRYKA_FAZA(Logowanie);
+            zapiszCheckpoint(stan, sumaInstancji, *zapis);
+            potwierdzCheckpoint();
+        }
+        if (czyZadanoZatrzymania())
+            break;
     }
 
+    // Zatrzymany przebieg zostawia stan do wznowienia; zakończony usuwa checkpoint
+    if (zapis && czyZadanoZatrzymania())
+        zapiszCheckpoint(stan, sumaInstancji, *zapis);
+    else if (zapis)
+        zapis->porzuc();
+
     makespan = najlepszyMakespan;
     schedule = najlepszy;
+    this->liczbaRestartow = liczbaRestartow;
     if (kosztyIteracji.empty())
         kosztyIteracji.push_back(najlepszyMakespan); // zabezpieczenie, jeśli żadna iteracja nie poprawiła
 
 }
 
 
-int TabuSearchSolver::obliczMakespanOgolny(std::vector<OperationSchedule>& kandydaci,
-                                           const std::vector<int>* priorytety,
-                                           bool czySortowac,
-                                           int liczbaJobow,
-                                           int liczbaMaszyn) const
+void TabuSearchSolver::zapiszCheckpoint(const Stan& stan, uint64_t sumaInstancji, CheckpointWriter& zapis) const
 {
-    const int N = kandydaci.size();
-
-    // Wyznacz ile operacji ma każdy job
-    std::vector<int> liczbaOperacjiNaJob(liczbaJobow, 0);
-    for (int i = 0; i < N; ++i)
+    BuforZapisu b;
+    b.piszNaglowek("tabu", sumaInstancji, trybDekodera, kodowanie);
+    b.piszGenerator(gen);
+    b.piszInt(stan.iter);
+    b.piszInt(stan.najlepszyMakespan);
+    b.piszInt(stan.bezPoprawy);
+    b.piszInt(stan.liczbaRestartow);
+    b.piszWektor(stan.priorytety);
+    b.piszWektor(stan.najlepszyGenotyp);
+
+    std::vector<int> tabu;
+    for (int i = 0; i < (int)stan.tabuLista.size(); ++i)
     {
-        const OperationSchedule& op = kandydaci[i];
-        if (op.operation_id + 1 > liczbaOperacjiNaJob[op.job_id])
-        {
-            liczbaOperacjiNaJob[op.job_id] = op.operation_id + 1;
-        }
+        tabu.push_back(stan.tabuLista[i].first);
+        tabu.push_back(stan.tabuLista[i].second);
     }
+    b.piszWektor(tabu);
+
+    b.piszWektor(kosztyIteracji);
+    b.piszWektor(historiaCurrent);
+    b.piszWektor(historiaBestSoFar);
+    b.piszWektor(avgIteracji);
+    b.piszWektor(worstIteracji);
+    b.piszWektor(stan.najlepszyEpizodu);
+    b.piszInt(stan.kosztEpizodu);
+    stan.elita.zapisz(b);
+    b.zakoncz();
+
+    zapis.zlec(b.getDane());
+}
 
-    if (czySortowac && priorytety != nullptr)
+bool TabuSearchSolver::wczytajCheckpoint(uint64_t sumaInstancji, Stan& stan)
+{
+    std::vector<char> dane;
+    if (!wczytajPlikBinarny(plikWznowienia, dane))
     {
-        for (int i = 0; i < N; ++i)
-        {
-            kandydaci[i].priority = (*priorytety)[i];
-        }
+        LOG_OSTRZEZENIE(Tabu, "Brak checkpointu " << plikWznowienia << " – start od nowa");
+        return false;
     }
 
-    // Bucket sort
-    std::vector<int> indeksy(N);
-    std::vector<int> bucket(N, -1);
-    for (int i = 0; i < N; ++i)
+    BuforOdczytu b(dane);
+    if (!b.czytajNaglowek("tabu", sumaInstancji, trybDekodera, kodowanie))
+        return false;
+
+    std::mt19937 g;
+    b.czytajGenerator(g);
+    Stan s;
+    s.iter = b.czytajInt();
+    s.najlepszyMakespan = b.czytajInt();
+    s.bezPoprawy = b.czytajInt();
+    s.liczbaRestartow = b.czytajInt();
+    b.czytajWektor(s.priorytety);
+    b.czytajWektor(s.najlepszyGenotyp);
+
+    std::vector<int> tabu;
+    b.czytajWektor(tabu);
+    for (int i = 0; i + 1 < (int)tabu.size(); i += 2)
+        s.tabuLista.push_back(std::make_pair(tabu[i], tabu[i + 1]));
+
+    std::vector<int> koszty, current, bestSoFar, worst;
+    std::vector<double> avg;
+    b.czytajWektor(koszty);
+    b.czytajWektor(current);
+    b.czytajWektor(bestSoFar);
+    b.czytajWektor(avg);
+    b.czytajWektor(worst);
+
+    b.czytajWektor(s.najlepszyEpizodu);
+    s.kosztEpizodu = b.czytajInt();
+    s.elita = ElitePool(rozmiarPuliElitarnej);
+    s.elita.wczytaj(b);
+
+    if (!b.ok())
     {
-        int p = kandydaci[i].priority;
-        if (p < 0 || p >= N)
-        {
-            std::cerr << "[Błąd] Zły priorytet: " << p << " (i=" << i << ")\n";
-        }
-        bucket[p] = i;
+        LOG_OSTRZEZENIE(Tabu, "Niepelny checkpoint " << plikWznowienia);
+        return false;
     }
-    for (int i = 0; i < N; ++i)
-        indeksy[i] = bucket[i];
-
-    // Struktury pomocnicze
-    std::vector<int> maszyna_wolna_od(liczbaMaszyn, 0);
-    std::vector<int> job_gotowy_od(liczbaJobow, 0);
-    std::vector<std::vector<char>> czy_zrobione(liczbaJobow);
-    for (int i = 0; i < liczbaJobow; ++i)
-        czy_zrobione[i].resize(liczbaOperacjiNaJob[i], 0);
 
-    std::vector<char> zaplanowane(N, 0);
-    int zaplanowanych = 0;
-    int maksEnd = 0;
+    gen = g;
+    stan = s;
+    kosztyIteracji = koszty;
+    historiaCurrent = current;
+    historiaBestSoFar = bestSoFar;
+    avgIteracji = avg;
+    worstIteracji = worst;
+    LOG_INFO(Tabu, "Wznowiono z " << plikWznowienia << " od iteracji " << stan.iter);
+    return true;
+}
 
-    int numerIteracji = 0;
+int TabuSearchSolver::restartZElity(const Stan& stan, PathRelinkingPool& relinking, std::vector<int>& wynik)
+{
+    const ElitePool& elita = stan.elita;
+    std::uniform_int_distribution<> losuj(0, elita.rozmiar() - 1);
 
-    while (zaplanowanych < N)
+    // Pierwsza para wychodzi z końca epizodu, pozostałe łączą losowe rozwiązania z puli
+    std::vector<std::pair<const std::vector<int>*, const std::vector<int>*>> pary;
+    for (int k = 0; k < parRelinkingu; ++k)
     {
-        bool dodano = false;
-
-        for (int ii = 0; ii < N; ++ii)
-        {
-            int i = indeksy[ii];
-            if (zaplanowane[i]) continue;
-
-            OperationSchedule& op = kandydaci[i];
-
-            bool poprzedniaOK = (op.operation_id == 0) || (czy_zrobione[op.job_id][op.operation_id - 1]);
-
-            if (!poprzedniaOK)
-                continue;
-
-            int start = std::max(maszyna_wolna_od[op.machine_id], job_gotowy_od[op.job_id]);
-            int end = start + op.processing_time;
-
-            op.start_time = start;
-            op.end_time = end;
-
-            maszyna_wolna_od[op.machine_id] = end;
-            job_gotowy_od[op.job_id] = end;
-            czy_zrobione[op.job_id][op.operation_id] = 1;
-            zaplanowane[i] = 1;
-            zaplanowanych++;
-            dodano = true;
-
-            // 🔍 Debug: pokaż tylko pierwsze i ostatnie operacje
-            /*if (zaplanowanych <= 10 || zaplanowanych > N - 5)
-            {
-                std::cout << "[DEBUG] #" << zaplanowanych
-                          << " job=" << op.job_id
-                          << " op=" << op.operation_id
-                          << " maszyna=" << op.machine_id
-                          << " czas=" << op.processing_time
-                          << " start=" << op.start_time
-                          << " end=" << op.end_time
-                          << "\n";
-            }*/
-
-            if (end > maksEnd)
-            {
-                maksEnd = end;
-            }
-        }
-
-        if (!dodano)
-        {
-            std::cerr << "[TS] DEADLOCK – nie udało się zaplanować operacji.\n";
-            return std::numeric_limits<int>::max();
-        }
-
-        numerIteracji++;
+        const std::vector<int>* poczatek = (k == 0) ? &stan.najlepszyEpizodu : &elita.genotyp(losuj(gen));
+        const std::vector<int>* cel = &elita.genotyp(losuj(gen));
+        if (*poczatek != *cel)
+            pary.push_back(std::make_pair(poczatek, cel));
     }
-
-    return maksEnd;
+    return relinking.najlepszy(pary, wynik);
 }
 
-
 // Wypisuje najlepszy harmonogram do konsoli
 void TabuSearchSolver::printSchedule() const
 {
@@ -338,26 +431,16 @@ void TabuSearchSolver::printSchedule() const
 // Zapisuje harmonogram do pliku CSV
 void TabuSearchSolver::zapiszDoCSV(const std::string& nazwaPliku) const
 {
-    std::ofstream out(nazwaPliku);
-    if (!out.is_open())
+    TekstCSV t(',');
+    t.zarezerwuj(schedule.size() * 24);
+    t.tekst() = "job_id,operation_id,machine_id,start_time,end_time,priority\n";
+    for (const OperationSchedule& op : schedule)
     {
-        std::cerr << "Nie można otworzyć pliku do zapisu: " << nazwaPliku << "\n";
-        return;
+        t.pole(op.job_id).pole(op.operation_id).pole(op.machine_id).pole(op.start_time).pole(op.end_time).pole(op.priority);
+        t.koniecWiersza();
     }
 
-    // Nagłówek CSV
-    out << "job_id,operation_id,machine_id,start_time,end_time,priority\n";
-
-    for (int i = 0; i < schedule.size(); ++i)
-    {
-        const OperationSchedule& op = schedule[i];
-        out << op.job_id << ","
-            << op.operation_id << ","
-            << op.machine_id << ","
-            << op.start_time << ","
-            << op.end_time << ","
-            << op.priority << "\n";
-    }
+    ResultWriter::instancja().zapisz(nazwaPliku, t.tekst());
 }
 
 void TabuSearchSolver::zapiszStatystykiDoCSV(const std::string& nazwaPliku, int run) const
@@ -380,80 +463,42 @@ void TabuSearchSolver::zapiszStatystykiDoCSV(const std::string& nazwaPliku, int
     }
     double stddev = std::sqrt(sumKw / kosztyIteracji.size());
 
-    std::ofstream out;
-    bool istnieje = std::ifstream(nazwaPliku).good();
-    out.open(nazwaPliku, std::ios::app);
-
-    if (!out.is_open())
-    {
-        std::cerr << "Nie można otworzyć pliku do zapisu: " << nazwaPliku << "\n";
-        return;
-    }
-
-    if (!istnieje)
-    {
-        out << "run;best;average;worst;std\n";
-    }
-
-    out << run << ";" << best << ";" << avg << ";" << worst << ";" << stddev << "\n";
-    out.close();
+    TekstCSV t;
+    t.pole(run).pole(best).pole(avg).pole(worst).pole(stddev).pole(obliczGap(makespan, dolneOgraniczenie));
+    t.koniecWiersza();
+    ResultWriter::instancja().dopisz(nazwaPliku, "run;best;average;worst;std;gap\n", t.tekst());
 }
 
 
 void TabuSearchSolver::zapiszBestVsCurrentCSV(const std::string& nazwaPliku) const
 {
     if (historiaCurrent.empty() || historiaBestSoFar.empty()) {
-        std::cerr << "[Tabu] Brak danych do zapisania best vs current.\n";
+        LOG_OSTRZEZENIE(Tabu, "Brak danych do zapisania best vs current.");
         return;
     }
 
-    std::ofstream out;
-    bool istnieje = std::ifstream(nazwaPliku).good();
-    out.open(nazwaPliku, std::ios::app);
-
-    if (!out.is_open()) {
-        std::cerr << "[Tabu] Nie można otworzyć pliku: " << nazwaPliku << "\n";
-        return;
-    }
-
-    if (!istnieje) {
-        out << "iter;current;best_so_far\n";
-    }
-
+    TekstCSV t;
+    t.zarezerwuj(historiaCurrent.size() * 16);
     for (int i = 0; i < historiaCurrent.size(); ++i) {
-        out << i << ";" << historiaCurrent[i] << ";" << historiaBestSoFar[i] << "\n";
+        t.pole(i).pole(historiaCurrent[i]).pole(historiaBestSoFar[i]);
+        t.koniecWiersza();
     }
-
-    out.close();
+    ResultWriter::instancja().dopisz(nazwaPliku, "iter;current;best_so_far\n", t.tekst());
 }
 
 
 void TabuSearchSolver::zapiszKosztyNajlepszegoRunCSV(const std::string& nazwaPliku) const
 {
     if (kosztyIteracji.empty() || avgIteracji.empty() || worstIteracji.empty()) {
-        std::cerr << "[Tabu] Brak danych do zapisania kosztów najlepszego runa.\n";
+        LOG_OSTRZEZENIE(Tabu, "Brak danych do zapisania kosztów najlepszego runa.");
         return;
     }
 
-    std::ofstream out;
-    bool istnieje = std::ifstream(nazwaPliku).good();
-    out.open(nazwaPliku, std::ios::app);
-
-    if (!out.is_open()) {
-        std::cerr << "[Tabu] Nie można otworzyć pliku: " << nazwaPliku << "\n";
-        return;
-    }
-
-    if (!istnieje) {
-        out << "iter;best;avg;worst\n";
-    }
-
+    TekstCSV t;
+    t.zarezerwuj(kosztyIteracji.size() * 24);
     for (int i = 0; i < kosztyIteracji.size(); ++i) {
-        out << i << ";" 
-            << kosztyIteracji[i] << ";" 
-            << avgIteracji[i] << ";" 
-            << worstIteracji[i] << "\n";
+        t.pole(i).pole(kosztyIteracji[i]).pole(avgIteracji[i]).pole(worstIteracji[i]);
+        t.koniecWiersza();
     }
-
-    out.close();
+    ResultWriter::instancja().dopisz(nazwaPliku, "iter;best;avg;worst\n", t.tekst());
 }
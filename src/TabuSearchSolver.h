@@ -2,9 +2,14 @@
 #define TABU_SEARCH_SOLVER_H
 
 #include "OperationSchedule.h"
+#include "ScheduleDecoder.h"
+#include "PathRelinking.h"
 #include <vector>
 #include <map>
 #include <string>
+#include <random>
+
+class CheckpointWriter;
 
 class TabuSearchSolver
 {
@@ -16,11 +21,42 @@ public:
 
     void zapiszDoCSV(const std::string& nazwaPliku) const;
 
-   int obliczMakespanOgolny(std::vector<OperationSchedule>& kandydaci, const std::vector<int>* priorytety, bool czySortowac, int liczbaJobow, int liczbaMaszyn) const;
+    // Wybór dekodera i kodowania genotypu (domyślnie półaktywny, priorytetowy)
+    void ustawTrybDekodera(TrybDekodera tryb) { trybDekodera = tryb; }
+    void ustawKodowanie(Kodowanie k) { kodowanie = k; }
+
+    // Zatrzymanie po osiągnięciu celu (np. znanego optimum) i dolne ograniczenie do liczenia gapu
+    void ustawCel(int cel) { this->cel = cel; }
+    void ustawDolneOgraniczenie(int lb) { dolneOgraniczenie = lb; }
+
+    // Wspólna pamięć podręczna ocen (jedna na instancję i tryb dekodera); nullptr = bez cache
+    void ustawCache(EvaluationCache* c) { cache = c; }
+
+    // Start od podanego genotypu zamiast losowego (np. naprawa z Rescheduler); pusty = losowo
+    void ustawGenotypStartowy(const std::vector<int>& g) { genotypStartowy = g; }
+    // Warunki brzegowe dekodera przy przeplanowaniu; nullptr = zwykła instancja od chwili 0
+    void ustawOgraniczenia(const OgraniczeniaCzasowe* o) { ograniczenia = o; }
+
+    // Checkpoint co `coIle` iteracji, na sygnał i przy zatrzymaniu (zakończony przebieg usuwa plik); pusta ścieżka = wyłączone
+    void ustawCheckpoint(const std::string& sciezka, int coIle) { plikCheckpointu = sciezka; coIleCheckpoint = coIle; }
+    // Następne solve() kontynuuje przebieg z checkpointu (dalej identycznie jak bez przerwy)
+    void wznowZ(const std::string& sciezka) { plikWznowienia = sciezka; }
+    void ustawZiarno(unsigned ziarno) { gen.seed(ziarno); }
+
+    // Restart po stagnacji: domyślnie path relinking w puli `rozmiarPuli` najlepszych końców epizodów,
+    // `par` par relinkowanych równolegle na restart; losowy restart, dopóki pula ma mniej niż 2 rozwiązania
+    void ustawDywersyfikacje(Dywersyfikacja d, int rozmiarPuli = 10, int par = 4, int watki = 0)
+    {
+        dywersyfikacja = d;
+        rozmiarPuliElitarnej = rozmiarPuli;
+        parRelinkingu = par;
+        watkiRelinkingu = watki;
+    }
 
     void zapiszStatystykiDoCSV(const std::string& nazwaPliku, int run) const;
 
     int getMakespan() const { return makespan; }
+    int getLiczbaRestartow() const { return liczbaRestartow; }
 const std::vector<OperationSchedule>& getSchedule() const { return schedule; }
 void zapiszBestVsCurrentCSV(const std::string& nazwaPliku) const;
 void zapiszKosztyNajlepszegoRunCSV(const std::string& nazwaPliku) const;
@@ -30,8 +66,29 @@ void zapiszKosztyNajlepszegoRunCSV(const std::string& nazwaPliku) const;
 
 
 private:
+    // Stan przeszukiwania – wszystko poza statystykami, co trzeba odtworzyć przy wznowieniu
+    struct Stan
+    {
+        std::vector<int> priorytety;
+        std::vector<int> najlepszyGenotyp;
+        int najlepszyMakespan;
+        std::vector<std::pair<int, int>> tabuLista;
+        int bezPoprawy;
+        int liczbaRestartow;
+        int iter;
+        std::vector<int> najlepszyEpizodu; // najlepsze rozwiązanie od ostatniego restartu
+        int kosztEpizodu;
+        ElitePool elita;
+    };
+
+    void zapiszCheckpoint(const Stan& stan, uint64_t sumaInstancji, CheckpointWriter& zapis) const;
+    bool wczytajCheckpoint(uint64_t sumaInstancji, Stan& stan);
+    // Relinking par z puli elitarnej; koszt nowego punktu startowego albo -1
+    int restartZElity(const Stan& stan, PathRelinkingPool& relinking, std::vector<int>& wynik);
+
     std::vector<OperationSchedule> schedule; // najlepszy znaleziony harmonogram
     int makespan;                            // jego czas trwania
+    int liczbaRestartow;                     // restarty z ostatniego solve (także te sprzed wznowienia)
     int liczbaIteracji;
     int dlugoscTabu;
     std::vector<int> kosztyIteracji;
@@ -39,16 +96,22 @@ private:
     std::vector<int> historiaBestSoFar;
     std::vector<double> avgIteracji;
 std::vector<int> worstIteracji;
-
-
-
-    std::vector<OperationSchedule> zbudujHarmonogramZPriorytetami(
-        const std::vector<int>& priorytety,
-        const std::vector<OperationSchedule>& operacje,
-        int liczbaJobow,
-        int liczbaMaszyn
-    );
-
+    TrybDekodera trybDekodera;
+    Kodowanie kodowanie;
+    int cel;
+    int dolneOgraniczenie;
+    EvaluationCache* cache;
+    std::vector<int> genotypStartowy;
+    const OgraniczeniaCzasowe* ograniczenia;
+    Dywersyfikacja dywersyfikacja;
+    int rozmiarPuliElitarnej;
+    int parRelinkingu;
+    int watkiRelinkingu;
+
+    std::mt19937 gen;
+    std::string plikCheckpointu;
+    int coIleCheckpoint;
+    std::string plikWznowienia;
 };
 
 #endif
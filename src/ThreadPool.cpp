@@ -0,0 +1,77 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+PulaWatkow::PulaWatkow(int liczbaWatkow)
+    : zadanie(nullptr), liczbaZadan(0), nastepne(0), partia(0), pracujace(0), koniec(false)
+{
+    if (liczbaWatkow <= 0)
+        liczbaWatkow = std::max(1u, std::thread::hardware_concurrency());
+    for (int w = 1; w < liczbaWatkow; ++w)
+        watki.emplace_back(&PulaWatkow::petla, this, w);
+}
+
+PulaWatkow::~PulaWatkow()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        koniec = true;
+    }
+    warunekStartu.notify_all();
+    for (std::thread& t : watki)
+        t.join();
+}
+
+void PulaWatkow::rownolegle(int liczbaZadan, const std::function<void(int, int)>& zadanie)
+{
+    if (liczbaZadan <= 0)
+        return;
+    if (watki.empty() || liczbaZadan == 1)
+    {
+        for (int i = 0; i < liczbaZadan; ++i)
+            zadanie(i, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->zadanie = &zadanie;
+        this->liczbaZadan = liczbaZadan;
+        nastepne.store(0);
+        pracujace = (int)watki.size();
+        ++partia;
+    }
+    warunekStartu.notify_all();
+
+    pracuj(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    warunekKonca.wait(lock, [this] { return pracujace == 0; });
+    this->zadanie = nullptr;
+}
+
+void PulaWatkow::pracuj(int watek)
+{
+    int i;
+    while ((i = nastepne.fetch_add(1)) < liczbaZadan)
+        (*zadanie)(i, watek);
+}
+
+void PulaWatkow::petla(int watek)
+{
+    unsigned widziana = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        warunekStartu.wait(lock, [&] { return partia != widziana || koniec; });
+        if (koniec)
+            return;
+        widziana = partia;
+
+        lock.unlock();
+        pracuj(watek);
+        lock.lock();
+
+        if (--pracujace == 0)
+            warunekKonca.notify_one();
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+// Stała pula wątków do pętli "dla każdego zadania" wywoływanej wielokrotnie (np. raz na pokolenie).
+// Wątek wołający pracuje jako wątek 0, więc pula z n wątkami uruchamia n - 1 dodatkowych.
+// Numer wątku przekazywany do zadania pozwala trzymać osobne bufory robocze na wątek.
+class PulaWatkow
+{
+public:
+    explicit PulaWatkow(int liczbaWatkow = 0); // 0 = std::thread::hardware_concurrency()
+    ~PulaWatkow();
+
+    PulaWatkow(const PulaWatkow&) = delete;
+    PulaWatkow& operator=(const PulaWatkow&) = delete;
+
+    int getLiczbaWatkow() const { return (int)watki.size() + 1; }
+
+    // Wywołuje zadanie(i, watek) dla i = 0..liczbaZadan-1 i wraca po wykonaniu wszystkich.
+    // Zadania są rozdzielane dynamicznie; watek < getLiczbaWatkow().
+    void rownolegle(int liczbaZadan, const std::function<void(int, int)>& zadanie);
+
+private:
+    void petla(int watek);
+    void pracuj(int watek);
+
+    std::vector<std::thread> watki;
+    std::mutex mutex;
+    std::condition_variable warunekStartu;
+    std::condition_variable warunekKonca;
+
+    const std::function<void(int, int)>* zadanie;
+    int liczbaZadan;
+    std::atomic<int> nastepne;
+    unsigned partia;  // numer bieżącego wywołania rownolegle()
+    int pracujace;    // dodatkowe wątki, które jeszcze nie skończyły partii
+    bool koniec;
+};
+
+#endif
@@ -1,20 +1,59 @@
 #include "JSSPInstance.h"
 #include "SimpleLoader.h"
 #include "RandomSolver.h"
+#include "GraspSolver.h"
 #include "TabuSearchSolver.h"
 #include "SimulatedAnnealingSolver.h"
 #include "EvolutionarySolver.h"
 #include <chrono>
 #include "EvolutionSolver.h"
+#include "LowerBounds.h"
+#include "EvaluationCache.h"
+#include "Checkpoint.h"
+#include "Metrics.h"
+#include "Log.h"
+#include "Rescheduler.h"
+#include "SolutionArchive.h"
+#include "GanttRenderer.h"
+#include "PopulationTrace.h"
+#include "ShiftingBottleneck.h"
+#include "DispatchingRules.h"
+#include "SolverServer.h"
+#include <map>
 #include <iostream>
+#include <fstream>
+#include <string>
 using namespace std;
 
-int main() 
+// Checkpoint runu w checkpoint_<solver>_<run>.bin; jeśli plik już jest (run przerwany) – run jest wznawiany
+template <typename Solver>
+static void przygotujCheckpoint(Solver& solver, bool wlaczone, const std::string& nazwaSolvera, int run, int coIle)
 {
+    if (!wlaczone)
+        return;
+
+    std::string plik = "checkpoint_" + nazwaSolvera + "_" + std::to_string(run) + ".bin";
+    solver.ustawCheckpoint(plik, coIle);
+    if (std::ifstream(plik).good())
+        solver.wznowZ(plik);
+}
+
+int main(int argc, char** argv)
+{
+    // === TRYB SERWERA ===
+    // "main --serwer": długo żyjący proces dla wielu krótkich przeplanowań – żądania JSON na stdin,
+    // zdarzenia na stdout (protokół w SolverServer.h); instancje i cache ocen zostają w pamięci
+    if (argc > 1 && std::string(argv[1]) == "--serwer")
+    {
+        Dziennik::instancja().konfigurujZeSrodowiska();
+        return SerwerSolverow("ta/optima.txt").uruchom(std::cin, std::cout);
+    }
+
    SimpleLoader loader;
 
    //loader.load("C:\\Users\\MICHA~1\\Desktop\\opt2\\jssp2\\Optymalizacja-JSSP\\ta\\ta01.txt");
-    loader.load("ta\\ta01.txt");
+    std::string sciezkaInstancji = "ta\\ta01.txt";
+    loader.load(sciezkaInstancji);
     //loader.wypisz(); 
     
 
@@ -25,6 +64,101 @@ int main()
     //loader.wypiszOperacje();
    
 
+    // === DOLNE OGRANICZENIE I CEL ===
+    // Bez znanego optimum zatrzymujemy się tylko na udowodnionym optimum (makespan == LB)
+    DolneOgraniczenia lb = obliczDolneOgraniczenia(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn);
+    int dolneOgraniczenie = lb.wartosc();
+    int cel = dolneOgraniczenie;
+
+    std::map<std::string, ZnaneOptimum> optima;
+    std::string nazwa = nazwaInstancji(sciezkaInstancji);
+    if (wczytajZnaneOptima(sciezkaSystemowa("ta\\optima.txt"), optima) && optima.count(nazwa))
+    {
+        dolneOgraniczenie = std::max(dolneOgraniczenie, optima[nazwa].lb);
+        cel = optima[nazwa].ub; // najlepsze znane rozwiązanie – dalsze liczenie to strata czasu
+    }
+    std::cout << "LB (job/maszyna/1-maszyna): " << lb.najdluzszyJob << "/" << lb.najbardziejObciazona << "/" << lb.jednaMaszyna
+              << ", LB: " << dolneOgraniczenie << ", cel: " << cel << "\n";
+
+    // === CHECKPOINTY ===
+    // Po przerwaniu (SIGINT/SIGTERM) ponowne uruchomienie kontynuuje runy z zapisanych plików
+    bool checkpointy = false;
+    int coIleCheckpoint = 100; // iteracji / pokoleń / prób
+    if (checkpointy)
+        zainstalujObslugeSygnalow();
+
+    // === LOGI ===
+    // Poziomy: slad, debug, info, ostrzezenie, blad, wylaczony – dla wszystkich albo per solver,
+    // np. "info,tabu=debug,ewolucja=slad"; zmienna środowiskowa JSSP_LOG ma pierwszeństwo.
+    // Pusty plik = konsola; logJSON zapisuje jeden obiekt JSON na wiersz
+    std::string poziomyLogu = "info";
+    std::string plikLogu = "";
+    bool logJSON = false;
+    Dziennik::instancja().konfiguruj(poziomyLogu);
+    Dziennik::instancja().konfigurujZeSrodowiska();
+    if (!plikLogu.empty())
+        Dziennik::instancja().ustawPlik(plikLogu, logJSON);
+
+    // === METRYKI ===
+    // Po każdym runie metryki_<solver>_<run>.json; próbki co N ms do metryki_probki.jsonl (0 = bez)
+    int probkowanieMetrykMs = 0;
+    if (probkowanieMetrykMs > 0)
+        METRYKI_PROBKUJ("metryki_probki.jsonl", probkowanieMetrykMs);
+
+    // === ROZWIĄZANIE STARTOWE I ARCHIWUM ===
+    // Solvery mogą startować z harmonogramu z pliku (np. "harmonogram_tabu.csv") albo z archiwum
+    // najlepszych rozwiązań; najlepszy harmonogram każdego solvera trafia do archiwum, jeśli jest lepszy.
+    // Bez nich startShiftingBottleneck daje start z heurystyki Shifting Bottleneck zamiast losowego
+    bool archiwum = false;
+    bool startShiftingBottleneck = false;
+    std::string plikStartowy = "";
+    SolutionArchive archiwumRozwiazan("archiwum");
+    std::vector<int> genotypStartowy;
+    if (!plikStartowy.empty())
+    {
+        std::vector<OperationSchedule> harmonogramStartowy;
+        if (wczytajHarmonogramCSV(plikStartowy, harmonogramStartowy))
+            genotypStartowy = genotypZKolejnosci(loader.operacje, kolejnoscZHarmonogramu(loader.operacje, harmonogramStartowy),
+                                                 Kodowanie::Priorytety);
+    }
+    else if (archiwum)
+    {
+        genotypStartowy = archiwumRozwiazan.genotypStartowy(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn,
+                                                            Kodowanie::Priorytety);
+    }
+    if (!genotypStartowy.empty())
+    {
+        std::cout << "Start z zapisanego rozwiazania\n";
+    }
+    else if (startShiftingBottleneck)
+    {
+        auto startSB = std::chrono::high_resolution_clock::now();
+        ShiftingBottleneck sb;
+        sb.solve(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn);
+        genotypStartowy = sb.getGenotyp(Kodowanie::Priorytety);
+        std::chrono::duration<double> czasSB = std::chrono::high_resolution_clock::now() - startSB;
+        std::cout << "[ShiftingBottleneck] Start: " << sb.getMakespan() << " (" << czasSB.count() << " sekund)\n";
+    }
+
+    // === WYKRESY GANTTA ===
+    // harmonogram_<solver>.svg obok CSV (z zaznaczoną ścieżką krytyczną); PNG opcjonalnie
+    bool wykresyGantta = true;
+    bool wykresyPNG = false;
+    auto zapiszWykresy = [&](const std::vector<OperationSchedule>& harmonogram, const std::string& nazwa) {
+        if (!wykresyGantta)
+            return;
+        zapiszWykresGanttaSVG(harmonogram, "harmonogram_" + nazwa + ".svg");
+        if (wykresyPNG)
+            zapiszWykresGanttaPNG(harmonogram, "harmonogram_" + nazwa + ".png");
+    };
+
+    // === ŚLAD POPULACJI (EvolutionSolver) ===
+    // ewolucyjny.trc co `coIleSlad` pokoleń, `najlepszychSlad` osobników (0 = wszystkie);
+    // rozwinSlad odtwarza z niego dawny ewolucyjny.csv po zakończeniu przebiegu
+    int coIleSlad = 1;
+    int najlepszychSlad = 0;
+    bool rozwinSlad = false;
+
     auto startwsio = std::chrono::high_resolution_clock::now();
     
     int liczbaUruchomien = 2;
@@ -34,13 +168,28 @@ int main()
     auto startRand = std::chrono::high_resolution_clock::now();
 
     int randIteracji = 1000;
+    int watkiRandom = 0; // 0 = wszystkie rdzenie, 1 = sekwencyjnie (jak dawniej)
+    bool odcinanieRandom = false; // szybciej, ale avg/worst w wyniki_random.csv tylko z nieodciętych prób
     int najlepszyRun = -1;
     int najlepszyKoszt = std::numeric_limits<int>::max();
 
     for (int run = 0; run < liczbaUruchomien; ++run)
     {
         RandomSolver solver(randIteracji);
+        solver.ustawWatki(watkiRandom);
+        solver.ustawOdcinanie(odcinanieRandom);
+        solver.ustawCel(cel);
+        solver.ustawDolneOgraniczenie(dolneOgraniczenie);
+        solver.ustawGenotypStartowy(genotypStartowy);
+        przygotujCheckpoint(solver, checkpointy, "random", run, coIleCheckpoint);
+        METRYKI_ROZPOCZNIJ_RUN("random", run);
         solver.solve(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn);
+        METRYKI_ZAKONCZ_RUN("metryki_random_" + std::to_string(run) + ".json");
+        if (czyZadanoZatrzymania())
+        {
+            std::cout << "Przerwano – stan zapisany w checkpointach\n";
+            return 0;
+        }
 
         // Zapisz statystyki z tego runa do pliku CSV
         solver.zapiszStatystykiDoCSV("wyniki_random.csv", run);
@@ -51,6 +200,9 @@ int main()
             najlepszyKoszt = solver.getMakespan();
             najlepszyRun = run;
             solver.zapiszDoCSV("harmonogram_random.csv"); // tylko najlepszy
+            zapiszWykresy(solver.getSchedule(), "random");
+            if (archiwum)
+                archiwumRozwiazan.zaproponuj(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn, solver.getSchedule(), "random");
         }
     }
     std::cout << "Najlepszy RANDOM run: #" << najlepszyRun << "\n";
@@ -59,6 +211,52 @@ int main()
     auto stopRand = std::chrono::high_resolution_clock::now();
    std::chrono::duration<double> elapsedRandom = stopRand - startRand;
    std::cout << "[RandomSolver] Czas wykonania: " << elapsedRandom.count() << " sekund\n";
+
+    // === GRASP ===
+    // Losowa zachłanna konstrukcja z RCL + LocalSearch; iteracje równolegle we wszystkich wątkach
+    auto startGrasp = std::chrono::high_resolution_clock::now();
+
+    int graspIteracji = 256;
+    int krokiGrasp = 100;
+    int najlepszyRunGrasp = -1;
+    int najlepszyKosztGrasp = std::numeric_limits<int>::max();
+
+    for (int run = 0; run < liczbaUruchomien; ++run)
+    {
+        GraspSolver solver(graspIteracji);
+        solver.ustawCel(cel);
+        solver.ustawDolneOgraniczenie(dolneOgraniczenie);
+        solver.ustawKonstrukcje(RegulaPriorytetowa::MWKR, krokiGrasp);
+        solver.ustawGenotypStartowy(genotypStartowy);
+        przygotujCheckpoint(solver, checkpointy, "grasp", run, coIleCheckpoint);
+        METRYKI_ROZPOCZNIJ_RUN("grasp", run);
+        solver.solve(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn);
+        METRYKI_ZAKONCZ_RUN("metryki_grasp_" + std::to_string(run) + ".json");
+        if (czyZadanoZatrzymania())
+        {
+            std::cout << "Przerwano – stan zapisany w checkpointach\n";
+            return 0;
+        }
+
+        solver.zapiszStatystykiDoCSV("wyniki_grasp.csv", run);
+        solver.wypiszStatystykiAlf();
+
+        if (solver.getMakespan() < najlepszyKosztGrasp)
+        {
+            najlepszyKosztGrasp = solver.getMakespan();
+            najlepszyRunGrasp = run;
+            solver.zapiszDoCSV("harmonogram_grasp.csv");
+            zapiszWykresy(solver.getSchedule(), "grasp");
+            if (archiwum)
+                archiwumRozwiazan.zaproponuj(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn, solver.getSchedule(), "grasp");
+        }
+    }
+    std::cout << "Najlepszy GRASP run: #" << najlepszyRunGrasp << "\n";
+    std::cout << "Koszt (makespan): " << najlepszyKosztGrasp << "\n";
+
+    auto stopGrasp = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsedGrasp = stopGrasp - startGrasp;
+    std::cout << "[GraspSolver] Czas wykonania: " << elapsedGrasp.count() << " sekund\n";
     
     // === TABU SEARCH ===
     auto startTS = std::chrono::high_resolution_clock::now();
@@ -67,12 +265,27 @@ int main()
     int dlugoscTabu = 100;
     int najlepszyRunTS = -1;
     int najlepszyKosztTS = std::numeric_limits<int>::max();
+    Dywersyfikacja dywersyfikacjaTS = Dywersyfikacja::PathRelinking; // albo LosowyRestart
     TabuSearchSolver najlepszyTabu(tabuIteracje, dlugoscTabu);
+    // Bez cache: sąsiedzi TS prawie się nie powtarzają (trafienia ~0,01%, z kluczem sekwencji ~11%),
+    // a wyszukiwanie i klucz sekwencji kosztują więcej niż szybkie jądro dekodera
 
     for (int run = 0; run < liczbaUruchomien; ++run)
     {
         TabuSearchSolver solver(tabuIteracje, dlugoscTabu);
+        solver.ustawCel(cel);
+        solver.ustawDolneOgraniczenie(dolneOgraniczenie);
+        solver.ustawDywersyfikacje(dywersyfikacjaTS);
+        solver.ustawGenotypStartowy(genotypStartowy);
+        przygotujCheckpoint(solver, checkpointy, "tabu", run, coIleCheckpoint);
+        METRYKI_ROZPOCZNIJ_RUN("tabu", run);
         solver.solve(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn);
+        METRYKI_ZAKONCZ_RUN("metryki_tabu_" + std::to_string(run) + ".json");
+        if (czyZadanoZatrzymania())
+        {
+            std::cout << "Przerwano – stan zapisany w checkpointach\n";
+            return 0;
+        }
 
         // Zapis statystyk z tego runa
         solver.zapiszStatystykiDoCSV("wyniki_tabu.csv", run);
@@ -88,6 +301,9 @@ int main()
 
     // Zapisz tylko najlepszy harmonogram
     najlepszyTabu.zapiszDoCSV("harmonogram_tabu.csv");
+    zapiszWykresy(najlepszyTabu.getSchedule(), "tabu");
+    if (archiwum)
+        archiwumRozwiazan.zaproponuj(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn, najlepszyTabu.getSchedule(), "tabu");
     najlepszyTabu.zapiszBestVsCurrentCSV("best_vs_current_tabu.csv");
     najlepszyTabu.zapiszKosztyNajlepszegoRunCSV("koszty_tabu.csv");
 
@@ -100,6 +316,37 @@ int main()
     std::chrono::duration<double> elapsedTS = stopTS - startTS;
     std::cout << "[TabuSearch] Czas wykonania: " << elapsedTS.count() << " sekund\n";
 
+    // === PRZEPLANOWANIE (przykład) ===
+    // W połowie najlepszego harmonogramu TS maszyna 0 staje na 100 jednostek, dochodzi pilny job
+    // (trasa joba 0) i job 1 zostaje anulowany; naprawa, a potem krótki TS startujący z naprawy
+    bool demoPrzeplanowania = false;
+    if (demoPrzeplanowania)
+    {
+        auto startNaprawy = std::chrono::high_resolution_clock::now();
+
+        ZdarzenieProdukcyjne zdarzenie;
+        zdarzenie.czas = najlepszyKosztTS / 2;
+        zdarzenie.przestoje.push_back({ 0, zdarzenie.czas, zdarzenie.czas + 100 });
+        std::vector<std::pair<int, int>> pilny;
+        for (const OperationSchedule& op : loader.operacje)
+            if (op.job_id == 0) pilny.push_back(std::make_pair(op.machine_id, op.processing_time));
+        zdarzenie.noweJoby.push_back(pilny);
+        zdarzenie.anulowaneJoby.push_back(1);
+
+        Rescheduler przeplanowanie(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn);
+        int naprawa = przeplanowanie.przeplanuj(najlepszyTabu.getSchedule(), zdarzenie);
+        std::chrono::duration<double> czasNaprawy = std::chrono::high_resolution_clock::now() - startNaprawy;
+        std::cout << "[Przeplanowanie] Naprawa: " << naprawa << " (" << czasNaprawy.count() * 1000 << " ms)\n";
+
+        TabuSearchSolver poprawa(tabuIteracje / 10, dlugoscTabu);
+        poprawa.ustawOgraniczenia(&przeplanowanie.getOgraniczenia());
+        poprawa.ustawGenotypStartowy(przeplanowanie.getGenotypNaprawy());
+        poprawa.solve(przeplanowanie.getOperacje(), przeplanowanie.getLiczbaJobow(), przeplanowanie.getLiczbaMaszyn());
+        int poTS = przeplanowanie.scal(poprawa.getSchedule());
+        std::chrono::duration<double> czasPoprawy = std::chrono::high_resolution_clock::now() - startNaprawy;
+        std::cout << "[Przeplanowanie] Po TS: " << poTS << " (" << czasPoprawy.count() * 1000 << " ms)\n";
+    }
+
     
 
     // === SIMULATED ANNEALING ===
@@ -109,17 +356,39 @@ double startTemp = 1000.0;
 double endTemp = 0.01;
 double coolingRate = 0.800;
 int maxIter = 10000;
+SasiedztwoSA sasiedztwoSA = SasiedztwoSA::Krytyczne; // albo Losowe (dowolna zamiana genów)
+// Tryb adaptacyjny: T0, chłodzenie i rodzaj ruchów dobierane same (startTemp/endTemp/coolingRate pomijane),
+// budżet to czasSA sekund na run albo – przy 0 – maxIter iteracji
+bool adaptacyjneSA = true;
+double czasSA = 0.0;
 
 int najlepszyRunSA = -1;
 int najlepszyKosztSA = std::numeric_limits<int>::max();
 SimulatedAnnealingSolver najlepszySA(startTemp, endTemp, coolingRate, maxIter);
+EvaluationCache cacheSA(16, true); // klucz sekwencji maszyn: różne genotypy tego samego harmonogramu trafiają
 
 for (int run = 0; run < liczbaUruchomien; ++run)
 {
     SimulatedAnnealingSolver solver(startTemp, endTemp, coolingRate, maxIter);
+    solver.ustawCel(cel);
+    solver.ustawDolneOgraniczenie(dolneOgraniczenie);
+    solver.ustawCache(&cacheSA);
+    solver.ustawSasiedztwo(sasiedztwoSA);
+    if (adaptacyjneSA)
+        solver.ustawAdaptacje(0.5, czasSA);
+    solver.ustawGenotypStartowy(genotypStartowy);
+    przygotujCheckpoint(solver, checkpointy, "sa", run, coIleCheckpoint);
+    METRYKI_ROZPOCZNIJ_RUN("sa", run);
     solver.solve(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn);
+    METRYKI_ZAKONCZ_RUN("metryki_sa_" + std::to_string(run) + ".json");
+    if (czyZadanoZatrzymania())
+    {
+        std::cout << "Przerwano – stan zapisany w checkpointach\n";
+        return 0;
+    }
 
     solver.zapiszStatystykiDoCSV("wyniki_sa.csv", run);
+    solver.wypiszAdaptacje();
 
     if (solver.getMakespan() < najlepszyKosztSA)
     {
@@ -131,12 +400,16 @@ for (int run = 0; run < liczbaUruchomien; ++run)
 
 // Zapisz tylko harmonogram najlepszego rozwiązania
 najlepszySA.zapiszDoCSV("harmonogram_sa.csv");
+zapiszWykresy(najlepszySA.getSchedule(), "sa");
+if (archiwum)
+    archiwumRozwiazan.zaproponuj(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn, najlepszySA.getSchedule(), "sa");
 najlepszySA.zapiszKosztyNajlepszegoRunCSV("koszty_sa.csv");
 najlepszySA.zapiszBestVsCurrentCSV("best_vs_current_sa.csv");
 
 
 std::cout << "Najlepszy SA run: #" << najlepszyRunSA << "\n";
 std::cout << "Koszt (makespan): " << najlepszyKosztSA << "\n";
+cacheSA.wypiszStatystyki("SimulatedAnnealing");
 
 auto stopSA = std::chrono::high_resolution_clock::now();
 std::chrono::duration<double> elapsedSA = stopSA - startSA;
@@ -145,20 +418,52 @@ std::cout << "[SimulatedAnnealing] Czas wykonania: " << elapsedSA.count() << " s
   //===EVOLUTIONERY ALGORYTHIM===
 /*
     EvolutionarySolver solverAE(100, 500, 0.8, 0.2); // populacja, pokolenia, prawd. krzyÅ¼., mutacji
+    // Stan ustalony: 2 potomków na krok zastępuje w miejscu najgorszego (albo podobnego rodzica) – z elitaryzmem
+    solverAE.ustawStanUstalony(2, Zastepowanie::Najgorszy);
     solverAE.solve(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn);
     solverAE.printSchedule();
+    zapiszWykresy(solverAE.getSchedule(), "ea");
+    if (archiwum)
+        archiwumRozwiazan.zaproponuj(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn, solverAE.getSchedule(), "ewolucja");
     solverAE.zapiszDoCSV("harmonogram_evolution.csv");
 */
 
    EvolutionSolver solverAE(10, 20, 0.01, 0.7, 3); // populacja, pokolenia, mutacja, krzyżowanie, turniej
+    solverAE.ustawCel(cel);
+    solverAE.ustawGenotypStartowy(genotypStartowy);
+    solverAE.ustawSladPopulacji("ewolucyjny.trc", coIleSlad, najlepszychSlad);
+    // Tryb memetyczny: Brak / Lamarck / Baldwin; część potomstwa poprawiana LocalSearch w puli wątków
+    UstawieniaMemetyczne memetyczne;
+    memetyczne.tryb = TrybMemetyczny::Brak;
+    memetyczne.czescPotomstwa = 0.5;
+    solverAE.ustawMemetyczny(memetyczne);
+    // Część populacji startowej z reguł priorytetowych (SPT, LPT, MWKR, MOPNR, FIFO i zaburzone)
+    double populacjaZRegul = 0.5;
+    solverAE.ustawPopulacjeZRegul(populacjaZRegul);
+    // Stan ustalony: 2 potomków na krok zastępuje w miejscu bliższego rodzica (albo najgorszego); 0 = pokolenia
+    solverAE.ustawStanUstalony(2, Zastepowanie::PodobnyRodzic);
+    if (populacjaZRegul > 0.0)
+        DispatchingRules(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn).wypiszRaport();
+    przygotujCheckpoint(solverAE, checkpointy, "ewolucja", 0, coIleCheckpoint);
+    METRYKI_ROZPOCZNIJ_RUN("ewolucja", 0);
     solverAE.solve(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn);
+    METRYKI_ZAKONCZ_RUN("metryki_ewolucja_0.json");
+    if (czyZadanoZatrzymania())
+    {
+        std::cout << "Przerwano – stan zapisany w checkpointach\n";
+        return 0;
+    }
     solverAE.printSchedule();
+    if (rozwinSlad)
+        rozwinSladPopulacji("ewolucyjny.trc", "ewolucyjny.csv");
    // solverAE.zapiszDoCSV("harmonogram_evolution.csv");
    
 
 auto stopwsio = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> elapsedwsio = stopwsio - startwsio;
     std::cout << "[Caly Algorytm] Czas wykonania: " << elapsedwsio.count() << " sekund\n";
+
+    METRYKI_ZATRZYMAJ_PROBKOWANIE();
   
     return 0;
 }
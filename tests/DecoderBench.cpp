@@ -0,0 +1,94 @@
+// Mikrobenchmark dekodera: jądra dekodujStaly<J, M> (wybierane dla typowych rozmiarów Taillarda)
+// kontra ogólny dekoder na tych samych losowych genotypach. Ogólną ścieżkę wymuszają puste
+// ograniczenia czasowe (ustawOgraniczenia), które nie zmieniają wyniku. Sprawdza też zgodność makespanów.
+// Budowa i uruchomienie (z katalogu z instancjami):
+//   g++ -std=c++17 -O2 -Isrc tests/DecoderBench.cpp $(ls src/*.cpp | grep -v main.cpp) -lpthread -o bench_dekodera
+//   ./bench_dekodera [instancja...]   (domyślnie ta/ta01.txt)
+
+#include "SimpleLoader.h"
+#include "ScheduleDecoder.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+static const int LICZBA_GENOTYPOW = 1000;
+static const int POWTORZEN = 20;
+
+// Średni czas jednego dekodowania w ns; suma makespanów trafia do `suma` (żeby pętla nie zniknęła)
+template <typename F>
+static double zmierz(const std::vector<std::vector<int>>& genotypy, F dekoduj, long long& suma)
+{
+    suma = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < POWTORZEN; ++r)
+        for (const std::vector<int>& g : genotypy)
+            suma += dekoduj(g);
+    std::chrono::duration<double, std::nano> czas = std::chrono::steady_clock::now() - start;
+    return czas.count() / (POWTORZEN * genotypy.size());
+}
+
+static bool porownaj(const SimpleLoader& loader, TrybDekodera tryb, Kodowanie kodowanie, const char* opis)
+{
+    ScheduleDecoder stale(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn, tryb, kodowanie);
+    ScheduleDecoder ogolny(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn, tryb, kodowanie);
+    OgraniczeniaCzasowe brak;
+    ogolny.ustawOgraniczenia(&brak);
+
+    std::mt19937 gen(12345);
+    std::vector<int> bazowy = genotypBazowy(loader.operacje, kodowanie);
+    std::vector<std::vector<int>> genotypy(LICZBA_GENOTYPOW, bazowy);
+    for (std::vector<int>& g : genotypy)
+        std::shuffle(g.begin(), g.end(), gen);
+
+    // Zgodność wyników, także z odcięciem na medianie
+    std::vector<int> makespany;
+    bool zgodne = true;
+    for (const std::vector<int>& g : genotypy)
+    {
+        int m = stale.dekoduj(g);
+        zgodne = zgodne && m == ogolny.dekoduj(g);
+        makespany.push_back(m);
+    }
+    std::nth_element(makespany.begin(), makespany.begin() + makespany.size() / 2, makespany.end());
+    const int prog = makespany[makespany.size() / 2];
+    for (const std::vector<int>& g : genotypy)
+        zgodne = zgodne && stale.dekodujDo(g, prog) == ogolny.dekodujDo(g, prog);
+
+    long long sumaStale, sumaOgolny, sumaStaleDo, sumaOgolnyDo;
+    double tStale = zmierz(genotypy, [&](const std::vector<int>& g) { return stale.dekoduj(g); }, sumaStale);
+    double tOgolny = zmierz(genotypy, [&](const std::vector<int>& g) { return ogolny.dekoduj(g); }, sumaOgolny);
+    double tStaleDo = zmierz(genotypy, [&](const std::vector<int>& g) { return stale.dekodujDo(g, prog); }, sumaStaleDo);
+    double tOgolnyDo = zmierz(genotypy, [&](const std::vector<int>& g) { return ogolny.dekodujDo(g, prog); }, sumaOgolnyDo);
+    zgodne = zgodne && sumaStale == sumaOgolny && sumaStaleDo == sumaOgolnyDo;
+
+    std::printf("  %-24s %-10s stale %7.0f ns  ogolny %7.0f ns  x%.2f | z progiem %7.0f / %7.0f ns  x%.2f  %s\n",
+                opis, stale.czyJadroStale() ? "jadro" : "bez jadra", tStale, tOgolny, tOgolny / tStale,
+                tStaleDo, tOgolnyDo, tOgolnyDo / tStaleDo, zgodne ? "zgodne" : "ROZNE WYNIKI");
+    return zgodne;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> instancje;
+    for (int i = 1; i < argc; ++i)
+        instancje.push_back(argv[i]);
+    if (instancje.empty())
+        instancje.push_back("ta/ta01.txt");
+
+    bool ok = true;
+    for (const std::string& sciezka : instancje)
+    {
+        SimpleLoader loader;
+        if (!loader.load(sciezka))
+            return 2;
+        std::cout << sciezka << " (" << loader.liczbaJobow << "x" << loader.liczbaMaszyn << ")\n";
+        ok = porownaj(loader, TrybDekodera::Polaktywny, Kodowanie::Priorytety, "polaktywny, priorytety") && ok;
+        ok = porownaj(loader, TrybDekodera::Polaktywny, Kodowanie::PowtorzeniaJobow, "polaktywny, powtorzenia") && ok;
+        ok = porownaj(loader, TrybDekodera::WstawianieWLuki, Kodowanie::Priorytety, "luki, priorytety") && ok;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+// Test odczytu harmonogramu: plik 5-kolumnowy (jak z RandomSolver/GRASP/AE) wczytany z powrotem
+// daje genotyp, którego zdekodowanie nie jest gorsze od zapisanego harmonogramu.
+// Budowa i uruchomienie (z katalogu z ta/ta01.txt):
+//   g++ -std=c++17 -O2 -Isrc tests/SolutionArchiveTest.cpp $(ls src/*.cpp | grep -v main.cpp) -lpthread -o test_archiwum
+//   ./test_archiwum [instancja]
+
+#include "SimpleLoader.h"
+#include "RandomSolver.h"
+#include "ScheduleDecoder.h"
+#include "SolutionArchive.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+static int bledy = 0;
+
+static void sprawdz(bool warunek, const std::string& opis)
+{
+    std::cout << (warunek ? "OK    " : "BLAD  ") << opis << "\n";
+    if (!warunek)
+        ++bledy;
+}
+
+int main(int argc, char** argv)
+{
+    std::string sciezka = argc > 1 ? argv[1] : "ta/ta01.txt";
+    SimpleLoader loader;
+    if (!loader.load(sciezka))
+        return 2;
+
+    const std::string plik = "test_harmonogram_5kolumn.csv";
+    RandomSolver rs(50);
+    rs.solve(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn);
+    rs.zapiszDoCSV(plik);
+
+    std::ifstream f(plik);
+    std::string naglowek;
+    std::getline(f, naglowek);
+    f.close();
+    sprawdz(naglowek == "job_id,operation_id,machine_id,start_time,end_time", "plik ma 5 kolumn");
+
+    std::vector<OperationSchedule> harmonogram;
+    sprawdz(wczytajHarmonogramCSV(plik, harmonogram), "wczytanie pliku 5-kolumnowego");
+    sprawdz(harmonogram.size() == loader.operacje.size(), "wszystkie operacje wczytane");
+
+    std::vector<int> kolejnosc = kolejnoscZHarmonogramu(loader.operacje, harmonogram);
+    sprawdz(!kolejnosc.empty(), "kolejnosc z czasow startu");
+
+    int zKolejnosci = makespanKolejnosci(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn, kolejnosc);
+    sprawdz(zKolejnosci > 0 && zKolejnosci <= rs.getMakespan(), "makespan kolejnosci <= zapisany");
+
+    for (Kodowanie k : {Kodowanie::Priorytety, Kodowanie::PowtorzeniaJobow})
+    {
+        ScheduleDecoder dekoder(loader.operacje, loader.liczbaJobow, loader.liczbaMaszyn, TrybDekodera::Polaktywny, k);
+        int m = dekoder.dekoduj(genotypZKolejnosci(loader.operacje, kolejnosc, k));
+        sprawdz(m == zKolejnosci, std::string("genotyp odtwarza kolejnosc (") +
+                                     (k == Kodowanie::Priorytety ? "priorytety" : "powtorzenia jobow") + ")");
+    }
+
+    std::remove(plik.c_str());
+    std::cout << (bledy == 0 ? "Wszystkie testy przeszly\n" : "Testy nieudane: " + std::to_string(bledy) + "\n");
+    return bledy == 0 ? 0 : 1;
+}